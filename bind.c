@@ -868,6 +868,7 @@ create_empty_gdata(int num_columns)
 		new_gdata[i].ttlbuf = NULL;
 		new_gdata[i].ttlbuflen = 0;
 		new_gdata[i].ttlbufused = 0;
+		new_gdata[i].rowset_convert = FALSE;
 	}
 
 	return new_gdata;
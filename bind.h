@@ -37,6 +37,8 @@ typedef struct
 	SQLLEN	ttlbufused;		/* used length of the buffer */
 	SQLLEN	data_left;		/* amount of data left to read
 					 * (SQLGetData) */
+	char	rowset_convert;		/* converted a rowset at a time
+					 * (SC_fetch_rowset_columns) */
 }	GetDataClass;
 
 /*
@@ -48,6 +48,47 @@ CI_Destructor(ColumnInfoClass *self)
 }
 
 
+/*
+ *	Read in the description of a field.
+ *	The name is read into namebuf.
+ */
+static void
+CI_read_field_info(SocketClass *sock, struct srvr_info *info, char *namebuf, size_t bufsize)
+{
+	CSTR		func = "CI_read_fields";
+	Int4		new_atttypmod;
+
+	SOCK_get_string(sock, namebuf, (int) bufsize);
+	info->name = namebuf;
+	info->relid = SOCK_get_int(sock, sizeof(Int4));
+	info->attid = (Int2) SOCK_get_int(sock, sizeof(Int2));
+	info->adtid = (OID) SOCK_get_int(sock, 4);
+	info->adtsize = (Int2) SOCK_get_int(sock, 2);
+
+	mylog("READING ATTTYPMOD\n");
+	new_atttypmod = (Int4) SOCK_get_int(sock, 4);
+
+	/* Subtract the header length */
+	switch (info->adtid)
+	{
+		case PG_TYPE_DATETIME:
+		case PG_TYPE_TIMESTAMP_NO_TMZONE:
+		case PG_TYPE_TIME:
+		case PG_TYPE_TIME_WITH_TMZONE:
+			break;
+		default:
+			new_atttypmod -= 4;
+	}
+	if (new_atttypmod < 0)
+		new_atttypmod = -1;
+	info->atttypmod = new_atttypmod;
+	info->display_size = 0;
+	/* format */
+	SOCK_get_int(sock, sizeof(Int2));
+
+	mylog("%s: fieldname='%s', adtid=%d, adtsize=%d, atttypmod=%d (rel,att)=(%d,%d)\n", func, info->name, info->adtid, info->adtsize, info->atttypmod, info->relid, info->attid);
+}
+
 /*
  *	Read in field descriptions.
  *	If self is not null, then also store the information.
@@ -56,12 +97,9 @@ CI_Destructor(ColumnInfoClass *self)
 char
 CI_read_fields(ColumnInfoClass *self, ConnectionClass *conn)
 {
-	CSTR		func = "CI_read_fields";
 	Int2		lf;
 	int			new_num_fields;
-	OID		new_adtid, new_relid = 0, new_attid = 0;
-	Int2		new_adtsize;
-	Int4		new_atttypmod = -1;
+	struct srvr_info	info;
 
 	/* COLUMN_NAME_STORAGE_LEN may be sufficient but for safety */
 	char		new_field_name[2 * COLUMN_NAME_STORAGE_LEN + 1];
@@ -85,38 +123,109 @@ CI_read_fields(ColumnInfoClass *self, ConnectionClass *conn)
 	/* now read in the descriptions */
 	for (lf = 0; lf < new_num_fields; lf++)
 	{
-		SOCK_get_string(sock, new_field_name, 2 * COLUMN_NAME_STORAGE_LEN);
-		new_relid = SOCK_get_int(sock, sizeof(Int4));
-		new_attid = SOCK_get_int(sock, sizeof(Int2));
-		new_adtid = (OID) SOCK_get_int(sock, 4);
-		new_adtsize = (Int2) SOCK_get_int(sock, 2);
+		CI_read_field_info(sock, &info, new_field_name, 2 * COLUMN_NAME_STORAGE_LEN);
+		if (self)
+			CI_set_field_info(self, lf, info.name, info.adtid, info.adtsize, info.atttypmod, info.relid, info.attid);
+	}
+
+	return (SOCK_get_errcode(sock) == 0);
+}
 
-		mylog("READING ATTTYPMOD\n");
-		new_atttypmod = (Int4) SOCK_get_int(sock, 4);
+/*
+ *	Make up a new column info for num_fields fields, the first
+ *	ncopy of which are described alike in self.
+ */
+static ColumnInfoClass *
+CI_new_fields(const ColumnInfoClass *self, int num_fields, int ncopy, BOOL *nomem)
+{
+	ColumnInfoClass	*newci;
+	const struct srvr_info	*prev;
+	int	i;
 
-		/* Subtract the header length */
-		switch (new_adtid)
+	if (newci = CI_Constructor(), NULL == newci)
+	{
+		*nomem = TRUE;
+		return NULL;
+	}
+	CI_set_num_fields(newci, num_fields);
+	if (num_fields > 0 && NULL == newci->coli_array)
+	{
+		CI_Destructor(newci);
+		*nomem = TRUE;
+		return NULL;
+	}
+	for (i = 0; i < ncopy; i++)
+	{
+		prev = self->coli_array + i;
+		CI_set_field_info(newci, i, prev->name, prev->adtid, prev->adtsize, prev->atttypmod, prev->relid, prev->attid);
+	}
+
+	return newci;
+}
+
+/*
+ *	Read in field descriptions for a column info which holds those
+ *	of a previous result and may be shared with other results.
+ *	If the server described the same fields again, self is kept
+ *	as it is and returned. Otherwise the fields are stored in a
+ *	new column info, which is returned.
+ *	NULL is returned on errors.
+ */
+ColumnInfoClass *
+CI_read_fields_again(ColumnInfoClass *self, ConnectionClass *conn)
+{
+	CSTR		func = "CI_read_fields_again";
+	Int2		lf;
+	int			new_num_fields;
+	struct srvr_info	info, *prev;
+	ColumnInfoClass	*newci = NULL;
+	BOOL		same, nomem = FALSE;
+	char		new_field_name[2 * COLUMN_NAME_STORAGE_LEN + 1];
+	SocketClass *sock;
+
+	sock = CC_get_socket(conn);
+	new_num_fields = (Int2) SOCK_get_int(sock, sizeof(Int2));
+
+	mylog("num_fields = %d (%d before)\n", new_num_fields, self->num_fields);
+
+	if (same = (new_num_fields == self->num_fields), !same)
+		newci = CI_new_fields(self, new_num_fields, 0, &nomem);
+	for (lf = 0; lf < new_num_fields; lf++)
+	{
+		CI_read_field_info(sock, &info, new_field_name, 2 * COLUMN_NAME_STORAGE_LEN);
+		if (same)
 		{
-			case PG_TYPE_DATETIME:
-			case PG_TYPE_TIMESTAMP_NO_TMZONE:
-			case PG_TYPE_TIME:
-			case PG_TYPE_TIME_WITH_TMZONE:
-				break;
-			default:
-				new_atttypmod -= 4;
+			prev = self->coli_array + lf;
+			if (prev->adtid == info.adtid &&
+			    prev->adtsize == info.adtsize &&
+			    prev->atttypmod == info.atttypmod &&
+			    prev->relid == info.relid &&
+			    prev->attid == info.attid &&
+			    strcmp(prev->name, info.name) == 0)
+				continue;
+			same = FALSE;
+			newci = CI_new_fields(self, new_num_fields, lf, &nomem);
 		}
-		if (new_atttypmod < 0)
-			new_atttypmod = -1;
-		/* format */
-		SOCK_get_int(sock, sizeof(Int2));
-
-		mylog("%s: fieldname='%s', adtid=%d, adtsize=%d, atttypmod=%d (rel,att)=(%d,%d)\n", func, new_field_name, new_adtid, new_adtsize, new_atttypmod, new_relid, new_attid);
+		if (NULL != newci)
+			CI_set_field_info(newci, lf, info.name, info.adtid, info.adtsize, info.atttypmod, info.relid, info.attid);
+	}
 
-		if (self)
-			CI_set_field_info(self, lf, new_field_name, new_adtid, new_adtsize, new_atttypmod, new_relid, new_attid);
+	if (SOCK_get_errcode(sock) != 0 || nomem)
+	{
+		if (NULL != newci)
+			CI_Destructor(newci);
+		return NULL;
+	}
+	if (same)
+	{
+		/* the display sizes are those of the new result */
+		for (lf = 0; lf < new_num_fields; lf++)
+			self->coli_array[lf].display_size = 0;
+		mylog("%s: the fields are described alike\n", func);
+		return self;
 	}
 
-	return (SOCK_get_errcode(sock) == 0);
+	return newci;
 }
 
 
@@ -41,6 +41,7 @@ ColumnInfoClass *CI_Constructor(void);
 void		CI_Destructor(ColumnInfoClass *self);
 void		CI_free_memory(ColumnInfoClass *self);
 char		CI_read_fields(ColumnInfoClass *self, ConnectionClass *conn);
+ColumnInfoClass	*CI_read_fields_again(ColumnInfoClass *self, ConnectionClass *conn);
 
 /* functions for setting up the fields from within the program, */
 /* without reading from a socket */
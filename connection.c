@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #ifdef	WIN32
 #ifdef	USE_SSPI
 #include "sspisvcs.h"
@@ -63,6 +64,7 @@
 static void CC_lookup_lo(ConnectionClass *self);
 static char *CC_create_errormsg(ConnectionClass *self);
 static int  CC_close_eof_cursors(ConnectionClass *self);
+static void CC_mark_cursors_doubtful(ConnectionClass *self);
 
 extern GLOBAL_VALUES globals;
 
@@ -299,6 +301,12 @@ CC_conninfo_init(ConnInfo *conninfo, UInt4 option)
 	conninfo->gssauth_use_gssapi = -1;
 	conninfo->keepalive_idle = -1;
 	conninfo->keepalive_interval = -1;
+	conninfo->spill_rows = -1;
+	conninfo->server_side_timeout = -1;
+	conninfo->catalog_cache_ttl = -1;
+	conninfo->stream_results = -1;
+	conninfo->load_balance_hosts = -1;
+	conninfo->host_recheck_secs = -1;
 #ifdef USE_LIBPQ
 	conninfo->prefer_libpq = -1;
 #endif /* USE_LIBPQ */
@@ -360,6 +368,13 @@ CC_copy_conninfo(ConnInfo *ci, const ConnInfo *sci)
 	CORR_VALCPY(extra_opts);
 	CORR_VALCPY(keepalive_idle);
 	CORR_VALCPY(keepalive_interval);
+	CORR_VALCPY(spill_rows);
+	CORR_VALCPY(server_side_timeout);
+	CORR_VALCPY(catalog_cache_ttl);
+	CORR_VALCPY(stream_results);
+	CORR_STRCPY(target_session_attrs);
+	CORR_VALCPY(load_balance_hosts);
+	CORR_VALCPY(host_recheck_secs);
 #ifdef	_HANDLE_ENLIST_IN_DTC_
 	CORR_VALCPY(xa_opt);
 #endif
@@ -432,6 +447,10 @@ CC_initialize(ConnectionClass *rv, BOOL lockinit)
 	rv->mb_maxbyte_per_char = 1;
 	rv->max_identifier_length = -1;
 	rv->escape_in_literal = ESCAPE_IN_LITERAL;
+	rv->in_hot_standby = -1;
+	rv->default_read_only = -1;
+	rv->server_timeout = SERVER_TIMEOUT_DEFAULT;
+	rv->catalog_modified = FALSE;
 
 	/* Initialize statement options to defaults */
 	/* Statements under this conn will inherit these options */
@@ -486,6 +505,8 @@ CC_Destructor(ConnectionClass *self)
 		self->descs = NULL;
 	}
 	mylog("after free statement holders\n");
+	SC_clear_pool(self);
+	QR_clear_pool(self);
 
 	NULL_THE_NAME(self->schemaIns);
 	NULL_THE_NAME(self->tableIns);
@@ -642,6 +663,107 @@ CC_abort(ConnectionClass *self)
 	return ret;
 }
 
+/*
+ *	CC_send_end_tran() and CC_receive_end_tran() are CC_commit()/CC_abort()
+ *	split in two, so that the transactions of many connections can be
+ *	ended with the round trips overlapping. The first one sends COMMIT or
+ *	ROLLBACK without waiting and returns 1, or returns 0 when there's no
+ *	transaction to end, or -1 on error. The caller must hold the
+ *	connection's critical section until the second one reads the reply.
+ */
+int
+CC_send_end_tran(ConnectionClass *self, BOOL commit)
+{
+	CSTR	func = "CC_send_end_tran";
+	const char	*cmd = commit ? cmtcmd : rbkcmd;
+	SocketClass	*sock;
+
+	CC_finish_streaming(self);
+	if (!CC_is_in_trans(self))
+		return 0;
+	if (commit && !CC_is_in_error_trans(self))
+	{
+		CC_close_eof_cursors(self);
+		if (!CC_is_in_trans(self))
+			return 0;
+	}
+	if (!(sock = self->sock))
+	{
+		CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send Query(connection dead)", func);
+		CC_on_abort(self, CONN_DEAD);
+		return -1;
+	}
+	/* Finish the pending extended query first */
+	if (!SyncParseRequest(self) && CC_get_errornumber(self) > 0)
+		return -1;
+
+	mylog("%s: conn=%p, query='%s'\n", func, self, cmd);
+	qlog("conn=%p, query='%s'\n", self, cmd);
+	SOCK_put_char(sock, 'Q');
+	SOCK_put_int(sock, (Int4) (strlen(cmd) + 1 + 4), 4);
+	SOCK_put_string(sock, cmd);
+	SOCK_flush_output(sock);
+	if (SOCK_get_errcode(sock) != 0)
+	{
+		CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send Query to backend", func);
+		CC_on_abort(self, CONN_DEAD);
+		return -1;
+	}
+
+	return 1;
+}
+
+char
+CC_receive_end_tran(ConnectionClass *self)
+{
+	CSTR	func = "CC_receive_end_tran";
+	SocketClass	*sock = self->sock;
+	char	msgbuffer[ERROR_MSG_LENGTH + 1];
+	char	ret = TRUE;
+	int	id;
+
+	for (;;)
+	{
+		id = SOCK_get_id(sock);
+		if ((SOCK_get_errcode(sock) != 0) || (id == EOF))
+			break;
+		SOCK_get_response_length(sock);
+		switch (id)
+		{
+			case 'C':
+				SOCK_get_string(sock, msgbuffer, sizeof(msgbuffer));
+				mylog("%s: ok - 'C' - %s\n", func, msgbuffer);
+				if (strnicmp(msgbuffer, rbkcmd, strlen(rbkcmd)) == 0)
+				{
+					CC_mark_cursors_doubtful(self);
+					CC_set_in_error_trans(self); /* mark the transaction error in case of manual rollback */
+				}
+				break;
+			case 'E':
+				handle_error_message(self, msgbuffer, sizeof(msgbuffer), self->sqlstate, func, NULL);
+				CC_set_errormsg(self, msgbuffer);
+				ret = FALSE;
+				break;
+			case 'N':
+				handle_notice_message(self, msgbuffer, sizeof(msgbuffer), NULL, func, NULL);
+				break;
+			case 'S':		/* parameter status */
+				getParameterValues(self);
+				break;
+			case 'Z':
+				EatReadyForQuery(self);
+				return ret;
+			default:
+				/* the rest of the message is skipped by SOCK_get_id() */
+				break;
+		}
+	}
+	CC_set_error(self, CONNECTION_NO_RESPONSE, "No response from the backend", func);
+	CC_on_abort(self, CONN_DEAD);
+
+	return FALSE;
+}
+
 /* This is called by SQLSetConnectOption etc also */
 char
 CC_set_autocommit(ConnectionClass *self, BOOL on)
@@ -715,6 +837,9 @@ CC_cleanup(ConnectionClass *self, BOOL keepCommunication)
 	/* even if we are in auto commit. */
 	if (self->sock)
 	{
+		/* skip the rest of a streamed result */
+		if (self->streaming_res)
+			QR_stream_tuples(self->streaming_res, -1, 0);
 		if (!keepCommunication)
 		{
 			CC_abort(self);
@@ -770,6 +895,8 @@ CC_cleanup(ConnectionClass *self, BOOL keepCommunication)
 		self->transact_status = CONN_IN_AUTOCOMMIT;
 	}
 	self->stmt_in_extquery = NULL;
+	self->num_queued_cmds = 0;
+	self->streaming_res = NULL;
 	if (!keepCommunication)
 	{
 		CC_conninfo_init(&(self->connInfo), CLEANUP_FOR_REUSE);
@@ -789,6 +916,7 @@ CC_cleanup(ConnectionClass *self, BOOL keepCommunication)
 			self->server_encoding = NULL;
 		}
 		reset_current_schema(self);
+		self->type_descs_built = 0;
 	}
 	/* Free cached table info */
 	CC_clear_col_info(self, TRUE);
@@ -920,6 +1048,7 @@ EatReadyForQuery(ConnectionClass *conn)
 			break;
 	}
 	conn->stmt_in_extquery = NULL;
+	conn->num_queued_cmds = 0;
 
 	return id;
 }
@@ -1093,6 +1222,16 @@ inolog("parameter name=%s\n", msgbuffer);
 			conn->escape_in_literal = ESCAPE_IN_LITERAL;
 		}
 	}
+	else if (stricmp(msgbuffer, "in_hot_standby") == 0)
+	{
+		SOCK_get_string(sock, msgbuffer, sizeof(msgbuffer));
+		conn->in_hot_standby = (stricmp(msgbuffer, "on") == 0);
+	}
+	else if (stricmp(msgbuffer, "default_transaction_read_only") == 0)
+	{
+		SOCK_get_string(sock, msgbuffer, sizeof(msgbuffer));
+		conn->default_read_only = (stricmp(msgbuffer, "on") == 0);
+	}
 	else if (stricmp(msgbuffer, "server_version") == 0)
 	{
 		char	szVersion[32];
@@ -1127,13 +1266,13 @@ static int	protocol3_opts_array(ConnectionClass *self, const char *opts[], const
 	int	cnt;
 
 	cnt = 0;
-	if (libpqopt && ci->server[0])
+	if (libpqopt && self->connect_host[0])
 	{
-		opts[cnt] = "host";		vals[cnt++] = ci->server;
+		opts[cnt] = "host";		vals[cnt++] = self->connect_host;
 	}
-	if (libpqopt && ci->port[0])
+	if (libpqopt && self->connect_port[0])
 	{
-		opts[cnt] = "port";		vals[cnt++] = ci->port;
+		opts[cnt] = "port";		vals[cnt++] = self->connect_port;
 	}
 	if (ci->database[0])
 	{
@@ -1499,7 +1638,7 @@ LIBPQ_CC_connect(ConnectionClass *self, char password_req, char *salt_para)
 /*
  *	Callee should free hte returned pointer.
  */
-static char *MakePrincHint(ConnInfo *ci, BOOL sspi)
+static char *MakePrincHint(ConnInfo *ci, const char *host, BOOL sspi)
 {
 	size_t len;
 	char	*svcprinc;
@@ -1513,13 +1652,13 @@ mylog("!!! %s settings=%s svcname=%p\n", __FUNCTION__, ci->conn_settings, svcnam
 		attrFound = TRUE;
 	else if (svcname = getenv("PGKRBSRVNAME"), NULL == svcname)
 		svcname = "postgres";
-	len = strlen(svcname) + 1 + strlen(ci->server) + 1;
+	len = strlen(svcname) + 1 + strlen(host) + 1;
 	if (NULL != (svcprinc = malloc(len)))
 	{
 		if (sspi)
-			snprintf(svcprinc, len, "%s/%s", svcname, ci->server);
+			snprintf(svcprinc, len, "%s/%s", svcname, host);
 		else
-			snprintf(svcprinc, len, "%s@%s", svcname, ci->server);
+			snprintf(svcprinc, len, "%s@%s", svcname, host);
 	}
 	if (attrFound)
 		free(svcname);
@@ -1636,7 +1775,7 @@ another_version_retry:
 
 		mylog("connecting to the server socket...\n");
 
-		SOCK_connect_to(sock, (short) atoi(ci->port), ci->server, self->login_timeout);
+		SOCK_connect_to(sock, (short) atoi(self->connect_port), self->connect_host, self->login_timeout);
 		if (SOCK_get_errcode(sock) != 0)
 		{
 			CC_set_error(self, CONNECTION_SERVER_NOT_REACHED, "Could not connect to the server", func);
@@ -1866,7 +2005,7 @@ inolog("Ekita retry=%d\n", retry);
 							if (!ci->gssauth_use_gssapi)
 							{
 								self->auth_svcs = KerberosService;
-								authRet = StartupSspiService(sock, self->auth_svcs, MakePrincHint(ci, TRUE), &bReconnect);
+								authRet = StartupSspiService(sock, self->auth_svcs, MakePrincHint(ci, self->connect_host, TRUE), &bReconnect);
 								if (!authRet)
 								{
 									CC_set_error(self, CONN_INVALID_AUTHENTICATION, "Service negotation failed", func);
@@ -1881,7 +2020,7 @@ inolog("Ekita retry=%d\n", retry);
 #endif /* USE_SSPI */
 							{
 								// pglock_thread();
-								authRet = pg_GSS_startup(self, MakePrincHint(ci, FALSE));
+								authRet = pg_GSS_startup(self, MakePrincHint(ci, self->connect_host, FALSE));
 								// pgunlock_thread();
 								if (authRet != 0)
 								{
@@ -1927,7 +2066,7 @@ inolog("Ekita retry=%d\n", retry);
 							mylog("in AUTH_REQ_SSPI\n");
 #if	defined(USE_SSPI)
 							self->auth_svcs = ci->gssauth_use_gssapi ? KerberosService : NegotiateService;
-							if (!StartupSspiService(sock, self->auth_svcs, MakePrincHint(ci, TRUE), &bReconnect))
+							if (!StartupSspiService(sock, self->auth_svcs, MakePrincHint(ci, self->connect_host, TRUE), &bReconnect))
 							{
 								CC_set_error(self, CONN_INVALID_AUTHENTICATION, "Service negotation failed", func);
 								goto error_proc;
@@ -2001,11 +2140,11 @@ error_proc:
 #undef	STRING_AFTER_DOT
 #define STRING_AFTER_DOT(string)   (strchr(#string, '.') + 1)
 
-char
-CC_connect(ConnectionClass *self, char password_req, char *salt_para)
+static char
+CC_connect_to_host(ConnectionClass *self, char password_req, char *salt_para)
 {
 	ConnInfo *ci = &(self->connInfo);
-	CSTR	func = "CC_connect";
+	CSTR	func = "CC_connect_to_host";
 	char		ret, *saverr = NULL, retsend;
 #ifdef USE_LIBPQ
 	BOOL	call_libpq = FALSE;
@@ -2111,12 +2250,17 @@ inolog("CC_send_settings\n");
 #endif /* UNICODE_SUPPORT */
 
 	ci->updatable_cursors = DISALLOW_UPDATABLE_CURSORS;
+	/*
+	 * With declare/fetch the keys of a keyset-driven cursor come from
+	 * the server's cursor one block at a time along with the rows.
+	 * SQLBulkOperations() isn't available then, because the rows it
+	 * adds to the cache and the keyset would be lost at the next block.
+	 */
 	if (ci->allow_keyset)
 	{
+		ci->updatable_cursors |= (ALLOW_STATIC_CURSORS | ALLOW_KEYSET_DRIVEN_CURSORS | SENSE_SELF_OPERATIONS);
 		if (ci->drivers.lie || !ci->drivers.use_declarefetch)
-			ci->updatable_cursors |= (ALLOW_STATIC_CURSORS | ALLOW_KEYSET_DRIVEN_CURSORS | ALLOW_BULK_OPERATIONS | SENSE_SELF_OPERATIONS);
-		else
-			ci->updatable_cursors |= (ALLOW_STATIC_CURSORS | SENSE_SELF_OPERATIONS);
+			ci->updatable_cursors |= ALLOW_BULK_OPERATIONS;
 	}
 
 	if (CC_get_errornumber(self) > 0)
@@ -2126,6 +2270,7 @@ inolog("CC_send_settings\n");
 	    && 0 < ci->bde_environment)
 		self->unicode |= CONN_DISALLOW_WCHAR;
 mylog("conn->unicode=%d\n", self->unicode);
+	pgtype_init_type_descs(self);
 	ret = 1;
 
 cleanup:
@@ -2142,6 +2287,338 @@ cleanup:
 	return ret;
 }
 
+/*
+ *	Servername may be a comma separated list of host[:port] (or
+ *	[IPv6 address]:port) entries. Port is used for the hosts which
+ *	don't specify their own.
+ */
+#define	MAX_HOST_CANDIDATES	16
+typedef struct
+{
+	char	host[MEDIUM_REGISTRY_LEN];
+	char	port[SMALL_REGISTRY_LEN];
+	int	sortkey;
+	BOOL	unreachable;
+} HostCandidate;
+
+static void
+copy_trimmed(char *dst, size_t dstsize, const char *src, size_t len)
+{
+	while (len > 0 && isspace((UCHAR) *src))
+	{
+		src++;
+		len--;
+	}
+	while (len > 0 && isspace((UCHAR) src[len - 1]))
+		len--;
+	if (len >= dstsize)
+		len = dstsize - 1;
+	memcpy(dst, src, len);
+	dst[len] = '\0';
+}
+
+static int
+parse_host_list(const ConnInfo *ci, HostCandidate *cands, int maxcands)
+{
+	const char	*p = ci->server, *next, *hend, *pstart;
+	int	count = 0;
+
+	while (count < maxcands)
+	{
+		memset(&cands[count], 0, sizeof(HostCandidate));
+		if (NULL == (next = strchr(p, ',')))
+			next = p + strlen(p);
+		while (p < next && isspace((UCHAR) *p))
+			p++;
+		pstart = NULL;
+		if ('[' == *p &&
+		    NULL != (hend = memchr(p, ']', next - p)))
+		{
+			p++;
+			if (hend + 1 < next && ':' == hend[1])
+				pstart = hend + 2;
+		}
+		else
+		{
+			const char *colon = memchr(p, ':', next - p);
+
+			hend = next;
+			/* a bare IPv6 address has more than one colon */
+			if (NULL != colon &&
+			    NULL == memchr(colon + 1, ':', next - colon - 1))
+			{
+				hend = colon;
+				pstart = colon + 1;
+			}
+		}
+		copy_trimmed(cands[count].host, sizeof(cands[count].host), p, hend - p);
+		if (NULL != pstart)
+			copy_trimmed(cands[count].port, sizeof(cands[count].port), pstart, next - pstart);
+		if ('\0' == cands[count].port[0])
+			strncpy_null(cands[count].port, ci->port, sizeof(cands[count].port));
+		/* skip empty entries unless the whole list is empty */
+		if (cands[count].host[0] || (0 == count && '\0' == *next))
+			count++;
+		if ('\0' == *next)
+			break;
+		p = next + 1;
+	}
+
+	return count;
+}
+
+static void
+make_host_key(char *key, size_t keysize, const char *host, const char *port)
+{
+	snprintf(key, keysize, "%s:%s", host, port);
+}
+
+/*
+ *	Order the hosts as LoadBalanceHosts says, and put the
+ *	hosts which failed recently last.
+ */
+static void
+order_host_candidates(ConnectionClass *self, HostCandidate *cands, int count)
+{
+	EnvironmentClass *env = (EnvironmentClass *) self->henv;
+	ConnInfo	*ci = &(self->connInfo);
+	char	key[MEDIUM_REGISTRY_LEN + SMALL_REGISTRY_LEN + 1];
+	HostCandidate	swap;
+	int	i, j;
+
+	if (count <= 1)
+		return;
+	if (ci->load_balance_hosts > LOAD_BALANCE_HOSTS_DISABLE)
+	{
+		/* a private generator, so as not to disturb the application's rand() */
+		UInt4	seed = (UInt4) time(NULL) ^ (UInt4) (size_t) self;
+
+		for (i = count - 1; i > 0; i--)
+		{
+			seed = seed * 1103515245 + 12345;
+			j = (int) ((seed >> 16) % (i + 1));
+			swap = cands[i];
+			cands[i] = cands[j];
+			cands[j] = swap;
+		}
+	}
+	for (i = 0; i < count; i++)
+	{
+		cands[i].sortkey = 0;
+		if (LOAD_BALANCE_HOSTS_LEAST_CONN == ci->load_balance_hosts)
+			cands[i].sortkey = EN_count_host_connections(env, cands[i].host, cands[i].port);
+		make_host_key(key, sizeof(key), cands[i].host, cands[i].port);
+		if (EN_is_host_failed(env, key))
+			cands[i].sortkey += INT_MAX / 2;
+	}
+	/* a stable insertion sort keeps the shuffled order among equals */
+	for (i = 1; i < count; i++)
+	{
+		swap = cands[i];
+		for (j = i; j > 0 && cands[j - 1].sortkey > swap.sortkey; j--)
+			cands[j] = cands[j - 1];
+		cands[j] = swap;
+	}
+}
+
+/*
+ *	Drop the connection to a host which is not to be used, so
+ *	that the next host of the list can be tried.
+ */
+static void
+CC_reset_for_next_host(ConnectionClass *self)
+{
+	if (self->sock)
+	{
+		/*
+		 * Leave the server the same way CC_cleanup() does: end the
+		 * transaction the session checks may have begun, then let
+		 * SOCK_Destructor() send Terminate ('X') and close the socket.
+		 */
+		CC_abort(self);
+		SOCK_Destructor(self->sock);
+		self->sock = NULL;
+	}
+	self->status = CONN_NOT_CONNECTED;
+	self->transact_status = CONN_IN_AUTOCOMMIT;
+	if (self->original_client_encoding)
+	{
+		free(self->original_client_encoding);
+		self->original_client_encoding = NULL;
+	}
+	if (self->current_client_encoding)
+	{
+		free(self->current_client_encoding);
+		self->current_client_encoding = NULL;
+	}
+	if (self->server_encoding)
+	{
+		free(self->server_encoding);
+		self->server_encoding = NULL;
+	}
+	reset_current_schema(self);
+	self->type_descs_built = 0;
+	CC_clear_col_info(self, TRUE);
+	CC_initialize_pg_version(self);
+	self->lobj_type = PG_TYPE_LO_UNDEFINED;
+	self->lo_is_domain = 0;
+	self->max_identifier_length = -1;
+	self->escape_in_literal = ESCAPE_IN_LITERAL;
+	self->in_hot_standby = -1;
+	self->default_read_only = -1;
+}
+
+static BOOL
+CC_is_read_only_session(ConnectionClass *self)
+{
+	QResultClass	*res;
+	BOOL	read_only = FALSE;
+
+	/* reported at startup by 14.0 or later servers */
+	if (self->in_hot_standby >= 0 && self->default_read_only >= 0)
+		return (self->in_hot_standby || self->default_read_only);
+	res = CC_send_query(self, "show transaction_read_only", NULL, IGNORE_ABORT_ON_CONN | ROLLBACK_ON_ERROR, NULL);
+	if (QR_command_maybe_successful(res) && QR_get_num_cached_tuples(res) > 0)
+	{
+		const char *val = QR_get_value_backend_text(res, 0, 0);
+
+		read_only = (NULL != val && stricmp(val, "on") == 0);
+	}
+	QR_Destructor(res);
+
+	return read_only;
+}
+
+static BOOL
+CC_is_standby_server(ConnectionClass *self)
+{
+	QResultClass	*res;
+	BOOL	standby = FALSE;
+
+	if (self->in_hot_standby >= 0)
+		return self->in_hot_standby;
+	if (PG_VERSION_LT(self, 9.0))
+		return FALSE;
+	res = CC_send_query(self, "select pg_catalog.pg_is_in_recovery()", NULL, IGNORE_ABORT_ON_CONN | ROLLBACK_ON_ERROR, NULL);
+	if (QR_command_maybe_successful(res) && QR_get_num_cached_tuples(res) > 0)
+	{
+		const char *val = QR_get_value_backend_text(res, 0, 0);
+
+		standby = (NULL != val && 't' == val[0]);
+	}
+	QR_Destructor(res);
+
+	return standby;
+}
+
+/*
+ *	Is the server just connected to of the type TargetSessionAttrs
+ *	requests ?
+ */
+static BOOL
+CC_session_attrs_match(ConnectionClass *self, const char *attrs)
+{
+	BOOL	match = TRUE;
+
+	if (stricmp(attrs, TARGET_SESSION_READ_WRITE) == 0)
+		match = !CC_is_read_only_session(self);
+	else if (stricmp(attrs, TARGET_SESSION_READ_ONLY) == 0)
+		match = CC_is_read_only_session(self);
+	else if (stricmp(attrs, TARGET_SESSION_PRIMARY) == 0)
+		match = !CC_is_standby_server(self);
+	else if (stricmp(attrs, TARGET_SESSION_STANDBY) == 0 ||
+		 stricmp(attrs, TARGET_SESSION_PREFER_STANDBY) == 0)
+		match = CC_is_standby_server(self);
+	mylog("CC_session_attrs_match: %s:%s %s %s\n", self->connect_host, self->connect_port, match ? "matches" : "doesn't match", attrs);
+
+	return match;
+}
+
+char
+CC_connect(ConnectionClass *self, char password_req, char *salt_para)
+{
+	ConnInfo *ci = &(self->connInfo);
+	CSTR	func = "CC_connect";
+	EnvironmentClass *env = (EnvironmentClass *) self->henv;
+	HostCandidate	cands[MAX_HOST_CANDIDATES];
+	char	key[MEDIUM_REGISTRY_LEN + SMALL_REGISTRY_LEN + 1];
+	char	skip_key[sizeof(key)];
+	const char	*attrs = ci->target_session_attrs;
+	char	ret;
+	int	count, i, pass, npass, recheck_secs, attempts = 0;
+	BOOL	mismatched = FALSE;
+
+	if ('\0' == attrs[0])
+		attrs = TARGET_SESSION_ANY;
+	if (stricmp(attrs, TARGET_SESSION_ANY) != 0 &&
+	    stricmp(attrs, TARGET_SESSION_READ_WRITE) != 0 &&
+	    stricmp(attrs, TARGET_SESSION_READ_ONLY) != 0 &&
+	    stricmp(attrs, TARGET_SESSION_PRIMARY) != 0 &&
+	    stricmp(attrs, TARGET_SESSION_STANDBY) != 0 &&
+	    stricmp(attrs, TARGET_SESSION_PREFER_STANDBY) != 0)
+	{
+		CC_set_error(self, CONN_INIREAD_ERROR, "Invalid TargetSessionAttrs value.", func);
+		return 0;
+	}
+	recheck_secs = ci->host_recheck_secs >= 0 ? ci->host_recheck_secs : DEFAULT_HOSTRECHECKSECONDS;
+
+	skip_key[0] = '\0';
+	if (AUTH_REQ_OK != password_req)
+	{
+		/* carry on with the host which asked for the password */
+		if (ret = CC_connect_to_host(self, password_req, salt_para), ret <= 0)
+			return ret;
+		if (CC_session_attrs_match(self, attrs))
+			return ret;
+		make_host_key(skip_key, sizeof(skip_key), self->connect_host, self->connect_port);
+		CC_reset_for_next_host(self);
+		mismatched = TRUE;
+		password_req = AUTH_REQ_OK;
+	}
+
+	count = parse_host_list(ci, cands, MAX_HOST_CANDIDATES);
+	order_host_candidates(self, cands, count);
+	npass = (stricmp(attrs, TARGET_SESSION_PREFER_STANDBY) == 0) ? 2 : 1;
+	for (pass = 0; pass < npass; pass++)
+	{
+		for (i = 0; i < count; i++)
+		{
+			if (cands[i].unreachable)
+				continue;
+			make_host_key(key, sizeof(key), cands[i].host, cands[i].port);
+			if (0 == pass && strcmp(key, skip_key) == 0)
+				continue;
+			strncpy_null(self->connect_host, cands[i].host, sizeof(self->connect_host));
+			strncpy_null(self->connect_port, cands[i].port, sizeof(self->connect_port));
+			mylog("%s: trying %s\n", func, key);
+			if (attempts++ > 0)
+				CC_clear_error(self);	/* forget the previous host */
+			ret = CC_connect_to_host(self, password_req, salt_para);
+			if (ret < 0)	/* the password is needed */
+				return ret;
+			if (0 == ret)
+			{
+				cands[i].unreachable = TRUE;
+				if (CONNECTION_SERVER_NOT_REACHED == CC_get_errornumber(self))
+					EN_set_host_failed(env, key, recheck_secs);
+				if (count > 1)
+					CC_reset_for_next_host(self);
+				continue;
+			}
+			EN_set_host_failed(env, key, 0);
+			/* prefer-standby accepts any server in the 2nd pass */
+			if (pass > 0 || CC_session_attrs_match(self, attrs))
+				return ret;
+			CC_reset_for_next_host(self);
+			mismatched = TRUE;
+		}
+	}
+	if (mismatched)
+		CC_set_error(self, CONNECTION_SERVER_NOT_REACHED, "Could not find a server of the type requested by TargetSessionAttrs.", func);
+
+	return 0;
+}
+
 
 char
 CC_add_statement(ConnectionClass *self, StatementClass *stmt)
@@ -2245,6 +2722,50 @@ mylog("max_identifier_length=%d\n", len);
 	return len < 0 ? 0 : len;
 }
 
+/*
+ *	Let the backend enforce the query timeout (ServerSideTimeout option).
+ *	statement_timeout is changed only when it differs from the value
+ *	the driver set last time.
+ */
+void
+CC_set_statement_timeout(ConnectionClass *self, SQLULEN timeout)
+{
+	QResultClass	*res;
+	Int4		msec;
+	char		cmd[64];
+
+	if (0 == timeout)
+	{
+		if (SERVER_TIMEOUT_DEFAULT == self->server_timeout)
+			return;
+		msec = SERVER_TIMEOUT_DEFAULT;
+		strcpy(cmd, "SET statement_timeout TO DEFAULT");
+	}
+	else
+	{
+		msec = (timeout < INT_MAX / 1000 ? (Int4) timeout * 1000 : INT_MAX);
+		if (msec == self->server_timeout)
+			return;
+		snprintf(cmd, sizeof(cmd), "SET statement_timeout = %d", msec);
+	}
+	res = CC_send_query(self, cmd, NULL, ROLLBACK_ON_ERROR | IGNORE_ABORT_ON_CONN, NULL);
+	self->server_timeout = (QR_command_maybe_successful(res) ? msec : SERVER_TIMEOUT_UNKNOWN);
+	QR_Destructor(res);
+}
+
+/*
+ *	Called after a DDL statement was executed. The cached catalog
+ *	results of the environment are cleared now, and again when the
+ *	transaction which executed the statement ends.
+ */
+void
+CC_on_catalog_change(ConnectionClass *self)
+{
+	EN_flush_catalog_cache(CC_get_env(self));
+	if (CC_is_in_trans(self))
+		self->catalog_modified = TRUE;
+}
+
 /*
  *	Create a more informative error message by concatenating the connection
  *	error message with its socket error message.
@@ -2450,6 +2971,11 @@ void	CC_on_commit(ConnectionClass *conn)
 		CC_set_no_trans(conn);
 		CC_set_no_manual_trans(conn);
 	}
+	if (conn->catalog_modified)
+	{
+		EN_flush_catalog_cache(CC_get_env(conn));
+		conn->catalog_modified = FALSE;
+	}
 	CC_clear_cursors(conn, FALSE);
 	CONNLOCK_RELEASE(conn);
 	CC_discard_marked_objects(conn);
@@ -2469,6 +2995,8 @@ void	CC_on_abort(ConnectionClass *conn, UDWORD opt)
 
 mylog("CC_on_abort in\n");
 	CONNLOCK_ACQUIRE(conn);
+	if (0 < conn->connInfo.server_side_timeout)
+		conn->server_timeout = SERVER_TIMEOUT_UNKNOWN;
 	if (0 != (opt & CONN_DEAD)) /* CONN_DEAD implies NO_TRANS also */
 		opt |= NO_TRANS;
 	if (CC_is_in_trans(conn))
@@ -2480,6 +3008,11 @@ mylog("CC_on_abort in\n");
 			set_no_trans = TRUE;
 		}
 	}
+	if (set_no_trans && conn->catalog_modified)
+	{
+		EN_flush_catalog_cache(CC_get_env(conn));
+		conn->catalog_modified = FALSE;
+	}
 	CC_clear_cursors(conn, TRUE);
 	if (0 != (opt & CONN_DEAD))
 	{
@@ -2513,6 +3046,8 @@ void	CC_on_abort_partial(ConnectionClass *conn)
 mylog("CC_on_abort_partial in\n");
 	ProcessRollback(conn, TRUE, TRUE);
 	CONNLOCK_ACQUIRE(conn);
+	if (0 < conn->connInfo.server_side_timeout)
+		conn->server_timeout = SERVER_TIMEOUT_UNKNOWN;
 	CC_discard_marked_objects(conn);
 	CONNLOCK_RELEASE(conn);
 }
@@ -2579,6 +3114,28 @@ CC_fetch_tuples(QResultClass *res, ConnectionClass *conn, const char *cursor, BO
 	return success;
 }
 
+/*
+ *	The tuples of a streamed result are read as they are fetched, so
+ *	the rest of its response may still be coming when another request
+ *	is to be sent. Read them all into the result first.
+ *
+ *	Another thread may be closing the result meanwhile, so look at it
+ *	only while holding the connection's critical section.
+ */
+void
+CC_finish_streaming(ConnectionClass *self)
+{
+	QResultClass	*res;
+
+	ENTER_CONN_CS(self);
+	if (NULL != (res = self->streaming_res))
+	{
+		mylog("%s: reading the rest of the result %p\n", __FUNCTION__, res);
+		QR_stream_tuples(res, -1, -1);
+	}
+	LEAVE_CONN_CS(self);
+}
+
 /*
  *	The "result_in" is only used by QR_next_tuple() to fetch another group of rows into
  *	the same existing QResultClass (this occurs when the tuple cache is depleted and
@@ -2597,6 +3154,8 @@ CC_send_query_append(ConnectionClass *self, const char *query, QueryInfo *qi, UD
 			   *res = NULL;
 	BOOL	ignore_abort_on_conn = ((flag & IGNORE_ABORT_ON_CONN) != 0),
 		create_keyset = ((flag & CREATE_KEYSET) != 0),
+		allow_spill = ((flag & ALLOW_SPILL_TUPLES) != 0),
+		stream_tuples = ((flag & STREAM_TUPLES) != 0),
 		issue_begin = ((flag & GO_INTO_TRANSACTION) != 0 && !CC_is_in_trans(self)),
 		rollback_on_error, query_rollback, end_with_commit;
 
@@ -2604,12 +3163,13 @@ CC_send_query_append(ConnectionClass *self, const char *query, QueryInfo *qi, UD
 	char		swallow, *ptr;
 	size_t	qrylen;
 	int			id;
-	SocketClass *sock = self->sock;
+	SocketClass *sock;
 	int			empty_reqs;
 	BOOL		ReadyToReturn = FALSE,
 				query_completed = FALSE,
 				aborted = FALSE,
 				used_passed_result_object = FALSE,
+				described = FALSE,
 			discard_next_begin = FALSE,
 			kill_conn = FALSE,
 			discard_next_savepoint = FALSE,
@@ -2636,7 +3196,8 @@ CC_send_query_append(ConnectionClass *self, const char *query, QueryInfo *qi, UD
 		qlog("conn=%p, query='%s'\n", self, query);
 	}
 
-	if (!self->sock)
+	CC_finish_streaming(self);
+	if (!(sock = self->sock))
 	{
 		CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send Query(connection dead)", func);
 		CC_on_abort(self, CONN_DEAD);
@@ -2701,6 +3262,9 @@ CC_send_query_append(ConnectionClass *self, const char *query, QueryInfo *qi, UD
 	if (rollback_on_error)
 		rollback_on_error = consider_rollback;
 	query_rollback = (rollback_on_error && !end_with_commit && PG_VERSION_GE(self, 8.0));
+	/* nothing but the tuples may follow a streamed result */
+	if (query_rollback || end_with_commit || appendq)
+		stream_tuples = FALSE;
 	if (!query_rollback && consider_rollback && !end_with_commit)
 	{
 		if (stmt)
@@ -2788,7 +3352,7 @@ inolog("leng=%d\n", leng);
 		used_passed_result_object = TRUE;
 	else
 	{
-		cmdres = QR_Constructor();
+		cmdres = QR_Constructor_from_pool(self);
 		if (!cmdres)
 		{
 			CC_set_error(self, CONNECTION_COULD_NOT_RECEIVE, "Could not create result info in send_query.", func);
@@ -2837,7 +3401,7 @@ inolog("send_query response_length=%d\n", response_length);
 
 					if (query_completed)	/* allow for "show" style notices */
 					{
-						res->next = QR_Constructor();
+						res->next = QR_Constructor_from_pool(self);
 						res = res->next;
 					}
 
@@ -2954,7 +3518,7 @@ inolog("Discarded the first SAVEPOINT\n");
 			case 'T':			/* Tuple results start here */
 				if (query_completed)
 				{
-					res->next = QR_Constructor();
+					res->next = QR_Constructor_from_pool(self);
 					if (!res->next)
 					{
 						CC_set_error(self, CONNECTION_COULD_NOT_RECEIVE, "Could not create result info in send_query.", func);
@@ -2985,6 +3549,22 @@ inolog("Discarded the first SAVEPOINT\n");
 						if (cursor && cursor[0])
 							QR_set_synchronize_keys(res);
 					}
+					else if (allow_spill && !(cursor && cursor[0]))
+					{
+						if (stream_tuples)
+							QR_set_stream_rows(res, self->connInfo.drivers.fetch_max);
+						else
+						{
+							QR_set_packed_tuples(res);
+							QR_set_spill_rows(res, self->connInfo.spill_rows);
+						}
+					}
+					/*
+					 * A re-execution of the statement is likely to be
+					 * described alike, so let it share the column info.
+					 */
+					if (NULL != stmt && !described && NULL != stmt->last_fields)
+						QR_set_fields(res, stmt->last_fields);
 					if (!CC_fetch_tuples(res, self, cursor, &ReadyToReturn, &kill_conn))
 					{
 						if (QR_command_maybe_successful(res))
@@ -2993,6 +3573,15 @@ inolog("Discarded the first SAVEPOINT\n");
 							retres = cmdres;
 						aborted = TRUE;
 					}
+					else if (QR_is_streamed(res))
+					{
+						/* the rest is read as the tuples are fetched */
+						ReadyToReturn = TRUE;
+						retres = cmdres;
+					}
+					if (NULL != stmt && !described)
+						SC_set_last_fields(stmt, QR_get_fields(res));
+					described = TRUE;
 					query_completed = TRUE;
 				}
 				else
@@ -3081,7 +3670,7 @@ mylog("!!! copydata len=%d\n", response_length);
 			case 'D':			/* Copy in command began successfully */
 				if (query_completed)
 				{
-					res->next = QR_Constructor();
+					res->next = QR_Constructor_from_pool(self);
 					res = res->next;
 				}
 				QR_set_rstatus(res, PORES_COPY_IN);
@@ -3091,7 +3680,7 @@ mylog("!!! copydata len=%d\n", response_length);
 			case 'B':			/* Copy out command began successfully */
 				if (query_completed)
 				{
-					res->next = QR_Constructor();
+					res->next = QR_Constructor_from_pool(self);
 					res = res->next;
 				}
 				QR_set_rstatus(res, PORES_COPY_OUT);
@@ -3221,23 +3810,45 @@ cleanup:
 int
 CC_send_function(ConnectionClass *self, int fnid, void *result_buf, int *actual_result_len, int result_is_int, LO_ARG *args, int nargs)
 {
-	CSTR	func = "CC_send_function";
+	FuncCallInfo	call;
+
+	call.fnid = fnid;
+	call.result_buf = result_buf;
+	call.actual_result_len = actual_result_len;
+	call.result_is_int = result_is_int;
+	call.args = args;
+	call.nargs = nargs;
+
+	return CC_send_functions(self, &call, 1);
+}
+
+/*
+ *	Send the function calls at once and then read their results, so that
+ *	they cost only one round trip. Returns FALSE if any of them failed.
+ */
+int
+CC_send_functions(ConnectionClass *self, FuncCallInfo *calls, int ncalls)
+{
+	CSTR	func = "CC_send_functions";
 	char		id,
 				done;
-	SocketClass *sock = self->sock;
+	SocketClass *sock;
 
 	/* ERROR_MSG_LENGTH is sufficient */
 	char msgbuffer[ERROR_MSG_LENGTH + 1];
-	int			i;
+	int			i, icall;
 	int			ret = TRUE;
 	UInt4			leng;
 	Int4			response_length;
 	int			func_cs_count = 0;
 	BOOL			resultResponse;
+	FuncCallInfo	*call;
+	LO_ARG		*args;
 
-	mylog("send_function(): conn=%p, fnid=%d, result_is_int=%d, nargs=%d\n", self, fnid, result_is_int, nargs);
+	mylog("send_function(): conn=%p, ncalls=%d, fnid=%d, result_is_int=%d, nargs=%d\n", self, ncalls, calls[0].fnid, calls[0].result_is_int, calls[0].nargs);
 
-	if (!self->sock)
+	CC_finish_streaming(self);
+	if (!(sock = self->sock))
 	{
 		CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send function(connection dead)", func);
 		CC_on_abort(self, CONN_DEAD);
@@ -3263,127 +3874,135 @@ CC_send_function(ConnectionClass *self, int fnid, void *result_buf, int *actual_
 #define	return DONT_CALL_RETURN_FROM_HERE???
 	ENTER_INNER_CONN_CS(self, func_cs_count);
 
-	leng = 4 + sizeof(uint32) + 2 + 2
-		+ sizeof(uint16);
-
-	for (i = 0; i < nargs; i++)
+	for (icall = 0, call = calls; icall < ncalls; icall++, call++)
 	{
-		leng += 4;
-		if (args[i].len >= 0)
+		args = call->args;
+		leng = 4 + sizeof(uint32) + 2 + 2
+			+ sizeof(uint16);
+
+		for (i = 0; i < call->nargs; i++)
 		{
-			if (args[i].isint)
-				leng += 4;
-			else
-				leng += args[i].len;
+			leng += 4;
+			if (args[i].len >= 0)
+			{
+				if (args[i].isint)
+					leng += 4;
+				else
+					leng += args[i].len;
+			}
+		}
+		leng += 2;
+		SOCK_put_char(sock, 'F');
+		SOCK_put_int(sock, leng, 4);
+		if (SOCK_get_errcode(sock) != 0)
+		{
+			CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send function to backend", func);
+			CC_on_abort(self, CONN_DEAD);
+			ret = FALSE;
+			goto cleanup;
 		}
-	}
-	leng += 2;
-	SOCK_put_char(sock, 'F');
-	SOCK_put_int(sock, leng, 4);
-	if (SOCK_get_errcode(sock) != 0)
-	{
-		CC_set_error(self, CONNECTION_COULD_NOT_SEND, "Could not send function to backend", func);
-		CC_on_abort(self, CONN_DEAD);
-		ret = FALSE;
-		goto cleanup;
-	}
 
-	SOCK_put_int(sock, fnid, 4);
-	SOCK_put_int(sock, 1, 2); /* # of formats */
-	SOCK_put_int(sock, 1, 2); /* the format is binary */
-	SOCK_put_int(sock, nargs, 2);
+		SOCK_put_int(sock, call->fnid, 4);
+		SOCK_put_int(sock, 1, 2); /* # of formats */
+		SOCK_put_int(sock, 1, 2); /* the format is binary */
+		SOCK_put_int(sock, call->nargs, 2);
 
-	mylog("send_function: done sending function\n");
+		mylog("send_function: done sending function\n");
 
-	for (i = 0; i < nargs; ++i)
-	{
-		mylog("  arg[%d]: len = %d, isint = %d, integer = %d, ptr = %p\n", i, args[i].len, args[i].isint, args[i].u.integer, args[i].u.ptr);
+		for (i = 0; i < call->nargs; ++i)
+		{
+			mylog("  arg[%d]: len = %d, isint = %d, integer = %d, ptr = %p\n", i, args[i].len, args[i].isint, args[i].u.integer, args[i].u.ptr);
 
-		SOCK_put_int(sock, args[i].len, 4);
-		if (args[i].isint)
-			SOCK_put_int(sock, args[i].u.integer, 4);
-		else
-			SOCK_put_n_char(sock, (char *) args[i].u.ptr, args[i].len);
+			SOCK_put_int(sock, args[i].len, 4);
+			if (args[i].isint)
+				SOCK_put_int(sock, args[i].u.integer, 4);
+			else
+				SOCK_put_n_char(sock, (char *) args[i].u.ptr, args[i].len);
 
-	}
+		}
 
-	SOCK_put_int(sock, 1, 2); /* result format is binary */
-	mylog("    done sending args\n");
+		SOCK_put_int(sock, 1, 2); /* result format is binary */
+		mylog("    done sending args\n");
+	}
 
 	SOCK_flush_output(sock);
 	mylog("  after flush output\n");
 
-	done = FALSE;
-	resultResponse = FALSE; /* for before V3 only */
-	while (!done)
+	/* Each call is answered with its own ReadyForQuery */
+	for (icall = 0, call = calls; icall < ncalls && self->sock == sock; icall++, call++)
 	{
-		id = SOCK_get_id(sock);
-		mylog("   got id = %c\n", id);
-		response_length = SOCK_get_response_length(sock);
+		done = FALSE;
+		resultResponse = FALSE; /* for before V3 only */
+		while (!done)
+		{
+			id = SOCK_get_id(sock);
+			mylog("   got id = %c\n", id);
+			response_length = SOCK_get_response_length(sock);
 inolog("send_func response_length=%d\n", response_length);
 
-		switch (id)
-		{
-			case 'G':
-				if (!resultResponse)
-				{
-					done = TRUE;
-					ret = FALSE;
-					break;
-				} /* fall through */
-			case 'V':
-				*actual_result_len = SOCK_get_int(sock, 4);
-				if (-1 != *actual_result_len)
-				{
-					if (result_is_int)
-						*((int *) result_buf) = SOCK_get_int(sock, 4);
-					else
-						SOCK_get_n_char(sock, (char *) result_buf, *actual_result_len);
+			switch (id)
+			{
+				case 'G':
+					if (!resultResponse)
+					{
+						done = TRUE;
+						ret = FALSE;
+						break;
+					} /* fall through */
+				case 'V':
+					*call->actual_result_len = SOCK_get_int(sock, 4);
+					if (-1 != *call->actual_result_len)
+					{
+						if (call->result_is_int)
+							*((int *) call->result_buf) = SOCK_get_int(sock, 4);
+						else
+							SOCK_get_n_char(sock, (char *) call->result_buf, *call->actual_result_len);
 
-					mylog("  after get result\n");
-				}
-				break;			/* ok */
+						mylog("  after get result\n");
+					}
+					break;			/* ok */
 
-			case 'N':
-				handle_notice_message(self, msgbuffer, sizeof(msgbuffer), NULL, "send_function", NULL);
-				/* continue reading */
-				break;
+				case 'N':
+					handle_notice_message(self, msgbuffer, sizeof(msgbuffer), NULL, "send_function", NULL);
+					/* continue reading */
+					break;
 
-			case 'E':
-				handle_error_message(self, msgbuffer, sizeof(msgbuffer), NULL, "send_function", NULL);
-				CC_set_errormsg(self, msgbuffer);
+				case 'E':
+					handle_error_message(self, msgbuffer, sizeof(msgbuffer), NULL, "send_function", NULL);
+					CC_set_errormsg(self, msgbuffer);
 #ifdef	_LEGACY_MODE_
-				CC_on_abort(self, 0);
+					CC_on_abort(self, 0);
 #endif /* _LEGACY_MODE_ */
 
-				mylog("send_function(V): 'E' - %s\n", CC_get_errormsg(self));
-				qlog("ERROR from backend during send_function: '%s'\n", CC_get_errormsg(self));
-				ret = FALSE;
-				break;
-
-			case 'Z':
-				EatReadyForQuery(self);
-				done = TRUE;
-				break;
-
-			case '0':	/* empty result */
-				if (resultResponse)
-				{
-					resultResponse = FALSE;
+					mylog("send_function(V): 'E' - %s\n", CC_get_errormsg(self));
+					qlog("ERROR from backend during send_function: '%s'\n", CC_get_errormsg(self));
+					ret = FALSE;
 					break;
-				} /* fall through */
 
-			default:
-				/* skip the unexpected response if possible */
-				if (response_length >= 0)
+				case 'Z':
+					EatReadyForQuery(self);
+					done = TRUE;
 					break;
-				CC_set_error(self, CONNECTION_BACKEND_CRAZY, "Unexpected protocol character from backend (send_function, args)", func);
-				CC_on_abort(self, CONN_DEAD);
 
-				mylog("send_function: error - %s\n", CC_get_errormsg(self));
-				done = TRUE;
-				ret = FALSE;
-				break;
+				case '0':	/* empty result */
+					if (resultResponse)
+					{
+						resultResponse = FALSE;
+						break;
+					} /* fall through */
+
+				default:
+					/* skip the unexpected response if possible */
+					if (response_length >= 0)
+						break;
+					CC_set_error(self, CONNECTION_BACKEND_CRAZY, "Unexpected protocol character from backend (send_function, args)", func);
+					CC_on_abort(self, CONN_DEAD);
+
+					mylog("send_function: error - %s\n", CC_get_errormsg(self));
+					done = TRUE;
+					ret = FALSE;
+					break;
+			}
 		}
 	}
 
@@ -3767,7 +4386,7 @@ LIBPQ_connect(ConnectionClass *self)
 	int		pversion;
 	const char *param_val;
 
-	mylog("connecting to the database  using %s as the server\n",self->connInfo.server);
+	mylog("connecting to the database  using %s as the server\n",self->connect_host);
 	sock = self->sock;
 inolog("sock=%p\n", sock);
 	if (!sock)
@@ -3876,6 +4495,12 @@ inolog("ssl=%p\n", sock->ssl);
 	{
 		self->current_client_encoding = strdup(param_val);
 	}
+	param_val = PQparameterStatus(pqconn, "in_hot_standby");
+	if (param_val != NULL)
+		self->in_hot_standby = (stricmp(param_val, "on") == 0);
+	param_val = PQparameterStatus(pqconn, "default_transaction_read_only");
+	if (param_val != NULL)
+		self->default_read_only = (stricmp(param_val, "on") == 0);
 
 	/* blocking mode */
 	/* ioctlsocket(sock, FIONBIO , 0);
@@ -4034,7 +4659,7 @@ DLL_DECLARE void PgDtc_create_connect_string(void *self, char *connstr, int strs
 		,
 
 		drivername, xaOptStr
-		, ci->server, ci->port, ci->database, ci->username, SAFE_NAME(ci->password), ci->sslmode
+		, conn->connect_host, conn->connect_port, ci->database, ci->username, SAFE_NAME(ci->password), ci->sslmode
 #ifdef	USE_LIBPQ
 		, (CC_get_socket(conn))->via_libpq
 #endif /* USE_LIBPQ */
@@ -4372,6 +4997,7 @@ PgDtc_isolate(void *self, DWORD option)
 	if (0 == (useAnotherRoom & option))
 	{
 		HENV	henv = sconn->henv;
+		ConnectionClass	*env_prev = sconn->env_prev, *env_next = sconn->env_next;
 
 		CC_cleanup(sconn, TRUE);
 		if (newconn = CC_Copy(sconn), NULL == newconn)
@@ -4382,7 +5008,10 @@ PgDtc_isolate(void *self, DWORD option)
 			CC_copy_conninfo(&sconn->connInfo, &newconn->connInfo);
 		CC_initialize_pg_version(sconn);
 		sconn->henv = henv;
+		sconn->env_prev = env_prev;
+		sconn->env_next = env_next;
 		newconn->henv = NULL;
+		newconn->env_prev = newconn->env_next = NULL;
 		SYNC_AUTOCOMMIT(sconn);
 		return newconn;
 	}
@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "descriptor.h"
+#include "pgtypes.h"
 
 #if defined (POSIX_MULTITHREAD_SUPPORT)
 #include <pthread.h>
@@ -289,6 +290,13 @@ typedef struct
 	UInt4		extra_opts;
 	Int4		keepalive_idle;
 	Int4		keepalive_interval;
+	Int4		spill_rows;
+	Int4		server_side_timeout;
+	Int4		catalog_cache_ttl;
+	Int4		stream_results;
+	char		target_session_attrs[16];
+	Int4		load_balance_hosts;
+	Int4		host_recheck_secs;
 #ifdef	_HANDLE_ENLIST_IN_DTC_
 	signed char	xa_opt;
 #endif /* _HANDLE_ENLIST_IN_DTC_ */
@@ -375,6 +383,8 @@ struct ConnectionClass_
 {
 	HENV		henv;		/* environment this connection was
 					 * created on */
+	ConnectionClass	*env_prev;	/* in the list of the connections */
+	ConnectionClass	*env_next;	/* of the environment */
 	SQLUINTEGER	login_timeout;
 	StatementOptions stmtOptions;
 	ARDFields	ardOptions;
@@ -388,6 +398,10 @@ struct ConnectionClass_
 	Int2		num_stmts;
 	Int2		ncursors;
 	SocketClass	*sock;
+	char		connect_host[MEDIUM_REGISTRY_LEN];	/* the host of Servername */
+	char		connect_port[SMALL_REGISTRY_LEN];	/* being connected to */
+	signed char	in_hot_standby;		/* as reported by the server, */
+	signed char	default_read_only;	/* or -1 if not reported */
 	Int4		lobj_type;
 	Int2		coli_allocated;
 	Int2		ntables;
@@ -421,6 +435,8 @@ struct ConnectionClass_
 	UInt4		isolation;
 	char		*current_schema;
 	StatementClass	*stmt_in_extquery;
+	Int2		num_queued_cmds;	/* queued ahead of stmt_in_extquery's requests */
+	QResultClass	*streaming_res;	/* the result whose tuples are still coming */
 	Int2		max_identifier_length;
 	Int2		num_discardp;
 	char		**discardp;
@@ -428,6 +444,15 @@ struct ConnectionClass_
 	DescriptorClass	**descs;
 	pgNAME		schemaIns;
 	pgNAME		tableIns;
+	Int4		server_timeout;	/* statement_timeout (msec) set by ServerSideTimeout */
+	char		catalog_modified;	/* DDL was executed in the current transaction */
+	char		type_descs_built;
+	char		type_descs_odbc3;	/* the ODBC version type_descs was built for */
+	PGTypeDesc	type_descs[PG_TYPE_DESC_SLOTS];
+	StatementClass	*stmt_pool;	/* dropped statements kept for reuse */
+	Int2		num_pooled_stmts;
+	QResultClass	*result_pool;	/* destroyed results kept for reuse */
+	Int2		num_pooled_results;
 #ifdef	USE_SSPI
 	UInt4		svcs_allowed;
 	UInt4		auth_svcs;
@@ -486,6 +511,17 @@ enum {
 #endif /* _HANDLE_ENLIST_IN_DTC_ */
 
 
+/*	A function call for CC_send_functions */
+typedef struct
+{
+	int		fnid;
+	void		*result_buf;
+	int		*actual_result_len;
+	int		result_is_int;
+	LO_ARG		*args;
+	int		nargs;
+} FuncCallInfo;
+
 /*	prototypes */
 ConnectionClass *CC_Constructor(void);
 enum { /* CC_conninfo_init option */
@@ -500,6 +536,9 @@ char		CC_cleanup(ConnectionClass *self, BOOL keepCommunication);
 char		CC_begin(ConnectionClass *self);
 char		CC_commit(ConnectionClass *self);
 char		CC_abort(ConnectionClass *self);
+int		CC_send_end_tran(ConnectionClass *self, BOOL commit);
+char		CC_receive_end_tran(ConnectionClass *self);
+void		CC_finish_streaming(ConnectionClass *self);
 char		CC_set_autocommit(ConnectionClass *self, BOOL on);
 int		CC_set_translation(ConnectionClass *self);
 char		CC_connect(ConnectionClass *self, char password_req, char *salt);
@@ -515,6 +554,7 @@ QResultClass *CC_send_query_append(ConnectionClass *self, const char *query, Que
 #define CC_send_query(self, query, qi, flag, stmt) CC_send_query_append(self, query, qi, flag, stmt, NULL)
 void		CC_clear_error(ConnectionClass *self);
 int		CC_send_function(ConnectionClass *conn, int fnid, void *result_buf, int *actual_result_len, int result_is_int, LO_ARG *argv, int nargs);
+int		CC_send_functions(ConnectionClass *conn, FuncCallInfo *calls, int ncalls);
 char		CC_send_settings(ConnectionClass *self);
 /*
 char		*CC_create_errormsg(ConnectionClass *self);
@@ -539,6 +579,8 @@ int	handle_notice_message(ConnectionClass *self, char *msgbuf, size_t buflen,
 int		EatReadyForQuery(ConnectionClass *self);
 void		getParameterValues(ConnectionClass *self);
 int		CC_get_max_idlen(ConnectionClass *self);
+void		CC_set_statement_timeout(ConnectionClass *self, SQLULEN timeout);
+void		CC_on_catalog_change(ConnectionClass *self);
 
 BOOL		SendSyncRequest(ConnectionClass *self);
 
@@ -555,7 +597,12 @@ enum {
 	,ROLLBACK_ON_ERROR	= (1L << 3) /* rollback the query when an error occurs */
 	,END_WITH_COMMIT	= (1L << 4) /* the query ends with COMMMIT command */
 	,IGNORE_ROUND_TRIP	= (1L << 5) /* the commincation round trip time is considered ignorable */
+	,ALLOW_SPILL_TUPLES	= (1L << 6) /* the tuples may be packed and spilled to a temporary file */
+	,STREAM_TUPLES		= (1L << 7) /* the tuples may be read as they are fetched */
 };
+/* server_timeout other than msec */
+#define	SERVER_TIMEOUT_DEFAULT	(-1)	/* not set by the driver */
+#define	SERVER_TIMEOUT_UNKNOWN	(-2)	/* may have been rolled back */
 /* CC_on_abort options */
 #define	NO_TRANS		1L
 #define	CONN_DEAD		(1L << 1) /* connection is no longer valid */
@@ -218,6 +218,115 @@ static unsigned ODBCINT64 ATOI64U(const char *val)
 static void ResolveNumericParam(const SQL_NUMERIC_STRUCT *ns, char *chrform);
 static void parse_to_numeric_struct(const char *wv, SQL_NUMERIC_STRUCT *ns, BOOL *overflow);
 
+/*
+ *	Decoders/encoders for the ISO DateStyle which the server uses by
+ *	default. They handle only the exact forms, anything else is left
+ *	to the sscanf()/snprintf() code.
+ */
+static int
+decode_digits(const char *str, int n)
+{
+	int	val = 0;
+
+	for (; n > 0; n--, str++)
+	{
+		if (*str < '0' || *str > '9')
+			return -1;
+		val = val * 10 + (*str - '0');
+	}
+	return val;
+}
+
+static char *
+encode_digits(char *str, int val, int n)
+{
+	int	i;
+
+	for (i = n - 1; i >= 0; i--, val /= 10)
+		str[i] = '0' + val % 10;
+	return str + n;
+}
+
+/* YYYY-MM-DD */
+static BOOL
+decode_iso_date(const char *str, SIMPLE_TIME *st)
+{
+	int	y, m, d;
+
+	if ((y = decode_digits(str, 4)) < 0 || '-' != str[4] ||
+	    (m = decode_digits(str + 5, 2)) < 0 || '-' != str[7] ||
+	    (d = decode_digits(str + 8, 2)) < 0)
+		return FALSE;
+	st->y = y;
+	st->m = m;
+	st->d = d;
+	return TRUE;
+}
+
+/* HH:MM:SS */
+static BOOL
+decode_iso_time(const char *str, SIMPLE_TIME *st)
+{
+	int	hh, mm, ss;
+
+	if ((hh = decode_digits(str, 2)) < 0 || ':' != str[2] ||
+	    (mm = decode_digits(str + 3, 2)) < 0 || ':' != str[5] ||
+	    (ss = decode_digits(str + 6, 2)) < 0)
+		return FALSE;
+	st->hh = hh;
+	st->mm = mm;
+	st->ss = ss;
+	return TRUE;
+}
+
+/*
+ *	YYYY-MM-DD HH:MM:SS[.fraction][{+|-}HH[:MM[:SS]]][ BC]
+ *	Only the hours of the time zone are used, like timestamp2stime().
+ */
+static BOOL
+decode_iso_timestamp(const char *str, SIMPLE_TIME *st, BOOL *bZone, int *zone)
+{
+	const char	*ptr;
+	int		i, fr = 0, zh = 0;
+	BOOL		withZone = FALSE;
+
+	if (!decode_iso_date(str, st) || ' ' != str[10] ||
+	    !decode_iso_time(str + 11, st))
+		return FALSE;
+	ptr = str + 19;
+	if ('.' == *ptr)
+	{
+		for (ptr++, i = 0; *ptr >= '0' && *ptr <= '9'; ptr++, i++)
+		{
+			if (i >= 9)
+				return FALSE;
+			fr = fr * 10 + (*ptr - '0');
+		}
+		if (0 == i)
+			return FALSE;
+		for (; i < 9; i++)
+			fr *= 10;
+	}
+	if ('+' == *ptr || '-' == *ptr)
+	{
+		if ((zh = decode_digits(ptr + 1, 2)) < 0)
+			return FALSE;
+		if ('-' == *ptr)
+			zh = -zh;
+		withZone = TRUE;
+		for (ptr += 3; ':' == *ptr && decode_digits(ptr + 1, 2) >= 0; ptr += 3)
+			;
+	}
+	if (0 == strcmp(ptr, " BC"))
+		st->y = -st->y;
+	else if ('\0' != *ptr)
+		return FALSE;
+	st->fr = fr;
+	*bZone = withZone;
+	*zone = zh;
+	return TRUE;
+}
+
 /*
  *	TIMESTAMP <-----> SIMPLE_TIME
  *		precision support since 7.2.
@@ -239,6 +348,8 @@ timestamp2stime(const char *str, SIMPLE_TIME *st, BOOL *bZone, int *zone)
 	*zone = 0;
 	st->fr = 0;
 	st->infinity = 0;
+	if (decode_iso_timestamp(str, st, bZone, zone))
+		goto adjust_zone;
 	rest[0] = '\0';
 	bc[0] = '\0';
 	if ((scnt = sscanf(str, "%4d-%2d-%2d %2d:%2d:%2d%31s %15s", &st->y, &st->m, &st->d, &st->hh, &st->mm, &st->ss, rest, bc)) < 6)
@@ -289,6 +400,7 @@ timestamp2stime(const char *str, SIMPLE_TIME *st, BOOL *bZone, int *zone)
 	{
 		st->y *= -1;
 	}
+adjust_zone:
 	if (!withZone || !*bZone || st->y < 1970)
 		return TRUE;
 #ifdef	TIMEZONE_GLOBAL
@@ -360,7 +472,13 @@ stime2timestamp(const SIMPLE_TIME *st, char *str, size_t bufsize, BOOL bZone,
 	}
 	if (precision > 0 && st->fr)
 	{
-		snprintf(precstr, sizeof(precstr), ".%09d", st->fr);
+		if (st->fr > 0 && st->fr < 1000000000)
+		{
+			precstr[0] = '.';
+			*encode_digits(precstr + 1, st->fr, 9) = '\0';
+		}
+		else
+			snprintf(precstr, sizeof(precstr), ".%09d", st->fr);
 		if (precision < 9)
 			precstr[precision + 1] = '\0';
 		for (i = precision; i > 0; i--)
@@ -400,6 +518,37 @@ stime2timestamp(const SIMPLE_TIME *st, char *str, size_t bufsize, BOOL bZone,
 			snprintf(zonestr, sizeof(zonestr), "+%02d", -(int) zoneint / 3600);
 	}
 #endif /* TIMEZONE_GLOBAL */
+	if (st->y >= 0 && st->y <= 9999 &&
+	    st->m >= 0 && st->m <= 99 && st->d >= 0 && st->d <= 99 &&
+	    st->hh >= 0 && st->hh <= 99 && st->mm >= 0 && st->mm <= 99 &&
+	    st->ss >= 0 && st->ss <= 99)
+	{
+		char	tsbuf[64], *ptr = tsbuf;
+		size_t	len;
+
+		ptr = encode_digits(ptr, st->y, 4);
+		*ptr++ = '-';
+		ptr = encode_digits(ptr, st->m, 2);
+		*ptr++ = '-';
+		ptr = encode_digits(ptr, st->d, 2);
+		*ptr++ = ' ';
+		ptr = encode_digits(ptr, st->hh, 2);
+		*ptr++ = ':';
+		ptr = encode_digits(ptr, st->mm, 2);
+		*ptr++ = ':';
+		ptr = encode_digits(ptr, st->ss, 2);
+		strcpy(ptr, precstr);
+		strcat(ptr, zonestr);
+		len = strlen(tsbuf);
+		if (bufsize > 0)
+		{
+			size_t	cpylen = len < bufsize ? len : bufsize - 1;
+
+			memcpy(str, tsbuf, cpylen);
+			str[cpylen] = '\0';
+		}
+		return (int) len;
+	}
 	if (st->y < 0)
 		return snprintf(str, bufsize, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d%s%s BC", -st->y, st->m, st->d, st->hh, st->mm, st->ss, precstr, zonestr);
 	else
@@ -724,6 +873,176 @@ static double get_double_value(const char *str)
 	return atof(str);
 }
 
+/*
+ *	Parsers for the canonical text output of the server.
+ *
+ *	Integers are sent as an optional minus sign followed by decimal
+ *	digits and floats in the C locale, so the common cases don't need the
+ *	locale aware C library. Anything else (leading spaces, a plus sign,
+ *	values which may overflow ...) makes them return FALSE and the caller
+ *	falls back to the C library, so the results are the same as before.
+ */
+#ifdef	ODBCINT64
+typedef unsigned ODBCINT64	canon_uint;
+#define	CANON_MAX_DIGITS	19
+#else
+typedef UInt4	canon_uint;
+#define	CANON_MAX_DIGITS	9
+#endif /* ODBCINT64 */
+
+static BOOL
+parse_canonical_int(const char *str, BOOL *neg, canon_uint *mag)
+{
+	const char	*ptr = str;
+	canon_uint	val = 0;
+	int		ndigits;
+
+	if (*neg = ('-' == *ptr), *neg)
+		ptr++;
+	for (ndigits = 0; *ptr >= '0' && *ptr <= '9'; ptr++, ndigits++)
+		val = val * 10 + (*ptr - '0');
+	if ('\0' != *ptr || 0 == ndigits || ndigits > CANON_MAX_DIGITS)
+		return FALSE;
+	*mag = val;
+	return TRUE;
+}
+
+static long
+pg_atol(const char *str)
+{
+	BOOL		neg;
+	canon_uint	mag;
+
+	if (parse_canonical_int(str, &neg, &mag) && mag <= 2147483647)
+		return neg ? -((long) mag) : (long) mag;
+	return atol(str);
+}
+
+static UInt4
+pg_atoi32u(const char *str)
+{
+	BOOL		neg;
+	canon_uint	mag;
+
+	if (parse_canonical_int(str, &neg, &mag) && !neg && mag <= 4294967295U)
+		return (UInt4) mag;
+	return ATOI32U(str);
+}
+
+#ifdef	ODBCINT64
+static SQLBIGINT
+pg_atoi64(const char *str)
+{
+	BOOL		neg;
+	canon_uint	mag;
+
+	if (parse_canonical_int(str, &neg, &mag) && mag <= (canon_uint) 9223372036854775807LL)
+		return neg ? -((SQLBIGINT) mag) : (SQLBIGINT) mag;
+	return ATOI64(str);
+}
+
+static SQLUBIGINT
+pg_atoi64u(const char *str)
+{
+	BOOL		neg;
+	canon_uint	mag;
+
+	if (parse_canonical_int(str, &neg, &mag) && !neg)
+		return (SQLUBIGINT) mag;
+	return ATOI64U(str);
+}
+
+/*
+ *	A float with at most 15 significant digits and a decimal exponent
+ *	within +-22 is converted exactly by a single multiplication or
+ *	division, because both operands are exact doubles.
+ */
+static BOOL
+parse_canonical_double(const char *str, double *val)
+{
+	static const double	pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+		1e21, 1e22};
+	const char	*ptr = str;
+	canon_uint	mant = 0;
+	int		ndigits = 0, exp10 = 0, expval, expdigits;
+	BOOL		neg, expneg, digits = FALSE;
+	double		dval;
+
+	if (neg = ('-' == *ptr), neg)
+		ptr++;
+	for (; *ptr >= '0' && *ptr <= '9'; ptr++)
+	{
+		digits = TRUE;
+		if (0 == mant && '0' == *ptr)
+			continue;
+		if (++ndigits > 15)
+			return FALSE;
+		mant = mant * 10 + (*ptr - '0');
+	}
+	if ('.' == *ptr)
+	{
+		for (ptr++; *ptr >= '0' && *ptr <= '9'; ptr++)
+		{
+			digits = TRUE;
+			exp10--;
+			if (0 == mant && '0' == *ptr)
+				continue;
+			if (++ndigits > 15)
+				return FALSE;
+			mant = mant * 10 + (*ptr - '0');
+		}
+	}
+	if (!digits)
+		return FALSE;
+	if ('e' == *ptr || 'E' == *ptr)
+	{
+		ptr++;
+		if (expneg = ('-' == *ptr), expneg || '+' == *ptr)
+			ptr++;
+		for (expval = 0, expdigits = 0; *ptr >= '0' && *ptr <= '9'; ptr++)
+		{
+			if (++expdigits > 3)
+				return FALSE;
+			expval = expval * 10 + (*ptr - '0');
+		}
+		if (0 == expdigits)
+			return FALSE;
+		exp10 += expneg ? -expval : expval;
+	}
+	if ('\0' != *ptr)
+		return FALSE;
+	if (0 == mant)
+		dval = .0;
+	else if (exp10 < -22 || exp10 > 22)
+		return FALSE;
+	else if (exp10 < 0)
+		dval = (double) mant / pow10[-exp10];
+	else
+		dval = (double) mant * pow10[exp10];
+	*val = neg ? -dval : dval;
+	return TRUE;
+}
+#endif /* ODBCINT64 */
+
+/*
+ *	Get the double value of a float sent by the server. The string may
+ *	be modified for the decimal point of the current locale.
+ */
+static double
+get_client_double_value(char *str)
+{
+#ifdef	ODBCINT64
+	double	dval;
+
+	if (parse_canonical_double(str, &dval))
+		return dval;
+#endif /* ODBCINT64 */
+	set_client_decimal_point(str);
+	return get_double_value(str);
+}
+
 static int char2guid(const char *str, SQLGUID *g)
 {
 	/*
@@ -942,11 +1261,13 @@ mylog("null_cvt_date_string=%d\n", conn->connInfo.cvt_null_date_string);
 			 * PG_TYPE_CHAR,VARCHAR $$$
 			 */
 		case PG_TYPE_DATE:
-			sscanf(value, "%4d-%2d-%2d", &std_time.y, &std_time.m, &std_time.d);
+			if (!decode_iso_date(value, &std_time))
+				sscanf(value, "%4d-%2d-%2d", &std_time.y, &std_time.m, &std_time.d);
 			break;
 
 		case PG_TYPE_TIME:
-			sscanf(value, "%2d:%2d:%2d", &std_time.hh, &std_time.mm, &std_time.ss);
+			if (!decode_iso_time(value, &std_time))
+				sscanf(value, "%2d:%2d:%2d", &std_time.hh, &std_time.mm, &std_time.ss);
 			break;
 
 		case PG_TYPE_ABSTIME:
@@ -1552,13 +1873,13 @@ inolog("2stime fr=%d\n", std_time.fr);
 			case SQL_C_BIT:
 				len = 1;
 				if (bind_size > 0)
-					*((UCHAR *) rgbValueBindRow) = atoi(neut_str);
+					*((UCHAR *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((UCHAR *) rgbValue + bind_row) = atoi(neut_str);
+					*((UCHAR *) rgbValue + bind_row) = pg_atol(neut_str);
 
 				/*
 				 * mylog("SQL_C_BIT: bind_row = %d val = %d, cb = %d,
-				 * rgb=%d\n", bind_row, atoi(neut_str), cbValueMax,
+				 * rgb=%d\n", bind_row, pg_atol(neut_str), cbValueMax,
 				 * *((UCHAR *)rgbValue));
 				 */
 				break;
@@ -1567,35 +1888,33 @@ inolog("2stime fr=%d\n", std_time.fr);
 			case SQL_C_TINYINT:
 				len = 1;
 				if (bind_size > 0)
-					*((SCHAR *) rgbValueBindRow) = atoi(neut_str);
+					*((SCHAR *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((SCHAR *) rgbValue + bind_row) = atoi(neut_str);
+					*((SCHAR *) rgbValue + bind_row) = pg_atol(neut_str);
 				break;
 
 			case SQL_C_UTINYINT:
 				len = 1;
 				if (bind_size > 0)
-					*((UCHAR *) rgbValueBindRow) = atoi(neut_str);
+					*((UCHAR *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((UCHAR *) rgbValue + bind_row) = atoi(neut_str);
+					*((UCHAR *) rgbValue + bind_row) = pg_atol(neut_str);
 				break;
 
 			case SQL_C_FLOAT:
-				set_client_decimal_point((char *) neut_str);
 				len = 4;
 				if (bind_size > 0)
-					*((SFLOAT *) rgbValueBindRow) = (float) get_double_value(neut_str);
+					*((SFLOAT *) rgbValueBindRow) = (float) get_client_double_value((char *) neut_str);
 				else
-					*((SFLOAT *) rgbValue + bind_row) = (float) get_double_value(neut_str);
+					*((SFLOAT *) rgbValue + bind_row) = (float) get_client_double_value((char *) neut_str);
 				break;
 
 			case SQL_C_DOUBLE:
-				set_client_decimal_point((char *) neut_str);
 				len = 8;
 				if (bind_size > 0)
-					*((SDOUBLE *) rgbValueBindRow) = get_double_value(neut_str);
+					*((SDOUBLE *) rgbValueBindRow) = get_client_double_value((char *) neut_str);
 				else
-					*((SDOUBLE *) rgbValue + bind_row) = get_double_value(neut_str);
+					*((SDOUBLE *) rgbValue + bind_row) = get_client_double_value((char *) neut_str);
 				break;
 
 			case SQL_C_NUMERIC:
@@ -1618,51 +1937,51 @@ inolog("2stime fr=%d\n", std_time.fr);
 			case SQL_C_SHORT:
 				len = 2;
 				if (bind_size > 0)
-					*((SQLSMALLINT *) rgbValueBindRow) = atoi(neut_str);
+					*((SQLSMALLINT *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((SQLSMALLINT *) rgbValue + bind_row) = atoi(neut_str);
+					*((SQLSMALLINT *) rgbValue + bind_row) = pg_atol(neut_str);
 				break;
 
 			case SQL_C_USHORT:
 				len = 2;
 				if (bind_size > 0)
-					*((SQLUSMALLINT *) rgbValueBindRow) = atoi(neut_str);
+					*((SQLUSMALLINT *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((SQLUSMALLINT *) rgbValue + bind_row) = atoi(neut_str);
+					*((SQLUSMALLINT *) rgbValue + bind_row) = pg_atol(neut_str);
 				break;
 
 			case SQL_C_SLONG:
 			case SQL_C_LONG:
 				len = 4;
 				if (bind_size > 0)
-					*((SQLINTEGER *) rgbValueBindRow) = atol(neut_str);
+					*((SQLINTEGER *) rgbValueBindRow) = pg_atol(neut_str);
 				else
-					*((SQLINTEGER *) rgbValue + bind_row) = atol(neut_str);
+					*((SQLINTEGER *) rgbValue + bind_row) = pg_atol(neut_str);
 				break;
 
 			case SQL_C_ULONG:
 				len = 4;
 				if (bind_size > 0)
-					*((SQLUINTEGER *) rgbValueBindRow) = ATOI32U(neut_str);
+					*((SQLUINTEGER *) rgbValueBindRow) = pg_atoi32u(neut_str);
 				else
-					*((SQLUINTEGER *) rgbValue + bind_row) = ATOI32U(neut_str);
+					*((SQLUINTEGER *) rgbValue + bind_row) = pg_atoi32u(neut_str);
 				break;
 
 #ifdef ODBCINT64
 			case SQL_C_SBIGINT:
 				len = 8;
 				if (bind_size > 0)
-					*((SQLBIGINT *) rgbValueBindRow) = ATOI64(neut_str);
+					*((SQLBIGINT *) rgbValueBindRow) = pg_atoi64(neut_str);
 				else
-					*((SQLBIGINT *) rgbValue + bind_row) = ATOI64(neut_str);
+					*((SQLBIGINT *) rgbValue + bind_row) = pg_atoi64(neut_str);
 				break;
 
 			case SQL_C_UBIGINT:
 				len = 8;
 				if (bind_size > 0)
-					*((SQLUBIGINT *) rgbValueBindRow) = ATOI64U(neut_str);
+					*((SQLUBIGINT *) rgbValueBindRow) = pg_atoi64u(neut_str);
 				else
-					*((SQLUBIGINT *) rgbValue + bind_row) = ATOI64U(neut_str);
+					*((SQLUBIGINT *) rgbValue + bind_row) = pg_atoi64u(neut_str);
 				break;
 
 #endif /* ODBCINT64 */
@@ -1695,7 +2014,7 @@ inolog("2stime fr=%d\n", std_time.fr);
 				/* The following is for SQL_C_VARBOOKMARK */
 				else if (PG_TYPE_INT4 == field_type)
 				{
-					UInt4	ival = ATOI32U(neut_str);
+					UInt4	ival = pg_atoi32u(neut_str);
 
 inolog("SQL_C_VARBOOKMARK value=%d\n", ival);
 					if (pcbValue)
@@ -1850,6 +2169,166 @@ inolog("SQL_C_VARBOOKMARK value=%d\n", ival);
 
 }
 
+/*
+ *	Can copy_and_convert_column() handle the conversion from field_type
+ *	to fCType ?
+ */
+BOOL
+copy_and_convert_column_available(const StatementClass *stmt, OID field_type, SQLSMALLINT fCType)
+{
+	if (NULL != stmt->hdbc->DataSourceToDriver)
+		return FALSE;
+	switch (fCType)
+	{
+		case SQL_C_SLONG:
+		case SQL_C_LONG:
+			switch (field_type)
+			{
+				case PG_TYPE_INT2:
+				case PG_TYPE_INT4:
+					return TRUE;
+			}
+			break;
+#ifdef ODBCINT64
+		case SQL_C_SBIGINT:
+			switch (field_type)
+			{
+				case PG_TYPE_INT2:
+				case PG_TYPE_INT4:
+				case PG_TYPE_INT8:
+					return TRUE;
+			}
+			break;
+#endif /* ODBCINT64 */
+		case SQL_C_DOUBLE:
+			switch (field_type)
+			{
+				case PG_TYPE_INT2:
+				case PG_TYPE_INT4:
+				case PG_TYPE_FLOAT4:
+				case PG_TYPE_FLOAT8:
+					return TRUE;
+			}
+			break;
+#ifndef	WIN_UNICODE_SUPPORT
+		case SQL_C_CHAR:
+			switch (field_type)
+			{
+				case PG_TYPE_BPCHAR:
+				case PG_TYPE_VARCHAR:
+				case PG_TYPE_TEXT:
+					return TRUE;
+			}
+			break;
+#endif /* WIN_UNICODE_SUPPORT */
+	}
+	return FALSE;
+}
+
+/*
+ *	Convert the column col of nrows rows into its column-wise bound
+ *	array, starting at the binding row bind_row. tuple points to the
+ *	field of the first row and the following rows are num_fields
+ *	apart. The common cases are handled in the loop here and the rest
+ *	(NULL without an indicator, truncation, linefeed conversion ...)
+ *	is left to copy_and_convert_field().
+ *	A row which can't be converted doesn't stop the others. It's
+ *	marked SQL_ROW_ERROR in rowStatus, and the return value of its
+ *	conversion is set to *row_error unless that already holds one.
+ */
+int
+copy_and_convert_column(StatementClass *stmt,
+			OID field_type, int atttypmod,
+			const TupleField *tuple, int num_fields,
+			int col, SQLSETPOSIROW bind_row, SQLLEN nrows,
+			SQLUSMALLINT *rowStatus, int *row_error)
+{
+	ARDFields	*opts = SC_get_ARDF(stmt);
+	const BindInfoClass *bic = &(opts->bindings[col]);
+	SQLULEN	offset = opts->row_offset_ptr ? *opts->row_offset_ptr : 0;
+	char	*rgbValue = bic->buffer + offset;
+	SQLLEN	cbValueMax = bic->buflen;
+	SQLLEN	*pcbValue = LENADDR_SHIFT(bic->used, offset);
+	SQLLEN	*pIndicator = LENADDR_SHIFT(bic->indicator, offset);
+	BOOL	lf_conv = SC_get_conn(stmt)->connInfo.lf_conversion;
+	SQLSETPOSIROW	bind_save = stmt->bind_row;
+	SQLLEN	i, irow, len;
+	char	*value;
+	int	retval, result = COPY_OK;
+
+	for (i = 0; i < nrows; i++, tuple += num_fields)
+	{
+		irow = bind_row + i;
+		value = tuple->value;
+		if (NULL == value)
+		{
+			if (pIndicator)
+			{
+				pIndicator[irow] = SQL_NULL_DATA;
+				continue;
+			}
+		}
+		else
+		{
+			len = -1;
+			switch (bic->returntype)
+			{
+				case SQL_C_SLONG:
+				case SQL_C_LONG:
+					((SQLINTEGER *) rgbValue)[irow] = pg_atol(value);
+					len = 4;
+					break;
+#ifdef ODBCINT64
+				case SQL_C_SBIGINT:
+					((SQLBIGINT *) rgbValue)[irow] = pg_atoi64(value);
+					len = 8;
+					break;
+#endif /* ODBCINT64 */
+				case SQL_C_DOUBLE:
+					((SDOUBLE *) rgbValue)[irow] = get_client_double_value(value);
+					len = 8;
+					break;
+				case SQL_C_CHAR:
+					len = strlen(value);
+					if (len >= cbValueMax ||
+					    (lf_conv && NULL != memchr(value, '\n', len)))
+						len = -1;
+					else
+						memcpy(rgbValue + irow * cbValueMax, value, len + 1);
+					break;
+			}
+			if (len >= 0)
+			{
+				if (pIndicator)
+					pIndicator[irow] = 0;
+				if (pcbValue)
+					pcbValue[irow] = len;
+				continue;
+			}
+		}
+		/* the general conversion for this row */
+		stmt->bind_row = (SQLSETPOSIROW) irow;
+		retval = copy_and_convert_field_bindinfo(stmt, field_type, atttypmod, value, col);
+		stmt->bind_row = bind_save;
+		switch (retval)
+		{
+			case COPY_OK:
+			case COPY_NO_DATA_FOUND:
+				break;
+			case COPY_RESULT_TRUNCATED:
+				result = retval;
+				break;
+			default:
+				if (rowStatus)
+					rowStatus[irow] = SQL_ROW_ERROR;
+				if (COPY_OK == *row_error)
+					*row_error = retval;
+				break;
+		}
+	}
+	return result;
+}
+
 
 /*--------------------------------------------------------------------
  *	Functions/Macros to get rid of query size limit.
@@ -1919,6 +2398,18 @@ QP_initialize(QueryParse *q, const StatementClass *stmt)
 #define	FLGB_BINARY_AS_POSSIBLE	(1L << 9)
 #define	FLGB_LITERAL_EXTENSION	(1L << 10)
 #define	FLGB_HEX_BIN_FORMAT	(1L << 11)
+
+/*
+ *	A parameter value which is sent from the data at execution buffer
+ *	as it is, instead of being copied into query_statement first.
+ */
+typedef struct
+{
+	size_t		pos;	/* offset in query_statement the data follows */
+	const char	*data;
+	size_t		len;
+}	QB_ExtData;
+
 typedef struct _QueryBuild {
 	char   *query_statement;
 	size_t	str_alsize;
@@ -1943,6 +2434,10 @@ typedef struct _QueryBuild {
 
 	ConnectionClass	*conn; /* mainly needed for LO handling */
 	StatementClass	*stmt; /* needed to set error info in ENLARGE_.. */
+
+	QB_ExtData	*extdata;	/* only used to build a Bind message */
+	Int2		num_extdata;
+	size_t		extdata_len;
 }	QueryBuild;
 
 #define INIT_MIN_ALLOC	4096
@@ -1963,6 +2458,9 @@ QB_initialize(QueryBuild *qb, size_t size, StatementClass *stmt, ConnectionClass
 	qb->num_discard_params = 0;
 	qb->brace_level = 0;
 	qb->parenthesize_the_first = FALSE;
+	qb->extdata = NULL;
+	qb->num_extdata = 0;
+	qb->extdata_len = 0;
 	if (conn)
 		qb->conn = conn;
 	else if (stmt)
@@ -2023,6 +2521,9 @@ static int
 QB_initialize_copy(QueryBuild *qb_to, const QueryBuild *qb_from, UInt4 size)
 {
 	memcpy(qb_to, qb_from, sizeof(QueryBuild));
+	qb_to->extdata = NULL;
+	qb_to->num_extdata = 0;
+	qb_to->extdata_len = 0;
 
 	if ((qb_to->query_statement = malloc(size)) == NULL)
 	{
@@ -2056,6 +2557,34 @@ QB_Destructor(QueryBuild *qb)
 		qb->query_statement = NULL;
 		qb->str_alsize = 0;
 	}
+	if (qb->extdata)
+	{
+		free(qb->extdata);
+		qb->extdata = NULL;
+		qb->num_extdata = 0;
+		qb->extdata_len = 0;
+	}
+}
+
+/*
+ *	Let the data follow the current end of query_statement without
+ *	copying it. The data must be kept until the message is sent.
+ */
+static BOOL
+QB_append_extdata(QueryBuild *qb, const char *data, size_t len)
+{
+	QB_ExtData	*extdata;
+
+	extdata = (QB_ExtData *) realloc(qb->extdata, sizeof(QB_ExtData) * (qb->num_extdata + 1));
+	if (!extdata)
+		return FALSE;
+	qb->extdata = extdata;
+	extdata += qb->num_extdata++;
+	extdata->pos = qb->npos;
+	extdata->data = data;
+	extdata->len = len;
+	qb->extdata_len += len;
+	return TRUE;
 }
 
 /*
@@ -2811,7 +3340,13 @@ inolog("type=%d concur=%d\n", stmt->options.cursor_type, stmt->options.scroll_co
 		if (SQL_CONCUR_READ_ONLY != stmt->options.scroll_concurrency)
 		{
 			qb->flags |= FLGB_CREATE_KEYSET;
-			if (SQL_CURSOR_KEYSET_DRIVEN == stmt->options.cursor_type)
+			/*
+			 * A cursor hands out the keys along with the rows a block
+			 * at a time, so collect all of them in advance only when
+			 * not using a cursor.
+			 */
+			if (SQL_CURSOR_KEYSET_DRIVEN == stmt->options.cursor_type &&
+			    0 == (qp->flags & FLGP_USING_CURSOR))
 				qb->flags |= FLGB_KEYSET_DRIVEN;
 		}
 	}
@@ -3427,7 +3962,7 @@ BOOL	BuildBindRequest(StatementClass *stmt, const char *plan_name)
 {
 	CSTR func = "BuildBindRequest";
 	QueryBuild	qb;
-	size_t		leng, plen;
+	size_t		leng, plen, sent;
 	UInt4		netleng;
 	SQLSMALLINT	num_p;
 	Int2		netnum_p;
@@ -3531,6 +4066,7 @@ inolog("%dth parameter type oid is %u\n", i, PIC_dsp_pgtype(conn, parameters[i])
 		BOOL		isnull;
 		int			npos;
 		UInt4		slen;
+		size_t		extdata_len = qb.extdata_len;
 
 		/* reserve a spot for the length word */
 		npos = qb.npos;
@@ -3549,7 +4085,7 @@ inolog("%dth parameter type oid is %u\n", i, PIC_dsp_pgtype(conn, parameters[i])
 		if (isnull)
 			slen = htonl(-1);
 		else
-			slen = htonl((UInt4) (qb.npos - npos - 4));
+			slen = htonl((UInt4) (qb.npos - npos - 4 + qb.extdata_len - extdata_len));
 		memcpy(qb.query_statement + npos, &slen, sizeof(slen));
 	}
 	leng = qb.npos;
@@ -3568,7 +4104,7 @@ inolog("%dth parameter type oid is %u\n", i, PIC_dsp_pgtype(conn, parameters[i])
 
 	/* now that we know the final length of the packet, fill that in */
 inolog("bind leng=%d\n", leng);
-	netleng = htonl((UInt4) leng);	/* Network byte order */
+	netleng = htonl((UInt4) (leng + qb.extdata_len));	/* Network byte order */
 	memcpy(qb.query_statement, &netleng, sizeof(netleng));
 
 	if (CC_is_in_trans(conn) && !SC_accessed_db(stmt))
@@ -3587,7 +4123,15 @@ inolog("bind leng=%d\n", leng);
 		sockerr = TRUE;
 		goto cleanup;
 	}
-	SOCK_put_n_char(conn->sock, qb.query_statement, leng);
+	for (i = 0, sent = 0; i < qb.num_extdata; i++)
+	{
+		const QB_ExtData	*extdata = qb.extdata + i;
+
+		SOCK_put_n_char(conn->sock, qb.query_statement + sent, extdata->pos - sent);
+		SOCK_put_n_char(conn->sock, extdata->data, extdata->len);
+		sent = extdata->pos;
+	}
+	SOCK_put_n_char(conn->sock, qb.query_statement + sent, leng - sent);
 	if (SOCK_get_errcode(conn->sock) != 0)
 		sockerr = TRUE;
 cleanup:
@@ -4477,7 +5021,15 @@ mylog("buf=%p flag=%d\n", buf, qb->flags);
 				if (0 != (qb->flags & FLGB_BINARY_AS_POSSIBLE))
 				{
 					mylog("sending binary data leng=%d\n", used);
-					CVT_APPEND_DATA(qb, buf, used);
+					/*
+					 * A data at execution value is sent directly from
+					 * the put data buffer, which may be huge.
+					 */
+					if (apara->data_at_exec && buf == buffer &&
+					    QB_append_extdata(qb, buf, used))
+						;
+					else
+						CVT_APPEND_DATA(qb, buf, used);
 				}
 				else
 				{
@@ -5123,6 +5675,13 @@ parse_datetime(const char *buf, SIMPLE_TIME *st)
 			return FALSE;
 		buf++;
 	}
+	if (decode_iso_date(buf, st))
+	{
+		if ('\0' == buf[10])
+			return TRUE;
+		if (' ' == buf[10] && decode_iso_time(buf + 11, st))
+			return TRUE;
+	}
 	if (buf[4] == '-')			/* year first */
 		nf = sscanf(buf, "%4d-%2d-%2d %2d:%2d:%2d", &y, &m, &d, &hh, &mm, &ss);
 	else
@@ -5606,17 +6165,10 @@ convert_lo(StatementClass *stmt, const void *value, SQLSMALLINT fCType, PTR rgbV
 			return COPY_GENERAL_ERROR;
 		}
 
-		/* Get the size */
-		retval = odbc_lo_lseek(conn, stmt->lobj_fd, 0L, SEEK_END);
-		if (retval >= 0)
-		{
-			left = odbc_lo_tell(conn, stmt->lobj_fd);
-			if (gdata)
-				gdata->data_left = left;
-
-			/* return to beginning */
-			odbc_lo_lseek(conn, stmt->lobj_fd, 0L, SEEK_SET);
-		}
+		/* Get the size and read ahead the first chunk */
+		left = odbc_lo_size_and_read(conn, stmt->lobj_fd, &stmt->lobj_buf);
+		if (left >= 0 && gdata)
+			gdata->data_left = left;
 	}
 	else if (left == 0)
 		return COPY_NO_DATA_FOUND;
@@ -5631,10 +6183,10 @@ convert_lo(StatementClass *stmt, const void *value, SQLSMALLINT fCType, PTR rgbV
 	if (0 >= cbValueMax)
 		retval = 0;
 	else
-		retval = odbc_lo_read(conn, stmt->lobj_fd, (char *) rgbValue, (Int4) (factor > 1 ? (cbValueMax - 1) / factor : cbValueMax));
+		retval = odbc_lo_read_buffered(conn, stmt->lobj_fd, &stmt->lobj_buf, (char *) rgbValue, (Int4) (factor > 1 ? (cbValueMax - 1) / factor : cbValueMax));
 	if (retval < 0)
 	{
-		odbc_lo_close(conn, stmt->lobj_fd);
+		odbc_lo_close_buffered(conn, stmt->lobj_fd, &stmt->lobj_buf);
 
 		/* commit transaction if needed */
 		if (!ci->drivers.use_declarefetch && CC_does_autocommit(conn))
@@ -5667,7 +6219,7 @@ convert_lo(StatementClass *stmt, const void *value, SQLSMALLINT fCType, PTR rgbV
 
 	if (!gdata || gdata->data_left == 0)
 	{
-		odbc_lo_close(conn, stmt->lobj_fd);
+		odbc_lo_close_buffered(conn, stmt->lobj_fd, &stmt->lobj_buf);
 
 		/* commit transaction if needed */
 		if (!ci->drivers.use_declarefetch && CC_does_autocommit(conn))
@@ -44,6 +44,12 @@ int	copy_and_convert_field(StatementClass *stmt,
 			void *value,
 			SQLSMALLINT fCType, int precision,
 			PTR rgbValue, SQLLEN cbValueMax, SQLLEN *pcbValue, SQLLEN *pIndicator);
+BOOL	copy_and_convert_column_available(const StatementClass *stmt, OID field_type, SQLSMALLINT fCType);
+int	copy_and_convert_column(StatementClass *stmt,
+			OID field_type, int atttypmod,
+			const TupleField *tuple, int num_fields,
+			int col, SQLSETPOSIROW bind_row, SQLLEN nrows,
+			SQLUSMALLINT *rowStatus, int *row_error);
 
 int		copy_statement_with_parameters(StatementClass *stmt, BOOL);
 BOOL		convert_money(const char *s, char *sout, size_t soutmax);
@@ -220,6 +220,102 @@ makeKeepaliveConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
 	return target;
 }
 
+static char *
+makeSpillRowsConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
+{
+	char	*buf = target;
+	*buf = '\0';
+
+	if (ci->spill_rows <= 0)
+		return target;
+
+	if (abbrev)
+		sprintf(buf, ABBR_SPILLROWS "=%u;", ci->spill_rows);
+	else
+		sprintf(buf, INI_SPILLROWS "=%u;", ci->spill_rows);
+	return target;
+}
+
+static char *
+makeServerSideTimeoutConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
+{
+	char	*buf = target;
+	*buf = '\0';
+
+	if (ci->server_side_timeout <= 0)
+		return target;
+
+	if (abbrev)
+		sprintf(buf, ABBR_SERVERSIDETIMEOUT "=%d;", ci->server_side_timeout);
+	else
+		sprintf(buf, INI_SERVERSIDETIMEOUT "=%d;", ci->server_side_timeout);
+	return target;
+}
+
+static char *
+makeCatalogCacheTTLConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
+{
+	char	*buf = target;
+	*buf = '\0';
+
+	if (ci->catalog_cache_ttl <= 0)
+		return target;
+
+	if (abbrev)
+		sprintf(buf, ABBR_CATALOGCACHETTL "=%d;", ci->catalog_cache_ttl);
+	else
+		sprintf(buf, INI_CATALOGCACHETTL "=%d;", ci->catalog_cache_ttl);
+	return target;
+}
+
+static char *
+makeStreamResultsConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
+{
+	char	*buf = target;
+	*buf = '\0';
+
+	if (ci->stream_results <= 0)
+		return target;
+
+	if (abbrev)
+		sprintf(buf, ABBR_STREAMRESULTS "=%d;", ci->stream_results);
+	else
+		sprintf(buf, INI_STREAMRESULTS "=%d;", ci->stream_results);
+	return target;
+}
+
+static char *
+makeHostSelectionConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
+{
+	char	*buf = target;
+	*buf = '\0';
+
+	if (ci->target_session_attrs[0])
+	{
+		if (abbrev)
+			sprintf(buf, ABBR_TARGETSESSIONATTRS "=%s;", ci->target_session_attrs);
+		else
+			sprintf(buf, INI_TARGETSESSIONATTRS "=%s;", ci->target_session_attrs);
+		buf = strchr(buf, (int) '\0');
+	}
+	if (ci->load_balance_hosts > 0)
+	{
+		if (abbrev)
+			sprintf(buf, ABBR_LOADBALANCEHOSTS "=%d;", ci->load_balance_hosts);
+		else
+			sprintf(buf, INI_LOADBALANCEHOSTS "=%d;", ci->load_balance_hosts);
+		buf = strchr(buf, (int) '\0');
+	}
+	if (ci->host_recheck_secs >= 0)
+	{
+		if (abbrev)
+			sprintf(buf, ABBR_HOSTRECHECKSECONDS "=%d;", ci->host_recheck_secs);
+		else
+			sprintf(buf, INI_HOSTRECHECKSECONDS "=%d;", ci->host_recheck_secs);
+	}
+	return target;
+}
+
 #ifdef	USE_LIBPQ
 static char *
 makePreferLibpqConnectString(char *target, const ConnInfo *ci, BOOL abbrev)
@@ -265,6 +361,11 @@ makeConnectString(char *connect_string, const ConnInfo *ci, UWORD len)
 	char		got_dsn = (ci->dsn[0] != '\0');
 	char		encoded_item[LARGE_REGISTRY_LEN];
 	char		keepaliveStr[32];
+	char		spillRowsStr[32];
+	char		serverSideTimeoutStr[32];
+	char		catalogCacheTTLStr[32];
+	char		streamResultsStr[32];
+	char		hostSelectionStr[80];
 #ifdef	USE_LIBPQ
 	char		preferLibpqStr[32];
 #endif
@@ -340,6 +441,11 @@ inolog("hlen=%d", hlen);
 			INI_USESERVERSIDEPREPARE "=%d;"
 			INI_LOWERCASEIDENTIFIER "=%d;"
 			"%s"
+			"%s"
+			"%s"
+			"%s"
+			"%s"
+			"%s"
 #ifdef	USE_LIBPQ
 			"%s"
 #endif /* USE_LIBPQ */
@@ -380,6 +486,11 @@ inolog("hlen=%d", hlen);
 			,ci->use_server_side_prepare
 			,ci->lower_case_identifier
 			,makeKeepaliveConnectString(keepaliveStr, ci, FALSE)
+			,makeSpillRowsConnectString(spillRowsStr, ci, FALSE)
+			,makeServerSideTimeoutConnectString(serverSideTimeoutStr, ci, FALSE)
+			,makeCatalogCacheTTLConnectString(catalogCacheTTLStr, ci, FALSE)
+			,makeStreamResultsConnectString(streamResultsStr, ci, FALSE)
+			,makeHostSelectionConnectString(hostSelectionStr, ci, FALSE)
 #ifdef	USE_LIBPQ
 			,makePreferLibpqConnectString(preferLibpqStr, ci, FALSE)
 #endif /* USE_LIBPQ */
@@ -467,6 +578,11 @@ inolog("hlen=%d", hlen);
 				INI_INT8AS "=%d;"
 				ABBR_EXTRASYSTABLEPREFIXES "=%s;"
 				"%s"
+				"%s"
+				"%s"
+				"%s"
+				"%s"
+				"%s"
 #ifdef	USE_LIBPQ
 				"%s"
 #endif /* USE_LIBPQ */
@@ -482,6 +598,11 @@ inolog("hlen=%d", hlen);
 				ci->int8_as,
 				ci->drivers.extra_systable_prefixes,
 				makeKeepaliveConnectString(keepaliveStr, ci, TRUE),
+				makeSpillRowsConnectString(spillRowsStr, ci, TRUE),
+				makeServerSideTimeoutConnectString(serverSideTimeoutStr, ci, TRUE),
+				makeCatalogCacheTTLConnectString(catalogCacheTTLStr, ci, TRUE),
+				makeStreamResultsConnectString(streamResultsStr, ci, TRUE),
+				makeHostSelectionConnectString(hostSelectionStr, ci, TRUE),
 #ifdef	USE_LIBPQ
 				makePreferLibpqConnectString(preferLibpqStr, ci, TRUE),
 #endif /* USE_LIBPQ */
@@ -677,6 +798,20 @@ copyAttributes(ConnInfo *ci, const char *attribute, const char *value)
 		ci->keepalive_idle = atoi(value);
 	else if (stricmp(attribute, INI_KEEPALIVEINTERVAL) == 0 || stricmp(attribute, ABBR_KEEPALIVEINTERVAL) == 0)
 		ci->keepalive_interval = atoi(value);
+	else if (stricmp(attribute, INI_SPILLROWS) == 0 || stricmp(attribute, ABBR_SPILLROWS) == 0)
+		ci->spill_rows = atoi(value);
+	else if (stricmp(attribute, INI_SERVERSIDETIMEOUT) == 0 || stricmp(attribute, ABBR_SERVERSIDETIMEOUT) == 0)
+		ci->server_side_timeout = atoi(value);
+	else if (stricmp(attribute, INI_CATALOGCACHETTL) == 0 || stricmp(attribute, ABBR_CATALOGCACHETTL) == 0)
+		ci->catalog_cache_ttl = atoi(value);
+	else if (stricmp(attribute, INI_STREAMRESULTS) == 0 || stricmp(attribute, ABBR_STREAMRESULTS) == 0)
+		ci->stream_results = atoi(value);
+	else if (stricmp(attribute, INI_TARGETSESSIONATTRS) == 0 || stricmp(attribute, ABBR_TARGETSESSIONATTRS) == 0)
+		strncpy_null(ci->target_session_attrs, value, sizeof(ci->target_session_attrs));
+	else if (stricmp(attribute, INI_LOADBALANCEHOSTS) == 0 || stricmp(attribute, ABBR_LOADBALANCEHOSTS) == 0)
+		ci->load_balance_hosts = atoi(value);
+	else if (stricmp(attribute, INI_HOSTRECHECKSECONDS) == 0 || stricmp(attribute, ABBR_HOSTRECHECKSECONDS) == 0)
+		ci->host_recheck_secs = atoi(value);
 #ifdef	USE_LIBPQ
 	else if (stricmp(attribute, INI_PREFERLIBPQ) == 0 || stricmp(attribute, ABBR_PREFERLIBPQ) == 0)
 		ci->prefer_libpq = atoi(value);
@@ -1067,6 +1202,44 @@ getDSNinfo(ConnInfo *ci, char overwrite)
 			if (0 == (ci->keepalive_interval = atoi(temp)))
 				ci->keepalive_interval = -1;
 	}
+	if (ci->spill_rows < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_SPILLROWS, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->spill_rows = atoi(temp);
+	}
+	if (ci->server_side_timeout < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_SERVERSIDETIMEOUT, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->server_side_timeout = atoi(temp);
+	}
+	if (ci->catalog_cache_ttl < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_CATALOGCACHETTL, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->catalog_cache_ttl = atoi(temp);
+	}
+	if (ci->stream_results < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_STREAMRESULTS, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->stream_results = atoi(temp);
+	}
+	if (ci->target_session_attrs[0] == '\0' || overwrite)
+		SQLGetPrivateProfileString(DSN, INI_TARGETSESSIONATTRS, "", ci->target_session_attrs, sizeof(ci->target_session_attrs), ODBC_INI);
+	if (ci->load_balance_hosts < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_LOADBALANCEHOSTS, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->load_balance_hosts = atoi(temp);
+	}
+	if (ci->host_recheck_secs < 0 || overwrite)
+	{
+		SQLGetPrivateProfileString(DSN, INI_HOSTRECHECKSECONDS, "", temp, sizeof(temp), ODBC_INI);
+		if (temp[0])
+			ci->host_recheck_secs = atoi(temp);
+	}
 #ifdef	USE_LIBPQ
 	if (ci->prefer_libpq < 0 || overwrite)
 	{
@@ -1368,6 +1541,40 @@ writeDSNinfo(const ConnInfo *ci)
 								 INI_KEEPALIVEINTERVAL,
 								 temp,
 								 ODBC_INI);
+	sprintf(temp, "%d", ci->spill_rows);
+	SQLWritePrivateProfileString(DSN,
+								 INI_SPILLROWS,
+								 temp,
+								 ODBC_INI);
+	sprintf(temp, "%d", ci->server_side_timeout);
+	SQLWritePrivateProfileString(DSN,
+								 INI_SERVERSIDETIMEOUT,
+								 temp,
+								 ODBC_INI);
+	sprintf(temp, "%d", ci->catalog_cache_ttl);
+	SQLWritePrivateProfileString(DSN,
+								 INI_CATALOGCACHETTL,
+								 temp,
+								 ODBC_INI);
+	sprintf(temp, "%d", ci->stream_results);
+	SQLWritePrivateProfileString(DSN,
+								 INI_STREAMRESULTS,
+								 temp,
+								 ODBC_INI);
+	SQLWritePrivateProfileString(DSN,
+								 INI_TARGETSESSIONATTRS,
+								 ci->target_session_attrs,
+								 ODBC_INI);
+	sprintf(temp, "%d", ci->load_balance_hosts);
+	SQLWritePrivateProfileString(DSN,
+								 INI_LOADBALANCEHOSTS,
+								 temp,
+								 ODBC_INI);
+	sprintf(temp, "%d", ci->host_recheck_secs);
+	SQLWritePrivateProfileString(DSN,
+								 INI_HOSTRECHECKSECONDS,
+								 temp,
+								 ODBC_INI);
 #ifdef	USE_LIBPQ
 	sprintf(temp, "%d", ci->prefer_libpq);
 	SQLWritePrivateProfileString(DSN,
@@ -155,6 +155,20 @@ extern "C" {
 #define INI_PREFERLIBPQ			"PreferLibpq"
 #define ABBR_PREFERLIBPQ		"D3"
 #define ABBR_XAOPT			"D4"
+#define INI_SPILLROWS			"SpillRows"
+#define ABBR_SPILLROWS			"D5"
+#define INI_SERVERSIDETIMEOUT		"ServerSideTimeout"
+#define ABBR_SERVERSIDETIMEOUT		"D6"
+#define INI_CATALOGCACHETTL		"CatalogCacheTTL"
+#define ABBR_CATALOGCACHETTL		"D7"
+#define INI_STREAMRESULTS		"StreamResults"
+#define ABBR_STREAMRESULTS		"D8"
+#define INI_TARGETSESSIONATTRS		"TargetSessionAttrs"
+#define ABBR_TARGETSESSIONATTRS		"D9"
+#define INI_LOADBALANCEHOSTS		"LoadBalanceHosts"
+#define ABBR_LOADBALANCEHOSTS		"DA"
+#define INI_HOSTRECHECKSECONDS		"HostRecheckSeconds"
+#define ABBR_HOSTRECHECKSECONDS		"DB"
 
 #define	SSLMODE_DISABLE		"disable"
 #define	SSLMODE_ALLOW		"allow"
@@ -168,6 +182,17 @@ extern "C" {
 #define	SSLLBYTE_REQUIRE	'r'
 #define	SSLLBYTE_VERIFY		'v'
 
+#define	TARGET_SESSION_ANY		"any"
+#define	TARGET_SESSION_READ_WRITE	"read-write"
+#define	TARGET_SESSION_READ_ONLY	"read-only"
+#define	TARGET_SESSION_PRIMARY		"primary"
+#define	TARGET_SESSION_STANDBY		"standby"
+#define	TARGET_SESSION_PREFER_STANDBY	"prefer-standby"
+
+#define	LOAD_BALANCE_HOSTS_DISABLE	0
+#define	LOAD_BALANCE_HOSTS_RANDOM	1
+#define	LOAD_BALANCE_HOSTS_LEAST_CONN	2
+
 #ifdef	_HANDLE_ENLIST_IN_DTC_
 #define INI_XAOPT			"XaOpt"
 #endif /* _HANDLE_ENLIST_IN_DTC_ */
@@ -250,6 +275,9 @@ extern "C" {
 #define DEFAULT_LOWERCASEIDENTIFIER	0
 #define DEFAULT_SSLMODE			SSLMODE_DISABLE
 #define DEFAULT_GSSAUTHUSEGSSAPI	0
+#define DEFAULT_TARGETSESSIONATTRS	TARGET_SESSION_ANY
+#define DEFAULT_LOADBALANCEHOSTS	LOAD_BALANCE_HOSTS_DISABLE
+#define DEFAULT_HOSTRECHECKSECONDS	10
 
 #ifdef	_HANDLE_ENLIST_IN_DTC_
 #define DEFAULT_XAOPT			1
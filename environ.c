@@ -19,6 +19,7 @@
 #include "connection.h"
 #include "dlg_specific.h"
 #include "statement.h"
+#include "qresult.h"
 #include <stdlib.h>
 #include <string.h>
 #include "pgapifunc.h"
@@ -29,16 +30,10 @@
 
 extern GLOBAL_VALUES globals;
 
-/* The one instance of the handles */
-static int conns_count = 0;
-static ConnectionClass **conns = NULL;
-
 #if defined(WIN_MULTITHREAD_SUPPORT)
-CRITICAL_SECTION	conns_cs;
 CRITICAL_SECTION	common_cs; /* commonly used for short term blocking */
 CRITICAL_SECTION	common_lcs; /* commonly used for not necessarily short term blocking */
 #elif defined(POSIX_MULTITHREAD_SUPPORT)
-pthread_mutex_t     conns_cs;
 pthread_mutex_t     common_cs;
 pthread_mutex_t     common_lcs;
 #endif /* WIN_MULTITHREAD_SUPPORT */
@@ -52,15 +47,6 @@ void	shortterm_common_unlock(void)
 	LEAVE_COMMON_CS;
 }
 
-int	getConnCount(void)
-{
-	return conns_count;
-}
-ConnectionClass * const *getConnList(void)
-{
-	return conns;
-}
-
 RETCODE		SQL_API
 PGAPI_AllocEnv(HENV FAR * phenv)
 {
@@ -553,7 +539,15 @@ EN_Constructor(void)
 	rv->errormsg = 0;
 	rv->errornumber = 0;
 	rv->flag = 0;
+	rv->catalog_cache = NULL;
+	rv->catalog_cache_count = 0;
+	rv->conns = NULL;
+	rv->num_conns = 0;
+	rv->failed_hosts = NULL;
 	INIT_ENV_CS(rv);
+	INIT_ENV_CONNS_CS(rv);
+	INIT_ENV_CATALOG_CS(rv);
+	INIT_ENV_HOSTS_CS(rv);
 cleanup:
 #ifdef WIN32
 	if (NULL == rv)
@@ -569,7 +563,7 @@ cleanup:
 char
 EN_Destructor(EnvironmentClass *self)
 {
-	int		lf, nullcnt;
+	ConnectionClass	*conn, *next;
 	char		rv = 1;
 
 	mylog("in EN_Destructor, self=%p\n", self);
@@ -582,28 +576,22 @@ EN_Destructor(EnvironmentClass *self)
 	 */
 
 	/* Free any connections belonging to this environment */
-	ENTER_CONNS_CS;
-	for (lf = 0, nullcnt = 0; lf < conns_count; lf++)
+	ENTER_ENV_CONNS_CS(self);
+	for (conn = self->conns; NULL != conn; conn = next)
 	{
-		if (NULL == conns[lf])
-			nullcnt++;
-		else if (conns[lf]->henv == self)
-		{
-			if (CC_Destructor(conns[lf]))
-				conns[lf] = NULL;
-			else
-				rv = 0;
-			nullcnt++;
-		}
-	}
-	if (conns && nullcnt >= conns_count)
-	{
-		mylog("clearing conns count=%d\n", conns_count);
-		free(conns);
-		conns = NULL;
-		conns_count = 0;
+		next = conn->env_next;
+		if (CC_Destructor(conn))
+			self->num_conns--;
+		else
+			rv = 0;
 	}
-	LEAVE_CONNS_CS;
+	self->conns = NULL;
+	LEAVE_ENV_CONNS_CS(self);
+	EN_flush_catalog_cache(self);
+	EN_set_host_failed(self, NULL, 0);
+	DELETE_ENV_HOSTS_CS(self);
+	DELETE_ENV_CATALOG_CS(self);
+	DELETE_ENV_CONNS_CS(self);
 	DELETE_ENV_CS(self);
 	free(self);
 
@@ -633,64 +621,75 @@ EN_get_error(EnvironmentClass *self, int *number, char **message)
 		return 0;
 }
 
-#define	INIT_CONN_COUNT	128
-
+/*
+ *	The connections of an environment are kept in a doubly linked list
+ *	through the connections themselves, so that adding and removing one
+ *	doesn't depend on the number of the others.
+ */
 char
 EN_add_connection(EnvironmentClass *self, ConnectionClass *conn)
 {
-	int	i, alloc;
-	ConnectionClass	**newa;
-	char	ret = FALSE;
-
 	mylog("EN_add_connection: self = %p, conn = %p\n", self, conn);
 
-	ENTER_CONNS_CS;
-	for (i = 0; i < conns_count; i++)
-	{
-		if (!conns[i])
-		{
-			conn->henv = self;
-			conns[i] = conn;
-			ret = TRUE;
-			mylog("       added at i=%d, conn->henv = %p, conns[i]->henv = %p\n", i, conn->henv, conns[i]->henv);
-			goto cleanup;
-		}
-	}
-	if (conns_count > 0)
-		alloc = 2 * conns_count;
-	else
-		alloc = INIT_CONN_COUNT;
-	if (newa = (ConnectionClass **) realloc(conns, alloc * sizeof(ConnectionClass *)), NULL == newa)
-		goto cleanup;
+	ENTER_ENV_CONNS_CS(self);
 	conn->henv = self;
-	newa[conns_count] = conn;
-	conns = newa;
-	ret = TRUE;
-	mylog("       added at %d, conn->henv = %p, conns[%d]->henv = %p\n", conns_count, conn->henv, conns_count, conns[conns_count]->henv);
-	for (i = conns_count + 1; i < alloc; i++)
-		conns[i] = NULL;
-	conns_count = alloc;
-cleanup:
-	LEAVE_CONNS_CS;
-	return ret;
+	conn->env_prev = NULL;
+	conn->env_next = self->conns;
+	if (self->conns)
+		self->conns->env_prev = conn;
+	self->conns = conn;
+	self->num_conns++;
+	LEAVE_ENV_CONNS_CS(self);
+
+	return TRUE;
 }
 
 
 char
 EN_remove_connection(EnvironmentClass *self, ConnectionClass *conn)
 {
-	int			i;
+	char	ret = FALSE;
 
-	for (i = 0; i < conns_count; i++)
-		if (conns[i] == conn && conns[i]->status != CONN_EXECUTING)
-		{
-			ENTER_CONNS_CS;
-			conns[i] = NULL;
-			LEAVE_CONNS_CS;
-			return TRUE;
-		}
+	ENTER_ENV_CONNS_CS(self);
+	if (conn->henv == self && conn->status != CONN_EXECUTING)
+	{
+		if (conn->env_prev)
+			conn->env_prev->env_next = conn->env_next;
+		else
+			self->conns = conn->env_next;
+		if (conn->env_next)
+			conn->env_next->env_prev = conn->env_prev;
+		conn->env_prev = conn->env_next = NULL;
+		self->num_conns--;
+		ret = TRUE;
+	}
+	LEAVE_ENV_CONNS_CS(self);
 
-	return FALSE;
+	return ret;
+}
+
+/*
+ *	Returns a malloc'ed copy of the environment's connection list, which
+ *	the caller can go through without holding the lock. NULL is returned
+ *	when there's no connection, or on allocation failure with *count > 0.
+ */
+ConnectionClass **
+EN_get_connections(EnvironmentClass *self, int *count)
+{
+	ConnectionClass	**list = NULL, *conn;
+	int		i = 0;
+
+	ENTER_ENV_CONNS_CS(self);
+	*count = self->num_conns;
+	if (self->num_conns > 0 &&
+	    NULL != (list = (ConnectionClass **) malloc(sizeof(ConnectionClass *) * self->num_conns)))
+	{
+		for (conn = self->conns; NULL != conn; conn = conn->env_next)
+			list[i++] = conn;
+	}
+	LEAVE_ENV_CONNS_CS(self);
+
+	return list;
 }
 
 
@@ -702,3 +701,237 @@ EN_log_error(const char *func, char *desc, EnvironmentClass *self)
 	else
 		qlog("INVALID ENVIRON HANDLE ERROR: func=%s, desc='%s'\n", func, desc);
 }
+
+
+static void
+free_catalog_cache_entry(CatalogCacheEntry *entry)
+{
+	free(entry->key);
+	QR_Destructor(entry->res);
+	free(entry);
+}
+
+/*
+ *	Look up the result of a catalog function in the cache of the
+ *	environment. The caller gets its own copy of the result, or NULL
+ *	if there's no valid entry for the key.
+ */
+QResultClass *
+EN_get_catalog_result(EnvironmentClass *self, const char *key)
+{
+	CatalogCacheEntry	*entry, *prev, *next;
+	QResultClass	*res = NULL;
+	time_t	now = time(NULL);
+
+	ENTER_ENV_CATALOG_CS(self);
+	for (entry = self->catalog_cache, prev = NULL; entry; entry = next)
+	{
+		next = entry->next;
+		if (entry->expires <= now)
+		{
+			if (prev)
+				prev->next = next;
+			else
+				self->catalog_cache = next;
+			self->catalog_cache_count--;
+			free_catalog_cache_entry(entry);
+			continue;
+		}
+		if (strcmp(entry->key, key) == 0)
+		{
+			res = QR_copy_manual(entry->res);
+			if (prev)
+			{
+				/* move it to the head */
+				prev->next = next;
+				entry->next = self->catalog_cache;
+				self->catalog_cache = entry;
+			}
+			break;
+		}
+		prev = entry;
+	}
+	LEAVE_ENV_CATALOG_CS(self);
+	mylog("%s: %s\n", __FUNCTION__, res ? "hit" : "miss");
+
+	return res;
+}
+
+/*
+ *	Remember a copy of the result of a catalog function for ttl seconds.
+ *	The least recently used entry is dropped when the cache is full.
+ */
+void
+EN_set_catalog_result(EnvironmentClass *self, const char *key, const QResultClass *res, int ttl)
+{
+	CatalogCacheEntry	*entry, **last;
+
+	if (ttl <= 0)
+		return;
+	if (entry = (CatalogCacheEntry *) malloc(sizeof(CatalogCacheEntry)), NULL == entry)
+		return;
+	entry->key = strdup(key);
+	entry->res = QR_copy_manual(res);
+	if (NULL == entry->key || NULL == entry->res)
+	{
+		if (entry->key)
+			free(entry->key);
+		if (entry->res)
+			QR_Destructor(entry->res);
+		free(entry);
+		return;
+	}
+	entry->expires = time(NULL) + ttl;
+
+	ENTER_ENV_CATALOG_CS(self);
+	/* replace the old entry for the key if any */
+	for (last = &self->catalog_cache; *last; last = &(*last)->next)
+	{
+		if (strcmp((*last)->key, key) == 0)
+		{
+			CatalogCacheEntry	*old = *last;
+
+			*last = old->next;
+			self->catalog_cache_count--;
+			free_catalog_cache_entry(old);
+			break;
+		}
+	}
+	entry->next = self->catalog_cache;
+	self->catalog_cache = entry;
+	if (++self->catalog_cache_count > CATALOG_CACHE_MAX_ENTRIES)
+	{
+		for (last = &self->catalog_cache; (*last)->next; last = &(*last)->next)
+			;
+		free_catalog_cache_entry(*last);
+		*last = NULL;
+		self->catalog_cache_count--;
+	}
+	LEAVE_ENV_CATALOG_CS(self);
+}
+
+/*
+ *	Forget all the cached catalog results, e.g. after DDL statements.
+ *	This is called with the connection's lock held, so it mustn't take
+ *	the environment's lock but only catalog_cs, which nests in any lock.
+ */
+void
+EN_flush_catalog_cache(EnvironmentClass *self)
+{
+	CatalogCacheEntry	*entry, *next;
+
+	if (!self)
+		return;
+	ENTER_ENV_CATALOG_CS(self);
+	entry = self->catalog_cache;
+	self->catalog_cache = NULL;
+	self->catalog_cache_count = 0;
+	LEAVE_ENV_CATALOG_CS(self);
+	if (entry)
+		mylog("%s: in\n", __FUNCTION__);
+	for (; entry; entry = next)
+	{
+		next = entry->next;
+		free_catalog_cache_entry(entry);
+	}
+}
+
+/*
+ *	Is the host (host:port) in its back-off period after a failed
+ *	connection attempt ? Expired entries are dropped on the way.
+ *	CC_connect() calls this with the connection's lock held, hence
+ *	the list has its own lock rather than the environment's.
+ */
+BOOL
+EN_is_host_failed(EnvironmentClass *self, const char *host)
+{
+	FailedHost	*fh, **last;
+	BOOL	ret = FALSE;
+	time_t	now = time(NULL);
+
+	if (!self)
+		return FALSE;
+	ENTER_ENV_HOSTS_CS(self);
+	for (last = &self->failed_hosts; NULL != (fh = *last); )
+	{
+		if (fh->retry_at <= now)
+		{
+			*last = fh->next;
+			free(fh->host);
+			free(fh);
+			continue;
+		}
+		if (strcmp(fh->host, host) == 0)
+			ret = TRUE;
+		last = &fh->next;
+	}
+	LEAVE_ENV_HOSTS_CS(self);
+
+	return ret;
+}
+
+/*
+ *	Remember that the host failed for secs seconds, or forget it if secs
+ *	is 0. A NULL host with secs 0 forgets all the hosts.
+ */
+void
+EN_set_host_failed(EnvironmentClass *self, const char *host, int secs)
+{
+	FailedHost	*fh, **last;
+
+	if (!self)
+		return;
+	ENTER_ENV_HOSTS_CS(self);
+	for (last = &self->failed_hosts; NULL != (fh = *last); )
+	{
+		if (NULL == host || strcmp(fh->host, host) == 0)
+		{
+			*last = fh->next;
+			free(fh->host);
+			free(fh);
+			continue;
+		}
+		last = &fh->next;
+	}
+	if (NULL != host && secs > 0 &&
+	    NULL != (fh = (FailedHost *) malloc(sizeof(FailedHost))))
+	{
+		if (NULL != (fh->host = strdup(host)))
+		{
+			mylog("%s: %s for %d seconds\n", __FUNCTION__, host, secs);
+			fh->retry_at = time(NULL) + secs;
+			fh->next = self->failed_hosts;
+			self->failed_hosts = fh;
+		}
+		else
+			free(fh);
+	}
+	LEAVE_ENV_HOSTS_CS(self);
+}
+
+/*
+ *	The number of connections of the environment which are connected to
+ *	the host and port.
+ */
+int
+EN_count_host_connections(EnvironmentClass *self, const char *host, const char *port)
+{
+	ConnectionClass	*conn;
+	int	count = 0;
+
+	if (!self)
+		return 0;
+	ENTER_ENV_CONNS_CS(self);
+	for (conn = self->conns; NULL != conn; conn = conn->env_next)
+	{
+		if (CONN_NOT_CONNECTED == conn->status ||
+		    CONN_DOWN == conn->status)
+			continue;
+		if (strcmp(conn->connect_host, host) == 0 &&
+		    strcmp(conn->connect_port, port) == 0)
+			count++;
+	}
+	LEAVE_ENV_CONNS_CS(self);
+
+	return count;
+}
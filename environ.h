@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #include "psqlodbc.h"
+#include <time.h>
 
 #if defined (POSIX_MULTITHREAD_SUPPORT)
 #include <pthread.h>
@@ -21,16 +22,47 @@ extern "C" {
 
 #define ENV_ALLOC_ERROR 1
 
+/*	A catalog function's result kept for the connections of an environment */
+typedef struct CatalogCacheEntry_ CatalogCacheEntry;
+struct CatalogCacheEntry_
+{
+	CatalogCacheEntry	*next;
+	char		*key;		/* connection settings, function and arguments */
+	time_t		expires;
+	QResultClass	*res;
+};
+#define	CATALOG_CACHE_MAX_ENTRIES	256
+
+/*	A host which failed to accept a connection, tried last until retry_at */
+typedef struct FailedHost_ FailedHost;
+struct FailedHost_
+{
+	FailedHost	*next;
+	char		*host;		/* host:port */
+	time_t		retry_at;
+};
+
 /**********		Environment Handle	*************/
 struct EnvironmentClass_
 {
 	char	   *errormsg;
 	int		errornumber;
 	Int4	flag;
+	CatalogCacheEntry	*catalog_cache;	/* most recently used first */
+	int		catalog_cache_count;
+	ConnectionClass	*conns;		/* linked by env_prev/env_next */
+	int		num_conns;
+	FailedHost	*failed_hosts;
 #if defined(WIN_MULTITHREAD_SUPPORT)
 	CRITICAL_SECTION	cs;
+	CRITICAL_SECTION	conns_cs;	/* short term lock for conns */
+	CRITICAL_SECTION	catalog_cs;	/* short term lock for catalog_cache */
+	CRITICAL_SECTION	hosts_cs;	/* short term lock for failed_hosts */
 #elif defined(POSIX_MULTITHREAD_SUPPORT)
 	pthread_mutex_t		cs;
+	pthread_mutex_t		conns_cs;	/* short term lock for conns */
+	pthread_mutex_t		catalog_cs;	/* short term lock for catalog_cache */
+	pthread_mutex_t		hosts_cs;	/* short term lock for failed_hosts */
 #endif /* WIN_MULTITHREAD_SUPPORT */
 };
 
@@ -40,9 +72,14 @@ char		EN_Destructor(EnvironmentClass *self);
 char		EN_get_error(EnvironmentClass *self, int *number, char **message);
 char		EN_add_connection(EnvironmentClass *self, ConnectionClass *conn);
 char		EN_remove_connection(EnvironmentClass *self, ConnectionClass *conn);
+ConnectionClass	**EN_get_connections(EnvironmentClass *self, int *count);
 void		EN_log_error(const char *func, char *desc, EnvironmentClass *self);
-int	getConnCount(void);
-ConnectionClass * const *getConnList(void);
+QResultClass	*EN_get_catalog_result(EnvironmentClass *self, const char *key);
+void		EN_set_catalog_result(EnvironmentClass *self, const char *key, const QResultClass *res, int ttl);
+void		EN_flush_catalog_cache(EnvironmentClass *self);
+BOOL		EN_is_host_failed(EnvironmentClass *self, const char *host);
+void		EN_set_host_failed(EnvironmentClass *self, const char *host, int secs);
+int		EN_count_host_connections(EnvironmentClass *self, const char *host, const char *port);
 
 #define	EN_OV_ODBC2	1L
 #define	EN_CONN_POOLING	(1L<<1)
@@ -56,10 +93,18 @@ ConnectionClass * const *getConnList(void);
 
 /* For Multi-thread */
 #if defined( WIN_MULTITHREAD_SUPPORT)
-#define	INIT_CONNS_CS	InitializeCriticalSection(&conns_cs)
-#define	ENTER_CONNS_CS	EnterCriticalSection(&conns_cs)
-#define	LEAVE_CONNS_CS	LeaveCriticalSection(&conns_cs)
-#define	DELETE_CONNS_CS	DeleteCriticalSection(&conns_cs)
+#define	INIT_ENV_CONNS_CS(x)	InitializeCriticalSection(&((x)->conns_cs))
+#define	ENTER_ENV_CONNS_CS(x)	EnterCriticalSection(&((x)->conns_cs))
+#define	LEAVE_ENV_CONNS_CS(x)	LeaveCriticalSection(&((x)->conns_cs))
+#define	DELETE_ENV_CONNS_CS(x)	DeleteCriticalSection(&((x)->conns_cs))
+#define	INIT_ENV_CATALOG_CS(x)	InitializeCriticalSection(&((x)->catalog_cs))
+#define	ENTER_ENV_CATALOG_CS(x)	EnterCriticalSection(&((x)->catalog_cs))
+#define	LEAVE_ENV_CATALOG_CS(x)	LeaveCriticalSection(&((x)->catalog_cs))
+#define	DELETE_ENV_CATALOG_CS(x)	DeleteCriticalSection(&((x)->catalog_cs))
+#define	INIT_ENV_HOSTS_CS(x)	InitializeCriticalSection(&((x)->hosts_cs))
+#define	ENTER_ENV_HOSTS_CS(x)	EnterCriticalSection(&((x)->hosts_cs))
+#define	LEAVE_ENV_HOSTS_CS(x)	LeaveCriticalSection(&((x)->hosts_cs))
+#define	DELETE_ENV_HOSTS_CS(x)	DeleteCriticalSection(&((x)->hosts_cs))
 #define INIT_ENV_CS(x)		InitializeCriticalSection(&((x)->cs))
 #define ENTER_ENV_CS(x)	EnterCriticalSection(&((x)->cs))
 #define LEAVE_ENV_CS(x)		LeaveCriticalSection(&((x)->cs))
@@ -69,10 +114,18 @@ ConnectionClass * const *getConnList(void);
 #define LEAVE_COMMON_CS		LeaveCriticalSection(&common_cs)
 #define DELETE_COMMON_CS	DeleteCriticalSection(&common_cs)
 #elif defined(POSIX_MULTITHREAD_SUPPORT)
-#define	INIT_CONNS_CS	pthread_mutex_init(&conns_cs,0)
-#define	ENTER_CONNS_CS	pthread_mutex_lock(&conns_cs)
-#define	LEAVE_CONNS_CS	pthread_mutex_unlock(&conns_cs)
-#define	DELETE_CONNS_CS	pthread_mutex_destroy(&conns_cs)
+#define	INIT_ENV_CONNS_CS(x)	pthread_mutex_init(&((x)->conns_cs),0)
+#define	ENTER_ENV_CONNS_CS(x)	pthread_mutex_lock(&((x)->conns_cs))
+#define	LEAVE_ENV_CONNS_CS(x)	pthread_mutex_unlock(&((x)->conns_cs))
+#define	DELETE_ENV_CONNS_CS(x)	pthread_mutex_destroy(&((x)->conns_cs))
+#define	INIT_ENV_CATALOG_CS(x)	pthread_mutex_init(&((x)->catalog_cs),0)
+#define	ENTER_ENV_CATALOG_CS(x)	pthread_mutex_lock(&((x)->catalog_cs))
+#define	LEAVE_ENV_CATALOG_CS(x)	pthread_mutex_unlock(&((x)->catalog_cs))
+#define	DELETE_ENV_CATALOG_CS(x)	pthread_mutex_destroy(&((x)->catalog_cs))
+#define	INIT_ENV_HOSTS_CS(x)	pthread_mutex_init(&((x)->hosts_cs),0)
+#define	ENTER_ENV_HOSTS_CS(x)	pthread_mutex_lock(&((x)->hosts_cs))
+#define	LEAVE_ENV_HOSTS_CS(x)	pthread_mutex_unlock(&((x)->hosts_cs))
+#define	DELETE_ENV_HOSTS_CS(x)	pthread_mutex_destroy(&((x)->hosts_cs))
 #define INIT_ENV_CS(x)		pthread_mutex_init(&((x)->cs),0)
 #define ENTER_ENV_CS(x)		pthread_mutex_lock(&((x)->cs))
 #define LEAVE_ENV_CS(x)		pthread_mutex_unlock(&((x)->cs))
@@ -82,10 +135,18 @@ ConnectionClass * const *getConnList(void);
 #define LEAVE_COMMON_CS		pthread_mutex_unlock(&common_cs)
 #define DELETE_COMMON_CS	pthread_mutex_destroy(&common_cs)
 #else
-#define	INIT_CONNS_CS
-#define	ENTER_CONNS_CS
-#define	LEAVE_CONNS_CS
-#define	DELETE_CONNS_CS
+#define	INIT_ENV_CONNS_CS(x)
+#define	ENTER_ENV_CONNS_CS(x)
+#define	LEAVE_ENV_CONNS_CS(x)
+#define	DELETE_ENV_CONNS_CS(x)
+#define	INIT_ENV_CATALOG_CS(x)
+#define	ENTER_ENV_CATALOG_CS(x)
+#define	LEAVE_ENV_CATALOG_CS(x)
+#define	DELETE_ENV_CATALOG_CS(x)
+#define	INIT_ENV_HOSTS_CS(x)
+#define	ENTER_ENV_HOSTS_CS(x)
+#define	LEAVE_ENV_HOSTS_CS(x)
+#define	DELETE_ENV_HOSTS_CS(x)
 #define INIT_ENV_CS(x)
 #define ENTER_ENV_CS(x)
 #define LEAVE_ENV_CS(x)
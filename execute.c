@@ -645,6 +645,7 @@ SetStatementSvp(StatementClass *stmt)
 	char	esavepoint[32], cmd[64];
 	ConnectionClass	*conn = SC_get_conn(stmt);
 	QResultClass *res;
+	BOOL	svp_ok;
 	RETCODE	ret = SQL_SUCCESS_WITH_INFO;
 
 	if (CC_is_in_error_trans(conn))
@@ -683,8 +684,18 @@ SetStatementSvp(StatementClass *stmt)
 		{
 			sprintf(esavepoint, "_EXEC_SVP_%p", stmt);
 			snprintf(cmd, sizeof(cmd), "SAVEPOINT %s", esavepoint);
-			res = CC_send_query(conn, cmd, NULL, 0, NULL);
-			if (QR_command_maybe_successful(res))
+			if (0 < conn->num_queued_cmds)
+			{
+				/* follow the implicit BEGIN queued by SC_execute() */
+				svp_ok = SendCommandRequest(stmt, cmd);
+			}
+			else
+			{
+				res = CC_send_query(conn, cmd, NULL, 0, NULL);
+				svp_ok = QR_command_maybe_successful(res);
+				QR_Destructor(res);
+			}
+			if (svp_ok)
 			{
 				SC_set_accessed_db(stmt);
 				SC_start_rbpoint(stmt);
@@ -695,7 +706,6 @@ SetStatementSvp(StatementClass *stmt)
 				SC_set_error(stmt, STMT_INTERNAL_ERROR, "internal SAVEPOINT failed", func);
 				ret = SQL_ERROR;
 			}
-			QR_Destructor(res);
 		}
 		else
 			SC_set_accessed_db(stmt);
@@ -1136,17 +1146,81 @@ PGAPI_Transact(HENV henv,
 	 */
 	if (hdbc == SQL_NULL_HDBC && henv != SQL_NULL_HENV)
 	{
-		ConnectionClass * const *conns = getConnList();
-		const int	conn_count = getConnCount();
+		EnvironmentClass *env = (EnvironmentClass *) henv;
+		ConnectionClass **conns;
+		int		conn_count, num_sent = 0;
+		RETCODE		ret = SQL_SUCCESS;
+
+		if (fType != SQL_COMMIT &&
+		    fType != SQL_ROLLBACK)
+		{
+			ENTER_ENV_CS(env);
+			env->errormsg = "PGAPI_Transact can only be called with SQL_COMMIT or SQL_ROLLBACK as parameter";
+			env->errornumber = CONN_INVALID_ARGUMENT_NO;
+			LEAVE_ENV_CS(env);
+			return SQL_ERROR;
+		}
+		/* the snapshot lets the connections be gone through unlocked */
+		if (conns = EN_get_connections(env, &conn_count), NULL == conns)
+		{
+			if (0 == conn_count)
+				return SQL_SUCCESS;
+			ENTER_ENV_CS(env);
+			env->errormsg = "Couldn't allocate memory for ending the transactions";
+			env->errornumber = ENV_ALLOC_ERROR;
+			LEAVE_ENV_CS(env);
+			return SQL_ERROR;
+		}
+
+		/*
+		 * Send COMMIT/ROLLBACK on all the connections first, and only
+		 * then collect the replies, so that it takes one round trip
+		 * instead of one per connection. A failure is reported on the
+		 * connection it happened on and doesn't stop the others.
+		 */
 		for (lf = 0; lf < conn_count; lf++)
 		{
 			conn = conns[lf];
-
-			if (conn && CC_get_env(conn) == henv)
-				if (PGAPI_Transact(henv, (HDBC) conn, fType) != SQL_SUCCESS)
-					return SQL_ERROR;
+			ENTER_CONN_CS(conn);
+			CC_clear_error(conn);
+			if (CC_loves_visible_trans(conn) && CC_is_in_trans(conn))
+			{
+				mylog("%s: sending on conn %p '%d'\n", func, conn, fType);
+				switch (CC_send_end_tran(conn, SQL_COMMIT == fType))
+				{
+					case 1:
+						conns[num_sent++] = conn;
+						continue; /* keep the conn CS until the reply comes */
+					case -1:
+						CC_on_abort(conn, NO_TRANS);
+						CC_log_error(func, "", conn);
+						ret = SQL_ERROR;
+						break;
+				}
+			}
+			LEAVE_CONN_CS(conn);
 		}
-		return SQL_SUCCESS;
+		for (lf = 0; lf < num_sent; lf++)
+		{
+			conn = conns[lf];
+			if (!CC_receive_end_tran(conn))
+			{
+				/* error msg will be in the connection */
+				CC_on_abort(conn, NO_TRANS);
+				CC_log_error(func, "", conn);
+				ret = SQL_ERROR;
+			}
+			LEAVE_CONN_CS(conn);
+		}
+		free(conns);
+		if (SQL_ERROR == ret)
+		{
+			ENTER_ENV_CS(env);
+			env->errormsg = "Could not end the transaction on some connections";
+			env->errornumber = CONN_EXEC_ERROR;
+			LEAVE_ENV_CS(env);
+		}
+		return ret;
 	}
 
 	conn = (ConnectionClass *) hdbc;
@@ -1362,10 +1436,16 @@ PGAPI_ParamData(HSTMT hstmt,
 		goto cleanup;
 	}
 
-	/* close the large object */
+	/* close the large object, writing out the buffered data */
 	if (estmt->lobj_fd >= 0)
 	{
-		odbc_lo_close(conn, estmt->lobj_fd);
+		if (odbc_lo_close_buffered(conn, estmt->lobj_fd, &estmt->lobj_buf) < 0)
+		{
+			estmt->lobj_fd = -1;
+			SC_set_error(stmt, STMT_EXEC_ERROR, "Couldn't write the large object.", func);
+			retval = SQL_ERROR;
+			goto cleanup;
+		}
 
 		/* commit transaction if needed */
 		if (!CC_cursor_count(conn) && CC_does_autocommit(conn))
@@ -1459,6 +1539,29 @@ cleanup:
 }
 
 
+/*
+ *	The total length the application declared with SQL_LEN_DATA_AT_EXEC(),
+ *	or -1 when it's unknown.
+ */
+static SQLLEN
+declared_exec_length(const StatementClass *stmt, const ParameterInfoClass *param)
+{
+	const APDFields	*apdopts = SC_get_APDF(stmt);
+	SQLULEN		offset = apdopts->param_offset_ptr ? *apdopts->param_offset_ptr : 0;
+	SQLLEN		current_row = stmt->exec_current_row < 0 ? 0 : stmt->exec_current_row;
+	SQLLEN		*pcVal = param->used;
+
+	if (!pcVal)
+		return -1;
+	if (apdopts->param_bind_type > 0)
+		pcVal = LENADDR_SHIFT(pcVal, offset + apdopts->param_bind_type * current_row);
+	else
+		pcVal = LENADDR_SHIFT(pcVal, offset) + current_row;
+	if (*pcVal <= SQL_LEN_DATA_AT_EXEC_OFFSET)
+		return SQL_LEN_DATA_AT_EXEC_OFFSET - *pcVal;
+	return -1;
+}
+
 /*
  *	Supplies parameter data at execution time.
  *	Used in conjunction with SQLParamData.
@@ -1481,7 +1584,8 @@ PGAPI_PutData(HSTMT hstmt,
 	PutDataClass	*current_pdata;
 	char	   *buffer, *putbuf, *allocbuf = NULL;
 	Int2		ctype;
-	SQLLEN		putlen;
+	SQLLEN		putlen, declared;
+	Int4		written;
 	BOOL		lenset = FALSE, handling_lo = FALSE;
 
 	mylog("%s: entering...\n", func);
@@ -1549,6 +1653,7 @@ PGAPI_PutData(HSTMT hstmt,
 			putlen = ctype_length(ctype);
 	}
 	putbuf = rgbValue;
+	declared = declared_exec_length(estmt, current_param);
 	handling_lo = (PIC_dsp_pgtype(conn, *current_iparam) == conn->lobj_type);
 	if (handling_lo && SQL_C_CHAR == ctype)
 	{
@@ -1622,12 +1727,27 @@ PGAPI_PutData(HSTMT hstmt,
 				goto cleanup;
 			}
 
-			retval = odbc_lo_write(conn, estmt->lobj_fd, putbuf, (Int4) putlen);
-			mylog("lo_write: cbValue=%d, wrote %d bytes\n", putlen, retval);
+			written = odbc_lo_write_buffered(conn, estmt->lobj_fd, &estmt->lobj_buf, putbuf, (Int4) putlen);
+			mylog("lo_write: cbValue=%d, wrote %d bytes\n", putlen, written);
+			if (written < 0)
+			{
+				SC_set_error(stmt, STMT_EXEC_ERROR, "Couldn't write the large object.", func);
+				retval = SQL_ERROR;
+				goto cleanup;
+			}
 		}
 		else
 		{
-			current_pdata->EXEC_buffer = malloc(putlen + 1);
+			/*
+			 * Allocate the whole declared length at once so that
+			 * the following calls don't have to move the data.
+			 */
+			buffer = NULL;
+			if (declared > putlen)
+				buffer = malloc(declared + 1);
+			if (!buffer)
+				buffer = malloc(putlen + 1);
+			current_pdata->EXEC_buffer = buffer;
 			if (!current_pdata->EXEC_buffer)
 			{
 				SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Out of memory in PGAPI_PutData (2)", func);
@@ -1647,8 +1767,14 @@ PGAPI_PutData(HSTMT hstmt,
 		if (handling_lo)
 		{
 			/* the large object fd is in EXEC_buffer */
-			retval = odbc_lo_write(conn, estmt->lobj_fd, putbuf, (Int4) putlen);
-			mylog("lo_write(2): cbValue = %d, wrote %d bytes\n", putlen, retval);
+			written = odbc_lo_write_buffered(conn, estmt->lobj_fd, &estmt->lobj_buf, putbuf, (Int4) putlen);
+			mylog("lo_write(2): cbValue = %d, wrote %d bytes\n", putlen, written);
+			if (written < 0)
+			{
+				SC_set_error(stmt, STMT_EXEC_ERROR, "Couldn't write the large object.", func);
+				retval = SQL_ERROR;
+				goto cleanup;
+			}
 
 			*current_pdata->EXEC_used += putlen;
 		}
@@ -1659,7 +1785,10 @@ PGAPI_PutData(HSTMT hstmt,
 			if (putlen > 0)
 			{
 				SQLLEN	used = *current_pdata->EXEC_used + putlen, allocsize;
-				for (allocsize = (1 << 4); allocsize <= used; allocsize <<= 1) ;
+				if (declared >= used)
+					allocsize = declared + 1;
+				else
+					for (allocsize = (1 << 4); allocsize <= used; allocsize <<= 1) ;
 				mylog("        cbValue = %d, old_pos = %d, *used = %d\n", putlen, old_pos, used);
 
 				/* dont lose the old pointer in case out of memory */
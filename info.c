@@ -24,6 +24,7 @@
 #ifndef WIN32
 #include <ctype.h>
 #endif
+#include <stdarg.h>
 
 #include "tuple.h"
 #include "pgtypes.h"
@@ -714,7 +715,10 @@ mylog("CONVERT_FUNCTIONS=" FORMAT_ULEN "\n", value);
 				| SQL_CA1_POS_REFRESH;
 			if (0 != (ci->updatable_cursors & ALLOW_KEYSET_DRIVEN_CURSORS))
 				value |= (SQL_CA1_POS_UPDATE | SQL_CA1_POS_DELETE
-				| SQL_CA1_BULK_ADD
+				);
+			if (0 != (ci->updatable_cursors & ALLOW_KEYSET_DRIVEN_CURSORS) &&
+			    0 != (ci->updatable_cursors & ALLOW_BULK_OPERATIONS))
+				value |= (SQL_CA1_BULK_ADD
 				| SQL_CA1_BULK_UPDATE_BY_BOOKMARK
 				| SQL_CA1_BULK_DELETE_BY_BOOKMARK
 				| SQL_CA1_BULK_FETCH_BY_BOOKMARK
@@ -1655,6 +1659,127 @@ allow_public_schema(ConnectionClass *conn, const SQLCHAR *szSchemaName, SQLSMALL
 			stricmp(CC_get_current_schema(conn), (char *) pubstr) == 0);
 }
 
+/*
+ *	Make the key of a catalog function's result in the cache of the
+ *	environment from the server, database and user connected to, the
+ *	current schema, the options which change the results, the function
+ *	name, its options and nargs pairs of (const SQLCHAR *, SQLSMALLINT)
+ *	arguments. NULL is returned when the cache can't be used.
+ */
+static char *
+catalog_cache_key(const StatementClass *stmt, const char *func, UInt4 flag, OID reloid, Int4 attnum, int nargs, ...)
+{
+	ConnectionClass	*conn = SC_get_conn(stmt);
+	const ConnInfo	*ci = &conn->connInfo;
+	const char	*schema;
+	char	*key, *newkey;
+	size_t	keylen, alloc;
+	va_list	args;
+	int	i;
+
+	if (ci->catalog_cache_ttl <= 0 ||
+	    conn->catalog_modified)
+		return NULL;
+	/* the unqualified names are looked up in it */
+	if (schema = CC_get_current_schema(conn), NULL == schema)
+		schema = "";
+	alloc = strlen(conn->connect_host) + strlen(conn->connect_port)
+		+ strlen(ci->database) + strlen(ci->username) + strlen(schema)
+		+ strlen(ci->drivers.extra_systable_prefixes)
+		+ strlen(func) + 256;
+	if (key = malloc(alloc), NULL == key)
+		return NULL;
+	snprintf(key, alloc, "%s\n%s\n%s\n%s\n%s\n"
+		"%s,%s,%s,%s,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\n"
+		"%d\n%s\n%u,%u,%d",
+		conn->connect_host, conn->connect_port,
+		ci->database, ci->username, schema,
+		ci->show_system_tables, ci->show_oid_column,
+		ci->fake_oid_index, ci->row_versioning,
+		ci->drivers.extra_systable_prefixes,
+		ci->updatable_cursors, ci->bytea_as_longvarbinary,
+		ci->int8_as, ci->lower_case_identifier,
+		ci->drivers.unique_index, ci->drivers.lie,
+		ci->drivers.use_declarefetch,
+		ci->drivers.unknown_sizes, ci->drivers.max_varchar_size,
+		ci->drivers.max_longvarchar_size,
+		ci->drivers.text_as_longvarchar,
+		ci->drivers.unknowns_as_longvarchar,
+		ci->drivers.bools_as_char,
+		conn->unicode, func, flag, reloid, attnum);
+	keylen = strlen(key);
+	va_start(args, nargs);
+	for (i = 0; i < nargs; i++)
+	{
+		const SQLCHAR	*str = va_arg(args, const SQLCHAR *);
+		int	len = va_arg(args, int);
+
+		if (NULL == str)
+			len = -1;
+		else if (SQL_NTS == len)
+			len = (int) strlen((const char *) str);
+		else if (len < 0)
+			len = 0;
+		if (newkey = realloc(key, keylen + len + 16), NULL == newkey)
+		{
+			free(key);
+			key = NULL;
+			break;
+		}
+		key = newkey;
+		keylen += sprintf(key + keylen, "\n%d:", len);
+		if (len > 0)
+		{
+			memcpy(key + keylen, str, len);
+			keylen += len;
+			key[keylen] = '\0';
+		}
+	}
+	va_end(args);
+
+	return key;
+}
+
+/*
+ *	Use the cached result of a catalog function, if any.
+ */
+static BOOL
+use_cached_catalog_result(StatementClass *stmt, const char *key, RETCODE *ret)
+{
+	QResultClass	*res;
+
+	if (NULL == key)
+		return FALSE;
+	if (res = EN_get_catalog_result(CC_get_env(SC_get_conn(stmt)), key), NULL == res)
+		return FALSE;
+	SC_set_Result(stmt, res);
+	extend_column_bindings(SC_get_ARDF(stmt), QR_NumResultCols(res));
+	stmt->catalog_result = TRUE;
+	stmt->status = STMT_FINISHED;
+	stmt->currTuple = -1;
+	SC_set_rowset_start(stmt, -1, FALSE);
+	SC_set_current_col(stmt, -1);
+
+	*ret = SQL_SUCCESS;
+	if (stmt->internal)
+		*ret = DiscardStatementSvp(stmt, *ret, FALSE);
+	return TRUE;
+}
+
+/*
+ *	Keep a successful result of a catalog function in the cache.
+ */
+static void
+cache_catalog_result(StatementClass *stmt, const char *key, RETCODE ret)
+{
+	ConnectionClass	*conn = SC_get_conn(stmt);
+	QResultClass	*res = SC_get_Result(stmt);
+
+	if (NULL == key || SQL_SUCCESS != ret || NULL == res)
+		return;
+	EN_set_catalog_result(CC_get_env(conn), key, res, conn->connInfo.catalog_cache_ttl);
+}
+
 RETCODE		SQL_API
 PGAPI_Tables(HSTMT hstmt,
 			 const SQLCHAR FAR * szTableQualifier, /* PV X*/
@@ -1705,6 +1830,7 @@ PGAPI_Tables(HSTMT hstmt,
 	BOOL		list_cat = FALSE, list_schemas = FALSE, list_table_types = FALSE, list_some = FALSE;
 	SQLLEN		cbRelname, cbRelkind, cbSchName;
 	EnvironmentClass *env;
+	char		*cache_key;
 
 	mylog("%s: entering...stmt=%p scnm=%p len=%d\n", func, stmt, szTableOwner, cbTableOwner);
 
@@ -1714,11 +1840,23 @@ PGAPI_Tables(HSTMT hstmt,
 	conn = SC_get_conn(stmt);
 	ci = &(conn->connInfo);
 	env = CC_get_env(conn);
+	cache_key = catalog_cache_key(stmt, func, flag, 0, 0, 4,
+			szTableQualifier, cbTableQualifier,
+			szTableOwner, cbTableOwner,
+			szTableName, cbTableName,
+			szTableType, cbTableType);
+	if (use_cached_catalog_result(stmt, cache_key, &ret))
+	{
+		free(cache_key);
+		return ret;
+	}
 
 	result = PGAPI_AllocStmt(conn, &htbl_stmt, 0);
 	if (!SQL_SUCCEEDED(result))
 	{
 		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Couldn't allocate statement for PGAPI_Tables result.", func);
+		if (cache_key)
+			free(cache_key);
 		return SQL_ERROR;
 	}
 	tbl_stmt = (StatementClass *) htbl_stmt;
@@ -2075,6 +2213,9 @@ cleanup:
 	if (htbl_stmt)
 		PGAPI_FreeStmt(htbl_stmt, SQL_DROP);
 
+	cache_catalog_result(stmt, cache_key, ret);
+	if (cache_key)
+		free(cache_key);
 	if (stmt->internal)
 		ret = DiscardStatementSvp(stmt, ret, FALSE);
 	mylog("%s: EXIT, stmt=%p, ret=%d\n", func, stmt, ret);
@@ -2097,37 +2238,37 @@ PGAPI_Columns(HSTMT hstmt,
 {
 	CSTR func = "PGAPI_Columns";
 	StatementClass *stmt = (StatementClass *) hstmt;
-	QResultClass	*res;
-	TupleField	*tuple;
-	HSTMT		hcol_stmt = NULL;
-	StatementClass *col_stmt;
+	QResultClass	*res, *colres = NULL;
+	TupleField	*tuple, *coltuple;
 	char		columns_query[INFO_INQUIRY_LEN];
 	RETCODE		result;
-	char		table_owner[MAX_INFO_STRING],
-				table_name[MAX_INFO_STRING],
-				field_name[MAX_INFO_STRING],
-				field_type_name[MAX_INFO_STRING];
+	const char	*table_owner = NULL,
+				*table_name = NULL,
+				*field_name,
+				*field_type_name,
+				*not_null,
+				*attdef;
 	Int2		field_number, sqltype, concise_type,
 				result_cols;
 	Int4		mod_length,
 				ordinal,
-				typmod, relhasoids;
-	OID		field_type, the_type, greloid, basetype;
+				typmod;
+	OID		field_type, the_type, greloid = 0, basetype;
+	SQLLEN		num_rows, row;
 #ifdef	USE_OLD_IMPL
 	Int2		decimal_digits;
 	Int4		field_length, column_size;
 	char		useStaticPrecision, useStaticScale;
 #endif /* USE_OLD_IMPL */
-	char		not_null[MAX_INFO_STRING],
-				relhasrules[MAX_INFO_STRING], relkind[8];
 	char	*escSchemaName = NULL, *escTableName = NULL, *escColumnName = NULL;
-	BOOL	search_pattern = TRUE, search_by_ids, relisaview;
+	BOOL	search_pattern = TRUE, search_by_ids, relisaview = FALSE, relhasoids = FALSE;
 	ConnInfo   *ci;
 	ConnectionClass *conn;
-	SQLSMALLINT	internal_asis_type = SQL_C_CHAR, cbSchemaName;
+	SQLSMALLINT	cbSchemaName;
 	const char	*like_or_eq = likeop, *op_string;
 	const SQLCHAR *szSchemaName;
 	BOOL	setIdentity = FALSE;
+	char		*cache_key;
 
 	mylog("%s: entering...stmt=%p scnm=%p len=%d\n", func, stmt, szTableOwner, cbTableOwner);
 
@@ -2136,10 +2277,16 @@ PGAPI_Columns(HSTMT hstmt,
 
 	conn = SC_get_conn(stmt);
 	ci = &(conn->connInfo);
-#ifdef	UNICODE_SUPPORT
-	if (CC_is_in_unicode_driver(conn))
-		internal_asis_type = INTERNAL_ASIS_TYPE;
-#endif /* UNICODE_SUPPORT */
+	cache_key = catalog_cache_key(stmt, func, flag, reloid, attnum, 4,
+			szTableQualifier, cbTableQualifier,
+			szTableOwner, cbTableOwner,
+			szTableName, cbTableName,
+			szColumnName, cbColumnName);
+	if (use_cached_catalog_result(stmt, cache_key, &result))
+	{
+		free(cache_key);
+		return result;
+	}
 
 #define	return	DONT_CALL_RETURN_FROM_HERE???
 	search_by_ids = ((flag & PODBC_SEARCH_BY_IDS) != 0);
@@ -2219,166 +2366,39 @@ retry_public_schema:
 		" on a.atthasdef and d.adrelid = a.attrelid and d.adnum = a.attnum");
 	strcat(columns_query, " order by n.nspname, c.relname, attnum");
 
-	result = PGAPI_AllocStmt(conn, &hcol_stmt, 0);
-	if (!SQL_SUCCEEDED(result))
+	/*
+	 * The rows are read straight out of the result of the query, instead
+	 * of binding and fetching them on an internal statement. So don't let
+	 * the tuples be packed or spilled, and then the values which are
+	 * returned verbatim can be moved into the result of this function.
+	 */
+	if (colres = CC_send_query(conn, columns_query, NULL, IGNORE_ABORT_ON_CONN, stmt), !QR_command_maybe_successful(colres))
 	{
-		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Couldn't allocate statement for PGAPI_Columns result.", func);
+		SC_set_error(stmt, STMT_EXEC_ERROR, "PGAPI_Columns query error", func);
 		result = SQL_ERROR;
 		goto cleanup;
 	}
-	col_stmt = (StatementClass *) hcol_stmt;
-
-	mylog("%s: hcol_stmt = %p, col_stmt = %p\n", func, hcol_stmt, col_stmt);
-
-	col_stmt->internal = TRUE;
-	result = PGAPI_ExecDirect(hcol_stmt, (SQLCHAR *) columns_query, SQL_NTS, 0);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_full_error_copy(stmt, col_stmt, FALSE);
-		goto cleanup;
-	}
+	num_rows = QR_get_num_cached_tuples(colres);
 
 	/* If not found */
 	if ((flag & PODBC_SEARCH_PUBLIC_SCHEMA) != 0 &&
-	    (res = SC_get_Result(col_stmt)) &&
-	    0 == QR_get_num_total_tuples(res))
+	    0 == num_rows)
 	{
 		if (!search_by_ids &&
 		    allow_public_schema(conn, szSchemaName, cbSchemaName))
 		{
-			PGAPI_FreeStmt(hcol_stmt, SQL_DROP);
-			hcol_stmt = NULL;
+			QR_Destructor(colres);
+			colres = NULL;
 			szSchemaName = pubstr;
 			cbSchemaName = SQL_NTS;
 			goto retry_public_schema;
 		}
 	}
 
-	result = PGAPI_BindCol(hcol_stmt, 1, internal_asis_type,
-						   table_owner, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 2, internal_asis_type,
-						   table_name, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 3, internal_asis_type,
-						   field_name, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 4, SQL_C_ULONG,
-						   &field_type, 4, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 5, internal_asis_type,
-						   field_type_name, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 6, SQL_C_SHORT,
-						   &field_number, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-#ifdef	NOT_USED
-	result = PGAPI_BindCol(hcol_stmt, 7, SQL_C_LONG,
-						   &field_length, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-#endif /* NOT_USED */
-
-	result = PGAPI_BindCol(hcol_stmt, 8, SQL_C_LONG,
-						   &mod_length, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 9, internal_asis_type,
-						   not_null, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 10, internal_asis_type,
-						   relhasrules, MAX_INFO_STRING, NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 11, internal_asis_type,
-						   relkind, sizeof(relkind), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 12, SQL_C_LONG,
-					&greloid, sizeof(greloid), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 14, SQL_C_ULONG,
-					&basetype, sizeof(basetype), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 15, SQL_C_LONG,
-					&typmod, sizeof(typmod), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	result = PGAPI_BindCol(hcol_stmt, 16, SQL_C_LONG,
-					&relhasoids, sizeof(relhasoids), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
 	if (res = QR_Constructor(), !res)
 	{
 		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Couldn't allocate memory for PGAPI_Columns result.", func);
+		result = SQL_ERROR;
 		goto cleanup;
 	}
 	SC_set_Result(stmt, res);
@@ -2428,16 +2448,21 @@ retry_public_schema:
 	QR_set_field_info_v(res, COLUMNS_ATTTYPMOD, "TYPMOD", PG_TYPE_INT4, 4);
 
 	ordinal = 1;
-	result = PGAPI_Fetch(hcol_stmt);
+	if (num_rows > 0)
+	{
+		table_owner = QR_get_value_backend_text(colres, 0, 0);
+		table_name = QR_get_value_backend_text(colres, 0, 1);
+		greloid = (OID) strtoul(QR_get_value_backend_text(colres, 0, 11), NULL, 10);
+		relisaview = (strcmp(QR_get_value_backend_text(colres, 0, 10), "v") == 0);
+		relhasoids = (strcmp(QR_get_value_backend_text(colres, 0, 15), "t") == 0);
+	}
 
 	/*
 	 * Only show oid if option AND there are other columns AND it's not
 	 * being called by SQLStatistics . Always show OID if it's a system
 	 * table
 	 */
-	relisaview = (relkind[0] == 'v');
-
-	if (result != SQL_ERROR && !stmt->internal)
+	if (num_rows > 0 && !stmt->internal)
 	{
 		if (!relisaview &&
 			relhasoids &&
@@ -2487,30 +2512,31 @@ retry_public_schema:
 		}
 	}
 
-	while (SQL_SUCCEEDED(result))
+	for (row = 0; row < num_rows; row++)
 	{
 		int	auto_unique;
-		SQLLEN	len_needed;
-		char	*attdef;
 
-		attdef = NULL;
-		PGAPI_SetPos(hcol_stmt, 1, SQL_POSITION, 0);
-		PGAPI_GetData(hcol_stmt, 13, internal_asis_type, NULL, 0, &len_needed);
-		if (len_needed > 0)
-		{
-mylog("len_needed=%d\n", len_needed);
-			attdef = malloc(len_needed + 1);
-			PGAPI_GetData(hcol_stmt, 13, internal_asis_type, attdef, len_needed + 1, &len_needed);
-mylog(" and the data=%s\n", attdef);
-		}
+		coltuple = colres->backend_tuples + row * colres->num_fields;
+		field_name = coltuple[2].value;
+		field_type = (OID) strtoul(coltuple[3].value, NULL, 10);
+		field_type_name = coltuple[4].value;
+		field_number = (Int2) atoi(coltuple[5].value);
+		mod_length = atoi(coltuple[7].value);
+		not_null = coltuple[8].value;
+		greloid = (OID) strtoul(coltuple[11].value, NULL, 10);
+		attdef = coltuple[12].value;
+		basetype = (OID) strtoul(coltuple[13].value, NULL, 10);
+		typmod = atoi(coltuple[14].value);
 		tuple = QR_AddNew(res);
 
 		sqltype = SQL_TYPE_NULL;	/* unspecified */
 		set_tuplefield_string(&tuple[COLUMNS_CATALOG_NAME], CurrCat(conn));
 		/* see note in SQLTables() */
-		set_tuplefield_string(&tuple[COLUMNS_SCHEMA_NAME], GET_SCHEMA_NAME(table_owner));
-		set_tuplefield_string(&tuple[COLUMNS_TABLE_NAME], table_name);
-		set_tuplefield_string(&tuple[COLUMNS_COLUMN_NAME], field_name);
+		move_tuplefield(&tuple[COLUMNS_SCHEMA_NAME], &coltuple[0]);
+		table_owner = tuple[COLUMNS_SCHEMA_NAME].value;
+		move_tuplefield(&tuple[COLUMNS_TABLE_NAME], &coltuple[1]);
+		table_name = tuple[COLUMNS_TABLE_NAME].value;
+		move_tuplefield(&tuple[COLUMNS_COLUMN_NAME], &coltuple[2]);
 		auto_unique = SQL_FALSE;
 		if (field_type = pg_true_type(conn, field_type, basetype), field_type == basetype)
 			mod_length = typmod;
@@ -2526,7 +2552,7 @@ mylog(" and the data=%s\n", attdef);
 			case PG_TYPE_INT4:
 			case PG_TYPE_INT8:
 				if (attdef && strnicmp(attdef, "nextval(", 8) == 0 &&
-				    not_null[0] != '0')
+				    't' == not_null[0])
 				{
 					auto_unique = SQL_TRUE;
 					if (!setIdentity &&
@@ -2540,7 +2566,7 @@ mylog(" and the data=%s\n", attdef);
 					}
 				}
 			default:
-				set_tuplefield_string(&tuple[COLUMNS_TYPE_NAME], field_type_name);
+				move_tuplefield(&tuple[COLUMNS_TYPE_NAME], &coltuple[4]);
 				break;
 		}
 
@@ -2676,12 +2702,12 @@ mylog(" and the data=%s\n", attdef);
 		set_tuplefield_int2(&tuple[COLUMNS_DATA_TYPE], sqltype);
 
 		set_nullfield_int2(&tuple[COLUMNS_RADIX], pgtype_radix(conn, field_type));
-		set_tuplefield_int2(&tuple[COLUMNS_NULLABLE], (Int2) (not_null[0] != '0' ? SQL_NO_NULLS : pgtype_nullable(conn, field_type)));
+		set_tuplefield_int2(&tuple[COLUMNS_NULLABLE], (Int2) ('t' == not_null[0] ? SQL_NO_NULLS : pgtype_nullable(conn, field_type)));
 		set_tuplefield_string(&tuple[COLUMNS_REMARKS], NULL_STRING);
 		if (attdef && strlen(attdef) > INFO_VARCHAR_SIZE)
 			set_tuplefield_string(&tuple[COLUMNS_COLUMN_DEF], "TRUNCATE");
 		else
-			set_tuplefield_string(&tuple[COLUMNS_COLUMN_DEF], attdef);
+			move_tuplefield(&tuple[COLUMNS_COLUMN_DEF], &coltuple[12]);
 		set_tuplefield_int2(&tuple[COLUMNS_SQL_DATA_TYPE], concise_type);
 		set_nullfield_int2(&tuple[COLUMNS_SQL_DATETIME_SUB], pgtype_attr_to_datetime_sub(conn, field_type, mod_length));
 		set_tuplefield_int4(&tuple[COLUMNS_CHAR_OCTET_LENGTH], pgtype_attr_transfer_octet_length(conn, field_type, mod_length, UNKNOWNS_AS_DEFAULT));
@@ -2694,22 +2720,13 @@ mylog(" and the data=%s\n", attdef);
 		set_tuplefield_int4(&tuple[COLUMNS_BASE_TYPEID], basetype);
 		set_tuplefield_int4(&tuple[COLUMNS_ATTTYPMOD], mod_length);
 		ordinal++;
-
-		result = PGAPI_Fetch(hcol_stmt);
-		if (attdef)
-			free(attdef);
-	}
-	if (result != SQL_NO_DATA_FOUND)
-	{
-		SC_full_error_copy(stmt, col_stmt, FALSE);
-		goto cleanup;
 	}
 
 	/*
 	 * Put the row version column at the end so it might not be mistaken
 	 * for a key field.
 	 */
-	if (!relisaview && !stmt->internal && atoi(ci->row_versioning))
+	if (num_rows > 0 && !relisaview && !stmt->internal && atoi(ci->row_versioning))
 	{
 		/* For Row Versioning fields */
 		the_type = PG_TYPE_INT4;
@@ -2766,8 +2783,11 @@ cleanup:
 		free(escTableName);
 	if (escColumnName)
 		free(escColumnName);
-	if (hcol_stmt)
-		PGAPI_FreeStmt(hcol_stmt, SQL_DROP);
+	if (colres)
+		QR_Destructor(colres);
+	cache_catalog_result(stmt, cache_key, result);
+	if (cache_key)
+		free(cache_key);
 	if (stmt->internal)
 		result = DiscardStatementSvp(stmt, result, FALSE);
 	mylog("%s: EXIT,  stmt=%p\n", func, stmt);
@@ -3023,37 +3043,28 @@ PGAPI_Statistics(HSTMT hstmt,
 	ConnectionClass *conn;
 	QResultClass	*res;
 	char		index_query[INFO_INQUIRY_LEN];
-	HSTMT		hcol_stmt = NULL, hindx_stmt = NULL;
+	HSTMT		hindx_stmt = NULL;
 	RETCODE		ret = SQL_ERROR, result;
 	char		*escSchemaName = NULL, *table_name = NULL, *escTableName = NULL;
 	char		index_name[MAX_INFO_STRING];
-	short		fields_vector[INDEX_KEYS_STORAGE_COUNT + 1];
-	short		indopt_vector[INDEX_KEYS_STORAGE_COUNT + 1];
 	char		isunique[10],
 				isclustered[10],
 				ishash[MAX_INFO_STRING];
-	SQLLEN		index_name_len, fields_vector_len;
+	SQLLEN		index_name_len, column_name_len;
 	TupleField	*tuple;
 	int			i;
-	StatementClass *col_stmt,
-			   *indx_stmt;
-	char		column_name[MAX_INFO_STRING],
+	StatementClass *indx_stmt;
+	char		column_name[INFO_INQUIRY_LEN],
 			table_schemaname[MAX_INFO_STRING],
 				relhasrules[10];
-	struct columns_idx {
-		int	pnum;
-		char	*col_name;
-	} *column_names = NULL;
-	/* char	  **column_names = NULL; */
-	SQLLEN		column_name_len;
-	int		total_columns = 0, alcount;
 	ConnInfo   *ci;
 	char		buf[256];
-	SQLSMALLINT	internal_asis_type = SQL_C_CHAR, cbSchemaName, field_number;
+	SQLSMALLINT	internal_asis_type = SQL_C_CHAR, cbSchemaName;
+	SQLSMALLINT	seq_in_index, attnum, indoption;
 	const SQLCHAR *szSchemaName;
 	const char *eq_string;
-	OID		ioid;
 	Int4		relhasoids;
+	char		*cache_key;
 
 	mylog("%s: entering...stmt=%p scnm=%p len=%d\n", func, stmt, szTableOwner, cbTableOwner);
 
@@ -3072,10 +3083,22 @@ PGAPI_Statistics(HSTMT hstmt,
 	if (CC_is_in_unicode_driver(conn))
 		internal_asis_type = INTERNAL_ASIS_TYPE;
 #endif /* UNICODE_SUPPORT */
+	cache_key = catalog_cache_key(stmt, func, fUnique, fAccuracy, 0, 3,
+			szTableQualifier, cbTableQualifier,
+			szTableOwner, cbTableOwner,
+			szTableName, cbTableName);
+	if (use_cached_catalog_result(stmt, cache_key, &ret))
+	{
+		free(cache_key);
+		free(table_name);
+		return ret;
+	}
 
 	if (res = QR_Constructor(), !res)
 	{
 		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Couldn't allocate memory for PGAPI_Statistics result.", func);
+		if (cache_key)
+			free(cache_key);
 		return SQL_ERROR;
 	}
 	SC_set_Result(stmt, res);
@@ -3109,101 +3132,7 @@ PGAPI_Statistics(HSTMT hstmt,
 	szSchemaName = szTableOwner;
 	cbSchemaName = cbTableOwner;
 
-	table_schemaname[0] = '\0';
-	schema_strcat(table_schemaname, "%.*s", szSchemaName, cbSchemaName, szTableName, cbTableName, conn);
-
-	/*
-	 * we need to get a list of the field names first, so we can return
-	 * them later.
-	 */
-	result = PGAPI_AllocStmt(conn, &hcol_stmt, 0);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "PGAPI_AllocStmt failed in PGAPI_Statistics for columns.", func);
-		goto cleanup;
-	}
-
-	col_stmt = (StatementClass *) hcol_stmt;
-
-	/*
-	 * "internal" prevents SQLColumns from returning the oid if it is
-	 * being shown. This would throw everything off.
-	 */
-	col_stmt->internal = TRUE;
-	/*
-	 * table_name parameter cannot contain a string search pattern.
-	 */
-	result = PGAPI_Columns(hcol_stmt,
-						   NULL, 0,
-						   (SQLCHAR *) table_schemaname, SQL_NTS,
-						   (SQLCHAR *) table_name, SQL_NTS,
-						   NULL, 0,
-						   PODBC_NOT_SEARCH_PATTERN | PODBC_SEARCH_PUBLIC_SCHEMA, 0, 0);
-	col_stmt->internal = FALSE;
-
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-	result = PGAPI_BindCol(hcol_stmt, COLUMNS_COLUMN_NAME + 1, internal_asis_type,
-						 column_name, sizeof(column_name), &column_name_len);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-	result = PGAPI_BindCol(hcol_stmt, COLUMNS_PHYSICAL_NUMBER + 1, SQL_C_SHORT,
-			&field_number, sizeof(field_number), NULL);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, col_stmt, TRUE);
-		goto cleanup;
-	}
-
-	alcount = 0;
-	result = PGAPI_Fetch(hcol_stmt);
-	while (SQL_SUCCEEDED(result))
-	{
-		if (0 == total_columns)
-			PGAPI_GetData(hcol_stmt, 2, internal_asis_type, table_schemaname, sizeof(table_schemaname), NULL);
-
-		if (total_columns >= alcount)
-		{
-			if (0 == alcount)
-				alcount = 4;
-			else
-				alcount *= 2;
-			column_names =
-				(struct columns_idx *) realloc(column_names,
-							  alcount * sizeof(struct columns_idx));
-		}
-		column_names[total_columns].col_name =
-			(char *) malloc(strlen(column_name) + 1);
-		strcpy(column_names[total_columns].col_name, column_name);
-		column_names[total_columns].pnum = field_number;
-		total_columns++;
-
-		mylog("%s: column_name = '%s'\n", func, column_name);
-
-		result = PGAPI_Fetch(hcol_stmt);
-	}
-
-	if (result != SQL_NO_DATA_FOUND)
-	{
-		SC_full_error_copy(stmt, col_stmt, FALSE);
-		goto cleanup;
-	}
-	PGAPI_FreeStmt(hcol_stmt, SQL_DROP);
-	hcol_stmt = NULL;
-	if (total_columns == 0)
-	{
-		/* Couldn't get column names in SQLStatistics.; */
-		ret = SQL_SUCCESS;
-		goto cleanup;
-	}
-
-	/* get a list of indexes on this table */
+	/* get a list of the columns of the indexes on this table */
 	result = PGAPI_AllocStmt(conn, &hindx_stmt, 0);
 	if (!SQL_SUCCEEDED(result))
 	{
@@ -3216,23 +3145,51 @@ PGAPI_Statistics(HSTMT hstmt,
 	/* TableName cannot contain a string search pattern */
 	escTableName = simpleCatalogEscape((SQLCHAR *) table_name, SQL_NTS, NULL, conn);
 	eq_string = gen_opestr(eqop, conn);
+retry_public_schema:
+	table_schemaname[0] = '\0';
+	schema_strcat(table_schemaname, "%.*s", szSchemaName, cbSchemaName, szTableName, cbTableName, conn);
+	if (escSchemaName)
+		free(escSchemaName);
 	escSchemaName = simpleCatalogEscape((SQLCHAR *) table_schemaname, SQL_NTS, NULL, conn);
-	snprintf(index_query, sizeof(index_query), "select c.relname, i.indkey, i.indisunique"
-		", i.indisclustered, a.amname, c.relhasrules, n.nspname"
-		", c.oid, d.relhasoids, %s"
-		" from pg_catalog.pg_index i, pg_catalog.pg_class c,"
-		" pg_catalog.pg_class d, pg_catalog.pg_am a,"
-		" pg_catalog.pg_namespace n"
+	/*
+	 * Get a row for each column of each index. The names of the columns
+	 * and the definitions of the expressions are resolved by the server
+	 * so that no more queries are needed. The query starts from the
+	 * table, so that an index-less table still gets a row with the
+	 * index columns null, which tells it from a missing table.
+	 */
+	snprintf(index_query, sizeof(index_query), "select c.relname"
+		", coalesce(i.indisunique, false), coalesce(i.indisclustered, false)"
+		", coalesce(a.amname, ''), d.relhasrules, n.nspname"
+		", c.oid, d.relhasoids, coalesce(s.seq, 0)"
+		", coalesce(i.indkey[s.seq - 1], 0)"
+		", case i.indkey[s.seq - 1] when 0 then"
+		" pg_catalog.pg_get_indexdef(c.oid, s.seq, true)"
+		" else t.attname end, %s"
+		" from pg_catalog.pg_class d"
+		" inner join pg_catalog.pg_namespace n on n.oid = d.relnamespace"
+		" left outer join (pg_catalog.pg_index i"
+		" inner join pg_catalog.pg_class c on i.indexrelid = c.oid"
+		" inner join pg_catalog.pg_am a on c.relam = a.oid"
+		" inner join ", PG_VERSION_GE(conn, 8.3) ? "coalesce(i.indoption[s.seq - 1], 0)" : "0");
+	if (PG_VERSION_GE(conn, 8.0))
+		snprintf_add(index_query, sizeof(index_query), "pg_catalog.generate_series(1, %d) s(seq)", INDEX_KEYS_STORAGE_COUNT);
+	else
+	{
+		strcat(index_query, "(select 1");
+		for (i = 2; i <= INDEX_KEYS_STORAGE_COUNT; i++)
+			snprintf_add(index_query, sizeof(index_query), " union all select %d", i);
+		strcat(index_query, ") s(seq)");
+	}
+	snprintf_add(index_query, sizeof(index_query),
+		" on s.seq <= i.indnatts"
+		" left outer join pg_catalog.pg_attribute t"
+		" on t.attrelid = i.indrelid and t.attnum = i.indkey[s.seq - 1])"
+		" on i.indrelid = d.oid"
 		" where d.relname %s'%s'"
 		" and n.nspname %s'%s'"
-		" and n.oid = d.relnamespace"
-		" and d.oid = i.indrelid"
-		" and i.indexrelid = c.oid"
-		" and c.relam = a.oid order by"
-		, PG_VERSION_GE(conn, 8.3) ? "i.indoption" : "0"
+		" order by i.indisprimary desc, i.indisunique, n.nspname, c.relname, s.seq"
 		, eq_string, escTableName, eq_string, escSchemaName);
-	strcat(index_query, " i.indisprimary desc,");
-	strcat(index_query, " i.indisunique, n.nspname, c.relname");
 
 	result = PGAPI_ExecDirect(hindx_stmt, (SQLCHAR *) index_query, SQL_NTS, 0);
 	if (!SQL_SUCCEEDED(result))
@@ -3254,19 +3211,9 @@ PGAPI_Statistics(HSTMT hstmt,
 						* in SQLStatistics."; */
 		goto cleanup;
 
-	}
-	/* bind the vector column */
-	result = PGAPI_BindCol(hindx_stmt, 2, SQL_C_DEFAULT,
-			fields_vector, sizeof(fields_vector), &fields_vector_len);
-	if (!SQL_SUCCEEDED(result))
-	{
-		SC_error_copy(stmt, indx_stmt, TRUE); /* "Couldn't bind column
-						 * in SQLStatistics."; */
-		goto cleanup;
-
 	}
 	/* bind the "is unique" column */
-	result = PGAPI_BindCol(hindx_stmt, 3, internal_asis_type,
+	result = PGAPI_BindCol(hindx_stmt, 2, internal_asis_type,
 						   isunique, sizeof(isunique), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
@@ -3276,7 +3223,7 @@ PGAPI_Statistics(HSTMT hstmt,
 	}
 
 	/* bind the "is clustered" column */
-	result = PGAPI_BindCol(hindx_stmt, 4, internal_asis_type,
+	result = PGAPI_BindCol(hindx_stmt, 3, internal_asis_type,
 						   isclustered, sizeof(isclustered), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
@@ -3287,7 +3234,7 @@ PGAPI_Statistics(HSTMT hstmt,
 	}
 
 	/* bind the "is hash" column */
-	result = PGAPI_BindCol(hindx_stmt, 5, internal_asis_type,
+	result = PGAPI_BindCol(hindx_stmt, 4, internal_asis_type,
 						   ishash, sizeof(ishash), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
@@ -3297,7 +3244,7 @@ PGAPI_Statistics(HSTMT hstmt,
 
 	}
 
-	result = PGAPI_BindCol(hindx_stmt, 6, internal_asis_type,
+	result = PGAPI_BindCol(hindx_stmt, 5, internal_asis_type,
 					relhasrules, sizeof(relhasrules), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
@@ -3306,36 +3253,60 @@ PGAPI_Statistics(HSTMT hstmt,
 	}
 
 	result = PGAPI_BindCol(hindx_stmt, 8, SQL_C_ULONG,
-					&ioid, sizeof(ioid), NULL);
+					&relhasoids, sizeof(relhasoids), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
 		SC_error_copy(stmt, indx_stmt, TRUE);
 		goto cleanup;
 	}
 
-	result = PGAPI_BindCol(hindx_stmt, 9, SQL_C_ULONG,
-					&relhasoids, sizeof(relhasoids), NULL);
+	result = PGAPI_BindCol(hindx_stmt, 9, SQL_C_SHORT,
+					&seq_in_index, sizeof(seq_in_index), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
 		SC_error_copy(stmt, indx_stmt, TRUE);
 		goto cleanup;
 	}
 
-	/* bind the vector column */
-	result = PGAPI_BindCol(hindx_stmt, 10, SQL_C_DEFAULT,
-			indopt_vector, sizeof(fields_vector), &fields_vector_len);
+	result = PGAPI_BindCol(hindx_stmt, 10, SQL_C_SHORT,
+					&attnum, sizeof(attnum), NULL);
 	if (!SQL_SUCCEEDED(result))
 	{
-		SC_error_copy(stmt, indx_stmt, TRUE); /* "Couldn't bind column
-						 * in SQLStatistics."; */
+		SC_error_copy(stmt, indx_stmt, TRUE);
+		goto cleanup;
+	}
+
+	/* bind the column name (or expression) column */
+	result = PGAPI_BindCol(hindx_stmt, 11, internal_asis_type,
+					column_name, sizeof(column_name), &column_name_len);
+	if (!SQL_SUCCEEDED(result))
+	{
+		SC_error_copy(stmt, indx_stmt, TRUE);
 		goto cleanup;
+	}
 
+	result = PGAPI_BindCol(hindx_stmt, 12, SQL_C_SHORT,
+					&indoption, sizeof(indoption), NULL);
+	if (!SQL_SUCCEEDED(result))
+	{
+		SC_error_copy(stmt, indx_stmt, TRUE);
+		goto cleanup;
 	}
 
 	relhasrules[0] = '0';
+	relhasoids = 0;
 	result = PGAPI_Fetch(hindx_stmt);
+	/* If the table is not found */
+	if (SQL_NO_DATA_FOUND == result &&
+	    allow_public_schema(conn, szSchemaName, cbSchemaName))
+	{
+		PGAPI_FreeStmt(hindx_stmt, SQL_CLOSE);
+		szSchemaName = pubstr;
+		cbSchemaName = SQL_NTS;
+		goto retry_public_schema;
+	}
 	/* fake index of OID */
-	if (relhasoids && relhasrules[0] != '1' && atoi(ci->show_oid_column) && atoi(ci->fake_oid_index))
+	if (SQL_SUCCEEDED(result) && relhasoids && relhasrules[0] != '1' && atoi(ci->show_oid_column) && atoi(ci->fake_oid_index))
 	{
 		tuple = QR_AddNew(res);
 
@@ -3369,98 +3340,64 @@ PGAPI_Statistics(HSTMT hstmt,
 
 	while (SQL_SUCCEEDED(result))
 	{
-		/* If only requesting unique indexs, then just return those. */
-		if (fUnique == SQL_INDEX_ALL ||
-			(fUnique == SQL_INDEX_UNIQUE && atoi(isunique)))
+		/*
+		 * If only requesting unique indexs, then just return those.
+		 * The row of a table without indexes has no index name.
+		 */
+		if (SQL_NULL_DATA != index_name_len &&
+		    (fUnique == SQL_INDEX_ALL ||
+		     (fUnique == SQL_INDEX_UNIQUE && atoi(isunique))))
 		{
-			int	colcnt, attnum;
-
 			/* add a row in this table for each field in the index */
-			colcnt = fields_vector[0];
-			for (i = 1; i <= colcnt; i++)
-			{
-				tuple = QR_AddNew(res);
-
-				/* no table qualifier */
-				set_tuplefield_string(&tuple[STATS_CATALOG_NAME], CurrCat(conn));
-				/* don't set the table owner, else Access tries to use it */
-				set_tuplefield_string(&tuple[STATS_SCHEMA_NAME], GET_SCHEMA_NAME(table_schemaname));
-				set_tuplefield_string(&tuple[STATS_TABLE_NAME], table_name);
-
-				/* non-unique index? */
-				if (ci->drivers.unique_index)
-					set_tuplefield_int2(&tuple[STATS_NON_UNIQUE], (Int2) (atoi(isunique) ? FALSE : TRUE));
-				else
-					set_tuplefield_int2(&tuple[STATS_NON_UNIQUE], TRUE);
-
-				/* no index qualifier */
-				set_tuplefield_string(&tuple[STATS_INDEX_QUALIFIER], GET_SCHEMA_NAME(table_schemaname));
-				set_tuplefield_string(&tuple[STATS_INDEX_NAME], index_name);
-
-				/*
-				 * Clustered/HASH index?
-				 */
-				set_tuplefield_int2(&tuple[STATS_TYPE], (Int2)
-							   (atoi(isclustered) ? SQL_INDEX_CLUSTERED :
-								(!strncmp(ishash, "hash", 4)) ? SQL_INDEX_HASHED : SQL_INDEX_OTHER));
-				set_tuplefield_int2(&tuple[STATS_SEQ_IN_INDEX], (Int2) i);
+			tuple = QR_AddNew(res);
 
-				attnum = fields_vector[i];
-				if (OID_ATTNUM == attnum)
-				{
-					set_tuplefield_string(&tuple[STATS_COLUMN_NAME], OID_NAME);
-					mylog("%s: column name = oid\n", func);
-				}
-				else if (0 == attnum)
-				{
-					char	cmd[64];
+			/* no table qualifier */
+			set_tuplefield_string(&tuple[STATS_CATALOG_NAME], CurrCat(conn));
+			/* don't set the table owner, else Access tries to use it */
+			set_tuplefield_string(&tuple[STATS_SCHEMA_NAME], GET_SCHEMA_NAME(table_schemaname));
+			set_tuplefield_string(&tuple[STATS_TABLE_NAME], table_name);
 
-					QResultClass *res;
+			/* non-unique index? */
+			if (ci->drivers.unique_index)
+				set_tuplefield_int2(&tuple[STATS_NON_UNIQUE], (Int2) (atoi(isunique) ? FALSE : TRUE));
+			else
+				set_tuplefield_int2(&tuple[STATS_NON_UNIQUE], TRUE);
 
-					snprintf(cmd, sizeof(cmd), "select pg_get_indexdef(%u, %d, true)", ioid, i);
-					res = CC_send_query(conn, cmd, NULL, IGNORE_ABORT_ON_CONN, stmt);
-					if (QR_command_maybe_successful(res))
-						set_tuplefield_string(&tuple[STATS_COLUMN_NAME], QR_get_value_backend_text(res, 0, 0));
-					QR_Destructor(res);
-				}
-				else
-				{
-					int j, matchidx;
-					BOOL	unknownf = TRUE;
+			/* no index qualifier */
+			set_tuplefield_string(&tuple[STATS_INDEX_QUALIFIER], GET_SCHEMA_NAME(table_schemaname));
+			set_tuplefield_string(&tuple[STATS_INDEX_NAME], index_name);
 
-					if (attnum > 0)
-					{
-						for (j = 0; j < total_columns; j++)
-						{
-							if (attnum == column_names[j].pnum)
-							{
-								matchidx = j;
-								unknownf = FALSE;
-								break;
-							}
-						}
-					}
-					if (unknownf)
-					{
-						set_tuplefield_string(&tuple[STATS_COLUMN_NAME], "UNKNOWN");
-						mylog("%s: column name = UNKNOWN\n", func);
-					}
-					else
-					{
-						set_tuplefield_string(&tuple[STATS_COLUMN_NAME], column_names[matchidx].col_name);
-						mylog("%s: column name = '%s'\n", func, column_names[matchidx].col_name);
-					}
-				}
+			/*
+			 * Clustered/HASH index?
+			 */
+			set_tuplefield_int2(&tuple[STATS_TYPE], (Int2)
+						   (atoi(isclustered) ? SQL_INDEX_CLUSTERED :
+							(!strncmp(ishash, "hash", 4)) ? SQL_INDEX_HASHED : SQL_INDEX_OTHER));
+			set_tuplefield_int2(&tuple[STATS_SEQ_IN_INDEX], seq_in_index);
 
-				if (i <= indopt_vector[0] &&
-				    (indopt_vector[i] & INDOPTION_DESC) != 0)
-					set_tuplefield_string(&tuple[STATS_COLLATION], "D");
-				else
-					set_tuplefield_string(&tuple[STATS_COLLATION], "A");
-				set_tuplefield_null(&tuple[STATS_CARDINALITY]);
-				set_tuplefield_null(&tuple[STATS_PAGES]);
-				set_tuplefield_null(&tuple[STATS_FILTER_CONDITION]);
+			if (OID_ATTNUM == attnum)
+			{
+				set_tuplefield_string(&tuple[STATS_COLUMN_NAME], OID_NAME);
+				mylog("%s: column name = oid\n", func);
+			}
+			else if (SQL_NULL_DATA == column_name_len)
+			{
+				set_tuplefield_string(&tuple[STATS_COLUMN_NAME], "UNKNOWN");
+				mylog("%s: column name = UNKNOWN\n", func);
+			}
+			else
+			{
+				set_tuplefield_string(&tuple[STATS_COLUMN_NAME], column_name);
+				mylog("%s: column name = '%s'\n", func, column_name);
 			}
+
+			if ((indoption & INDOPTION_DESC) != 0)
+				set_tuplefield_string(&tuple[STATS_COLLATION], "D");
+			else
+				set_tuplefield_string(&tuple[STATS_COLLATION], "A");
+			set_tuplefield_null(&tuple[STATS_CARDINALITY]);
+			set_tuplefield_null(&tuple[STATS_PAGES]);
+			set_tuplefield_null(&tuple[STATS_FILTER_CONDITION]);
 		}
 
 		result = PGAPI_Fetch(hindx_stmt);
@@ -3481,8 +3418,6 @@ cleanup:
 	 */
 	stmt->status = STMT_FINISHED;
 
-	if (hcol_stmt)
-		PGAPI_FreeStmt(hcol_stmt, SQL_DROP);
 	if (hindx_stmt)
 		PGAPI_FreeStmt(hindx_stmt, SQL_DROP);
 	/* These things should be freed on any error ALSO! */
@@ -3492,18 +3427,15 @@ cleanup:
 		free(escTableName);
 	if (escSchemaName)
 		free(escSchemaName);
-	if (column_names)
-	{
-		for (i = 0; i < total_columns; i++)
-			free(column_names[i].col_name);
-		free(column_names);
-	}
 
 	/* set up the current tuple pointer for SQLFetch */
 	stmt->currTuple = -1;
 	SC_set_rowset_start(stmt, -1, FALSE);
 	SC_set_current_col(stmt, -1);
 
+	cache_catalog_result(stmt, cache_key, ret);
+	if (cache_key)
+		free(cache_key);
 	if (stmt->internal)
 		ret = DiscardStatementSvp(stmt, ret, FALSE);
 	mylog("%s: EXIT, stmt=%p, ret=%d\n", func, stmt, ret);
@@ -3657,15 +3589,27 @@ PGAPI_PrimaryKeys(HSTMT hstmt,
 	const SQLCHAR *szSchemaName;
 	const char *eq_string;
 	char	*escSchemaName = NULL, *escTableName = NULL;
+	char	*cache_key;
 
 	mylog("%s: entering...stmt=%p scnm=%p len=%d\n", func, stmt, szTableOwner, cbTableOwner);
 
 	if (result = SC_initialize_and_recycle(stmt), SQL_SUCCESS != result)
 		return result;
 
+	cache_key = catalog_cache_key(stmt, func, 0, reloid, 0, 3,
+			szTableQualifier, cbTableQualifier,
+			szTableOwner, cbTableOwner,
+			szTableName, cbTableName);
+	if (use_cached_catalog_result(stmt, cache_key, &ret))
+	{
+		free(cache_key);
+		return ret;
+	}
 	if (res = QR_Constructor(), !res)
 	{
 		SC_set_error(stmt, STMT_NO_MEMORY_ERROR, "Couldn't allocate memory for PGAPI_PrimaryKeys result.", func);
+		if (cache_key)
+			free(cache_key);
 		return SQL_ERROR;
 	}
 	SC_set_Result(stmt, res);
@@ -3925,6 +3869,9 @@ cleanup:
 	SC_set_rowset_start(stmt, -1, FALSE);
 	SC_set_current_col(stmt, -1);
 
+	cache_catalog_result(stmt, cache_key, ret);
+	if (cache_key)
+		free(cache_key);
 	if (stmt->internal)
 		ret = DiscardStatementSvp(stmt, ret, FALSE);
 	mylog("%s: EXIT, stmt=%p, ret=%d\n", func, stmt, ret);
@@ -3950,59 +3897,31 @@ isMultibyte(const char *str)
 static char *
 getClientColumnName(ConnectionClass *conn, UInt4 relid, char *serverColumnName, BOOL *nameAlloced)
 {
-	char		query[1024], saveattnum[16],
-			   *ret = serverColumnName;
-	const char *eq_string;
-	BOOL		continueExec = TRUE,
-				bError = FALSE;
+	char		query[1024], *ret = serverColumnName;
+	const UCHAR	*sptr;
+	size_t		qlen;
 	QResultClass *res = NULL;
 	UWORD	flag = IGNORE_ABORT_ON_CONN | ROLLBACK_ON_ERROR;
 
 	*nameAlloced = FALSE;
 	if (!conn->original_client_encoding || !isMultibyte(serverColumnName))
 		return ret;
-	if (!conn->server_encoding)
-	{
-		if (res = CC_send_query(conn, "select getdatabaseencoding()", NULL, flag, NULL), QR_command_maybe_successful(res))
-		{
-			if (QR_get_num_cached_tuples(res) > 0)
-				conn->server_encoding = strdup(QR_get_value_backend_text(res, 0, 0));
-		}
-		QR_Destructor(res);
-		res = NULL;
-	}
-	if (!conn->server_encoding)
-		return ret;
-	snprintf(query, sizeof(query), "SET CLIENT_ENCODING TO '%s'", conn->server_encoding);
-	bError = (!QR_command_maybe_successful((res = CC_send_query(conn, query, NULL, flag, NULL))));
-	QR_Destructor(res);
-	eq_string = gen_opestr(eqop, conn);
-	if (!bError && continueExec)
+	/*
+	 * The name is in the server encoding. Pass its bytes in hex and let
+	 * the server compare them with the bytes of each attname, so that
+	 * the client encoding needn't be switched back and forth.
+	 */
+	qlen = snprintf(query, sizeof(query), "select attname from pg_catalog.pg_attribute"
+		" where attrelid = %u"
+		" and pg_catalog.decode(pg_catalog.replace(attname, pg_catalog.chr(92), pg_catalog.chr(92) || pg_catalog.chr(92)), 'escape')"
+		" = pg_catalog.decode('", relid);
+	for (sptr = (const UCHAR *) serverColumnName; *sptr; sptr++)
 	{
-		snprintf(query, sizeof(query), "select attnum from pg_attribute "
-			"where attrelid = %u and attname %s'%s'",
-			relid, eq_string, serverColumnName);
-		if (res = CC_send_query(conn, query, NULL, flag, NULL), QR_command_maybe_successful(res))
-		{
-			if (QR_get_num_cached_tuples(res) > 0)
-			{
-				strcpy(saveattnum, QR_get_value_backend_text(res, 0, 0));
-			}
-			else
-				continueExec = FALSE;
-		}
-		else
-			bError = TRUE;
-		QR_Destructor(res);
+		if (qlen + 16 >= sizeof(query))
+			return ret;
+		qlen += sprintf(query + qlen, "%02x", *sptr);
 	}
-	continueExec = (continueExec && !bError);
-	/* restore the cleint encoding */
-	snprintf(query, sizeof(query), "SET CLIENT_ENCODING TO '%s'", conn->original_client_encoding);
-	bError = (!QR_command_maybe_successful((res = CC_send_query(conn, query, NULL, flag, NULL))));
-	QR_Destructor(res);
-	if (bError || !continueExec)
-		return ret;
-	snprintf(query, sizeof(query), "select attname from pg_attribute where attrelid = %u and attnum = %s", relid, saveattnum);
+	strcat(query, "', 'hex')");
 	if (res = CC_send_query(conn, query, NULL, flag, NULL), QR_command_maybe_successful(res))
 	{
 		if (QR_get_num_cached_tuples(res) > 0)
@@ -4836,9 +4755,34 @@ PGAPI_ForeignKeys(HSTMT hstmt,
 				  const SQLCHAR FAR * szFkTableName, /* OA(R) E*/
 				  SQLSMALLINT cbFkTableName)
 {
-	ConnectionClass	*conn = SC_get_conn(((StatementClass *) hstmt));
+	CSTR func = "PGAPI_ForeignKeys";
+	StatementClass	*stmt = (StatementClass *) hstmt;
+	ConnectionClass	*conn = SC_get_conn(stmt);
+	RETCODE		ret;
+	char		*cache_key;
+
+	cache_key = catalog_cache_key(stmt, func, 0, 0, 0, 6,
+			szPkTableQualifier, cbPkTableQualifier,
+			szPkTableOwner, cbPkTableOwner,
+			szPkTableName, cbPkTableName,
+			szFkTableQualifier, cbFkTableQualifier,
+			szFkTableOwner, cbFkTableOwner,
+			szFkTableName, cbFkTableName);
+	if (NULL != cache_key)
+	{
+		if (ret = SC_initialize_and_recycle(stmt), SQL_SUCCESS != ret)
+		{
+			free(cache_key);
+			return ret;
+		}
+		if (use_cached_catalog_result(stmt, cache_key, &ret))
+		{
+			free(cache_key);
+			return ret;
+		}
+	}
 	if (PG_VERSION_GE(conn, 8.1))
-		return PGAPI_ForeignKeys_new(hstmt,
+		ret = PGAPI_ForeignKeys_new(hstmt,
 				szPkTableQualifier, cbPkTableQualifier,
 				szPkTableOwner, cbPkTableOwner,
 				szPkTableName, cbPkTableName,
@@ -4846,13 +4790,19 @@ PGAPI_ForeignKeys(HSTMT hstmt,
 				szFkTableOwner, cbFkTableOwner,
 				szFkTableName, cbFkTableName);
 	else
-		return PGAPI_ForeignKeys_old(hstmt,
+		ret = PGAPI_ForeignKeys_old(hstmt,
 				szPkTableQualifier, cbPkTableQualifier,
 				szPkTableOwner, cbPkTableOwner,
 				szPkTableName, cbPkTableName,
 				szFkTableQualifier, cbFkTableQualifier,
 				szFkTableOwner, cbFkTableOwner,
 				szFkTableName, cbFkTableName);
+	if (NULL != cache_key)
+	{
+		cache_catalog_result(stmt, cache_key, ret);
+		free(cache_key);
+	}
+	return ret;
 }
 
 
@@ -16,6 +16,9 @@
 
 #include "connection.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 
 OID
 odbc_lo_creat(ConnectionClass *conn, int mode)
@@ -49,12 +52,10 @@ odbc_lo_open(ConnectionClass *conn, int lobjId, int mode)
 	argv[1].len = 4;
 	argv[1].u.integer = mode;
 
+	/* A newly opened descriptor is positioned at the beginning */
 	if (!CC_send_function(conn, LO_OPEN, &fd, &result_len, 1, argv, 2))
 		return -1;
 
-	if (fd >= 0 && odbc_lo_lseek(conn, fd, 0L, SEEK_SET) < 0)
-		return -1;
-
 	return fd;
 }
 
@@ -181,3 +182,191 @@ odbc_lo_unlink(ConnectionClass *conn, OID lobjId)
 	else
 		return retval;
 }
+
+
+static void
+set_lo_int_arg(LO_ARG *arg, int value)
+{
+	arg->isint = 1;
+	arg->len = 4;
+	arg->u.integer = value;
+}
+
+static void
+set_lo_call(FuncCallInfo *call, int fnid, void *result_buf, int *actual_result_len, int result_is_int, LO_ARG *args, int nargs)
+{
+	call->fnid = fnid;
+	call->result_buf = result_buf;
+	call->actual_result_len = actual_result_len;
+	call->result_is_int = result_is_int;
+	call->args = args;
+	call->nargs = nargs;
+}
+
+/*
+ *	Get the size of a newly opened large object and read ahead its first
+ *	chunk, all in one round trip. Returns the size or -1 on error.
+ */
+Int4
+odbc_lo_size_and_read(ConnectionClass *conn, int fd, LO_BUFFER *lob)
+{
+	LO_ARG		end_argv[3], set_argv[3], read_argv[2];
+	FuncCallInfo	calls[3];
+	Int4		size, pos, result_len[3];
+	int		ncalls = 2;
+
+	LO_BUFFER_reset(lob);
+	if (!lob->data)
+		lob->data = malloc(LO_BUFFER_SIZE);
+
+	set_lo_int_arg(&end_argv[0], fd);
+	set_lo_int_arg(&end_argv[1], 0);
+	set_lo_int_arg(&end_argv[2], SEEK_END);
+	set_lo_call(&calls[0], LO_LSEEK, &size, &result_len[0], 1, end_argv, 3);
+	set_lo_int_arg(&set_argv[0], fd);
+	set_lo_int_arg(&set_argv[1], 0);
+	set_lo_int_arg(&set_argv[2], SEEK_SET);
+	set_lo_call(&calls[1], LO_LSEEK, &pos, &result_len[1], 1, set_argv, 3);
+	if (lob->data)
+	{
+		set_lo_int_arg(&read_argv[0], fd);
+		set_lo_int_arg(&read_argv[1], LO_BUFFER_SIZE);
+		set_lo_call(&calls[2], LO_READ, lob->data, &result_len[2], 0, read_argv, 2);
+		ncalls++;
+	}
+
+	if (!CC_send_functions(conn, calls, ncalls))
+		return -1;
+	if (lob->data)
+		lob->used = result_len[2];
+
+	return size;
+}
+
+
+/*
+ *	Read through the read ahead buffer. Requests smaller than the buffer
+ *	are served from LO_BUFFER_SIZE chunks.
+ */
+Int4
+odbc_lo_read_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob, char *buf, Int4 len)
+{
+	Int4		total = 0, nread;
+
+	while (len > 0)
+	{
+		if (lob->pos >= lob->used)
+		{
+			LO_BUFFER_reset(lob);
+			if (len >= LO_BUFFER_SIZE ||
+			    (!lob->data && !(lob->data = malloc(LO_BUFFER_SIZE))))
+			{
+				if ((nread = odbc_lo_read(conn, fd, buf, len)) < 0)
+					return -1;
+				total += nread;
+				break;
+			}
+			if ((nread = odbc_lo_read(conn, fd, lob->data, LO_BUFFER_SIZE)) < 0)
+				return -1;
+			if (0 == nread)
+				break;
+			lob->used = nread;
+		}
+		nread = lob->used - lob->pos;
+		if (nread > len)
+			nread = len;
+		memcpy(buf, lob->data + lob->pos, nread);
+		lob->pos += nread;
+		buf += nread;
+		len -= nread;
+		total += nread;
+	}
+
+	return total;
+}
+
+
+/*
+ *	lo_write() all of the data, or set the error and return -1.
+ */
+static Int4
+lo_write_all(ConnectionClass *conn, int fd, char *buf, Int4 len)
+{
+	CSTR	func = "lo_write_all";
+	Int4	written = odbc_lo_write(conn, fd, buf, len);
+
+	if (written == len)
+		return len;
+	mylog("%s: lo_write wrote %d of %d bytes\n", func, written, len);
+	if (written >= 0)
+		CC_set_error(conn, CONN_EXEC_ERROR, "Could not write the whole large object", func);
+	return -1;
+}
+
+/*
+ *	Write through the buffer. Small writes are collected and sent in
+ *	LO_BUFFER_SIZE chunks, or by odbc_lo_close_buffered().
+ */
+Int4
+odbc_lo_write_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob, char *buf, Int4 len)
+{
+	if (len <= 0)
+		return 0;
+	if (!lob->write_pending)
+		LO_BUFFER_reset(lob);
+	else if (lob->used + len > LO_BUFFER_SIZE)
+	{
+		Int4	used = lob->used;
+
+		LO_BUFFER_reset(lob);
+		if (lo_write_all(conn, fd, lob->data, used) < 0)
+			return -1;
+	}
+	if (len >= LO_BUFFER_SIZE ||
+	    (!lob->data && !(lob->data = malloc(LO_BUFFER_SIZE))))
+		return lo_write_all(conn, fd, buf, len);
+
+	memcpy(lob->data + lob->used, buf, len);
+	lob->used += len;
+	lob->write_pending = TRUE;
+
+	return len;
+}
+
+
+/*
+ *	Write the pending data and close the descriptor in one round trip.
+ */
+int
+odbc_lo_close_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob)
+{
+	CSTR	func = "odbc_lo_close_buffered";
+	LO_ARG		write_argv[2], close_argv[1];
+	FuncCallInfo	calls[2];
+	Int4		written, retval, result_len[2], used = 0;
+	int		ncalls = 0;
+
+	/* the read ahead data is just discarded */
+	if (lob->write_pending)
+	{
+		used = lob->used;
+		set_lo_int_arg(&write_argv[0], fd);
+		write_argv[1].isint = 0;
+		write_argv[1].len = lob->used;
+		write_argv[1].u.ptr = lob->data;
+		set_lo_call(&calls[ncalls++], LO_WRITE, &written, &result_len[0], 1, write_argv, 2);
+	}
+	set_lo_int_arg(&close_argv[0], fd);
+	set_lo_call(&calls[ncalls++], LO_CLOSE, &retval, &result_len[1], 1, close_argv, 1);
+	LO_BUFFER_reset(lob);
+
+	if (!CC_send_functions(conn, calls, ncalls))
+		return -1;
+	if (used > 0 && written != used)
+	{
+		mylog("%s: lo_write wrote %d of %d bytes\n", func, written, used);
+		CC_set_error(conn, CONN_EXEC_ERROR, "Could not write the whole large object", func);
+		return -1;
+	}
+	return retval;
+}
@@ -35,6 +35,28 @@ struct lo_arg
 #define INV_WRITE					0x00020000
 #define INV_READ					0x00040000
 
+/*
+ * Read ahead data, or data not yet written, of a large object descriptor
+ */
+struct lo_buffer
+{
+	char		*data;		/* LO_BUFFER_SIZE bytes, allocated when needed */
+	Int4		used;		/* bytes read ahead or waiting to be written */
+	Int4		pos;		/* the next read ahead byte to return */
+	BOOL		write_pending;	/* used bytes are to be written */
+};
+
+#define LO_BUFFER_SIZE				(256 * 1024)
+
+#define LO_BUFFER_reset(lob)	((lob)->used = (lob)->pos = 0, (lob)->write_pending = FALSE)
+#define LO_BUFFER_init(lob)	((lob)->data = NULL, LO_BUFFER_reset(lob))
+#define LO_BUFFER_free(lob) \
+	do { \
+		if ((lob)->data) \
+			free((lob)->data); \
+		LO_BUFFER_init(lob); \
+	} while (0)
+
 OID		odbc_lo_creat(ConnectionClass *conn, int mode);
 int		odbc_lo_open(ConnectionClass *conn, int lobjId, int mode);
 int		odbc_lo_close(ConnectionClass *conn, int fd);
@@ -44,4 +66,9 @@ Int4		odbc_lo_lseek(ConnectionClass *conn, int fd, int offset, Int4 len);
 Int4		odbc_lo_tell(ConnectionClass *conn, int fd);
 int		odbc_lo_unlink(ConnectionClass *conn, OID lobjId);
 
+Int4		odbc_lo_size_and_read(ConnectionClass *conn, int fd, LO_BUFFER *lob);
+Int4		odbc_lo_read_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob, char *buf, Int4 len);
+Int4		odbc_lo_write_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob, char *buf, Int4 len);
+int		odbc_lo_close_buffered(ConnectionClass *conn, int fd, LO_BUFFER *lob);
+
 #endif
@@ -432,17 +432,20 @@ SQLGetFunctions(HDBC ConnectionHandle,
 {
 	RETCODE	ret;
 	ConnectionClass *conn = (ConnectionClass *) ConnectionHandle;
+	BOOL	entered;
 
 	mylog("[SQLGetFunctions]");
 	CC_examine_global_transaction(conn);
-	ENTER_CONN_CS(conn);
-	CC_clear_error(conn);
+	/* no need to wait for another thread's network I/O, see SQLGetInfo */
+	if (entered = TRY_ENTER_CONN_CS(conn), entered)
+		CC_clear_error(conn);
 	if (FunctionId == SQL_API_ODBC3_ALL_FUNCTIONS)
 		ret = PGAPI_GetFunctions30(ConnectionHandle, FunctionId, Supported);
 	else
 		ret = PGAPI_GetFunctions(ConnectionHandle, FunctionId, Supported);
 
-	LEAVE_CONN_CS(conn);
+	if (entered)
+		LEAVE_CONN_CS(conn);
 	return ret;
 }
 RETCODE		SQL_API
@@ -453,15 +456,23 @@ SQLGetInfo(HDBC ConnectionHandle,
 	CSTR	func = "SQLGetInfo";
 	RETCODE		ret;
 	ConnectionClass	*conn = (ConnectionClass *) ConnectionHandle;
+	BOOL		entered;
 
 	CC_examine_global_transaction(conn);
-	ENTER_CONN_CS(conn);
-	CC_clear_error(conn);
+	/*
+	 * The info is all cached in the connection, so don't wait while
+	 * another thread holds the connection for network I/O, e.g. a long
+	 * fetch. The diagnostics are then left to that thread; errors are
+	 * still set under the connection's short-term lock.
+	 */
+	if (entered = TRY_ENTER_CONN_CS(conn), entered)
+		CC_clear_error(conn);
 	mylog("[%s(30)]", func);
 	if ((ret = PGAPI_GetInfo(ConnectionHandle, InfoType, InfoValue,
 				BufferLength, StringLength)) == SQL_ERROR)
 		CC_log_error("SQLGetInfo(30)", "", conn);
-	LEAVE_CONN_CS(conn);
+	if (entered)
+		LEAVE_CONN_CS(conn);
 	return ret;
 }
 
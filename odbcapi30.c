@@ -168,9 +168,12 @@ SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle,
 	switch (HandleType)
 	{
 		case SQL_HANDLE_ENV:
-			ENTER_ENV_CS((EnvironmentClass *) Handle);
+			/*
+			 * Don't hold the env CS here: PGAPI_Transact() takes the
+			 * CS of each connection, and the connections take the env
+			 * locks while holding their own.
+			 */
 			ret = PGAPI_Transact(Handle, SQL_NULL_HDBC, CompletionType);
-			LEAVE_ENV_CS((EnvironmentClass *) Handle);
 			break;
 		case SQL_HANDLE_DBC:
 			CC_examine_global_transaction((ConnectionClass *) Handle);
@@ -379,14 +382,17 @@ SQLGetConnectAttr(HDBC ConnectionHandle,
 				  SQLINTEGER BufferLength, SQLINTEGER *StringLength)
 {
 	RETCODE	ret;
+	BOOL	entered;
 
 	mylog("[[SQLGetConnectAttr]] %d\n", Attribute);
 	CC_examine_global_transaction((ConnectionClass*) ConnectionHandle);
-	ENTER_CONN_CS((ConnectionClass *) ConnectionHandle);
-	CC_clear_error((ConnectionClass *) ConnectionHandle);
+	/* no need to wait for another thread's network I/O, see SQLGetInfo */
+	if (entered = TRY_ENTER_CONN_CS((ConnectionClass *) ConnectionHandle), entered)
+		CC_clear_error((ConnectionClass *) ConnectionHandle);
 	ret = PGAPI_GetConnectAttr(ConnectionHandle, Attribute,Value,
 			BufferLength, StringLength);
-	LEAVE_CONN_CS((ConnectionClass *) ConnectionHandle);
+	if (entered)
+		LEAVE_CONN_CS((ConnectionClass *) ConnectionHandle);
 	return ret;
 }
 
@@ -73,14 +73,17 @@ SQLGetConnectAttrW(HDBC hdbc,
 {
 	CSTR func = "SQLGetConnectAttrW";
 	RETCODE	ret;
+	BOOL	entered;
 
 	mylog("[%s]", func);
 	CC_examine_global_transaction((ConnectionClass *) hdbc);
-	ENTER_CONN_CS((ConnectionClass *) hdbc);
-	CC_clear_error((ConnectionClass *) hdbc);
+	/* no need to wait for another thread's network I/O, see SQLGetInfo */
+	if (entered = TRY_ENTER_CONN_CS((ConnectionClass *) hdbc), entered)
+		CC_clear_error((ConnectionClass *) hdbc);
 	ret = PGAPI_GetConnectAttr(hdbc, fAttribute, rgbValue,
 		cbValueMax, pcbValue);
-	LEAVE_CONN_CS((ConnectionClass *) hdbc);
+	if (entered)
+		LEAVE_CONN_CS((ConnectionClass *) hdbc);
 	return ret;
 }
 
@@ -369,16 +369,20 @@ SQLGetInfoW(HDBC ConnectionHandle,
 	CSTR func = "SQLGetInfoW";
 	ConnectionClass	*conn = (ConnectionClass *) ConnectionHandle;
 	RETCODE	ret;
+	BOOL	entered;
 
 	CC_examine_global_transaction(conn);
-	ENTER_CONN_CS(conn);
+	/* the strings are returned in SQLWCHARs with or without the lock */
 	CC_set_in_unicode_driver(conn);
-	CC_clear_error(conn);
+	/* no need to wait for another thread's network I/O, see SQLGetInfo */
+	if (entered = TRY_ENTER_CONN_CS(conn), entered)
+		CC_clear_error(conn);
 	mylog("[%s]", func);
 	if ((ret = PGAPI_GetInfo(ConnectionHandle, InfoType, InfoValue,
 							 BufferLength, StringLength)) == SQL_ERROR)
 		CC_log_error("SQLGetInfoW", "", conn);
-	LEAVE_CONN_CS(conn);
+	if (entered)
+		LEAVE_CONN_CS(conn);
 	return ret;
 }
 
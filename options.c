@@ -173,9 +173,12 @@ set_statement_option(ConnectionClass *conn,
 			mylog("SetStmtOption: SQL_NOSCAN, vParam = " FORMAT_LEN "\n", vParam);
 			break;
 
-		case SQL_QUERY_TIMEOUT:	/* ignored */
+		case SQL_QUERY_TIMEOUT:
 			mylog("SetStmtOption: SQL_QUERY_TIMEOUT, vParam = " FORMAT_LEN "\n", vParam);
-			/* "0" returned in SQLGetStmtOption */
+			if (conn)
+				conn->stmtOptions.stmt_timeout = (SQLULEN) vParam;
+			if (stmt)
+				stmt->options.stmt_timeout = (SQLULEN) vParam;
 			break;
 
 		case SQL_RETRIEVE_DATA:
@@ -493,6 +496,8 @@ PGAPI_SetConnectOption(HDBC hdbc,
 						mylog("Microsoft Jet !!!!\n");
 						CC_set_errornumber(conn, 0);
 						conn->ms_jet = 1;
+						if (CONN_CONNECTED == conn->status)
+							pgtype_init_type_descs(conn);
 						return SQL_SUCCESS;
 					}
 				}
@@ -766,8 +771,8 @@ PGAPI_GetStmtOption(HSTMT hstmt,
 			*((SQLINTEGER *) pvParam) = SQL_NOSCAN_ON;
 			break;
 
-		case SQL_QUERY_TIMEOUT:	/* NOT SUPPORTED */
-			*((SQLINTEGER *) pvParam) = 0;
+		case SQL_QUERY_TIMEOUT:
+			*((SQLULEN *) pvParam) = stmt->options.stmt_timeout;
 			break;
 
 		case SQL_RETRIEVE_DATA:
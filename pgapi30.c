@@ -1719,6 +1719,10 @@ PGAPI_SetConnectAttr(HDBC ConnectionHandle,
 			qlog("fetch => %d\n", conn->connInfo.drivers.fetch_max);
 			mylog("fetch => %d\n", conn->connInfo.drivers.fetch_max);
 			break;
+		case SQL_ATTR_PGOPT_FLUSH_CATALOG_CACHE:
+			EN_flush_catalog_cache(CC_get_env(conn));
+			mylog("catalog cache flushed\n");
+			break;
 		default:
 			ret = PGAPI_SetConnectOption(ConnectionHandle, (SQLUSMALLINT) Attribute, (SQLLEN) Value);
 	}
@@ -2032,11 +2036,16 @@ PGAPI_BulkOperations(HSTMT hstmt, SQLSMALLINT operationX)
 	s.operation = operationX;
 	SC_clear_error(s.stmt);
 	s.opts = SC_get_ARDF(s.stmt);
+	conn = SC_get_conn(s.stmt);
+	if (0 == (ALLOW_BULK_OPERATIONS & conn->connInfo.updatable_cursors))
+	{
+		SC_set_error(s.stmt, STMT_NOT_IMPLEMENTED_ERROR, "Bulk operations aren't available", func);
+		return SQL_ERROR;
+	}
 
 	s.auto_commit_needed = FALSE;
 	if (SQL_FETCH_BY_BOOKMARK != s.operation)
 	{
-		conn = SC_get_conn(s.stmt);
 		if (s.auto_commit_needed = (char) CC_does_autocommit(conn), s.auto_commit_needed)
 			CC_set_autocommit(conn, FALSE);
 	}
@@ -303,6 +303,7 @@ enum {
 	,SQL_ATTR_PGOPT_USE_DECLAREFETCH
 	,SQL_ATTR_PGOPT_SERVER_SIDE_PREPARE
 	,SQL_ATTR_PGOPT_FETCH
+	,SQL_ATTR_PGOPT_FLUSH_CATALOG_CACHE
 };
 RETCODE SQL_API PGAPI_SetConnectAttr(HDBC ConnectionHandle,
 			SQLINTEGER Attribute, PTR Value,
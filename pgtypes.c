@@ -491,15 +491,110 @@ getIntervalColumnSize(OID type, int atttypmod)
 }
 
 
+/*
+ *	The types whose attributes don't depend on atttypmod or on the
+ *	longest length of the column. The large object type is added
+ *	as well if the server has one.
+ */
+static const OID	fixed_pgtypes[] = {
+	PG_TYPE_BOOL,
+	PG_TYPE_CHAR,
+	PG_TYPE_INT8,
+	PG_TYPE_INT2,
+	PG_TYPE_INT4,
+	PG_TYPE_OID,
+	PG_TYPE_XID,
+	PG_TYPE_CIDR,
+	PG_TYPE_FLOAT4,
+	PG_TYPE_FLOAT8,
+	PG_TYPE_ABSTIME,
+	PG_TYPE_MONEY,
+	PG_TYPE_MACADDR,
+	PG_TYPE_INET,
+	PG_TYPE_DATE,
+	PG_TYPE_TIME,
+	PG_TYPE_TIMESTAMP,
+	PG_TYPE_UUID,
+	PG_TYPE_LO_UNDEFINED
+};
+
+static PGTypeDesc *
+pgtype_desc_slot(const ConnectionClass *conn, OID type)
+{
+	int	i;
+
+	for (i = type & (PG_TYPE_DESC_SLOTS - 1);; i = (i + 1) & (PG_TYPE_DESC_SLOTS - 1))
+	{
+		if (conn->type_descs[i].type == type ||
+		    0 == conn->type_descs[i].type)
+			return (PGTypeDesc *) &conn->type_descs[i];
+	}
+}
+
+/*
+ *	Look up the precomputed attributes of a type.
+ *	Returns NULL if the type isn't in the table.
+ */
+static const PGTypeDesc *
+pgtype_get_desc(const ConnectionClass *conn, OID type)
+{
+	const PGTypeDesc	*desc;
+	EnvironmentClass *env = (EnvironmentClass *) CC_get_env(conn);
+
+	if (!conn->type_descs_built || 0 == type)
+		return NULL;
+	if (conn->type_descs_odbc3 != (EN_is_odbc3(env) ? 1 : 0))
+		return NULL;
+	desc = pgtype_desc_slot(conn, type);
+	return 0 != desc->type ? desc : NULL;
+}
+
+/*
+ *	(Re)build the table of the type attributes. This must be called
+ *	after connecting and whenever the settings which affect the
+ *	attributes (e.g. ms_jet) change.
+ */
+void
+pgtype_init_type_descs(ConnectionClass *conn)
+{
+	PGTypeDesc	*desc;
+	EnvironmentClass *env = (EnvironmentClass *) CC_get_env(conn);
+	OID	type;
+	int	i, count = sizeof(fixed_pgtypes) / sizeof(fixed_pgtypes[0]);
+
+	conn->type_descs_built = 0;
+	memset(conn->type_descs, 0, sizeof(conn->type_descs));
+	for (i = 0; i <= count; i++)
+	{
+		if (i < count)
+			type = fixed_pgtypes[i];
+		else if (type = conn->lobj_type, 0 == type)
+			break;
+		desc = pgtype_desc_slot(conn, type);
+		desc->type = type;
+		desc->concise_type = pgtype_attr_to_concise_type(conn, type, -1, PG_UNSPECIFIED);
+		desc->ctype = pgtype_attr_to_ctype(conn, type, -1);
+		desc->column_size = pgtype_attr_column_size(conn, type, -1, PG_UNSPECIFIED, UNKNOWNS_AS_DEFAULT);
+		desc->display_size = pgtype_attr_display_size(conn, type, -1, PG_UNSPECIFIED, UNKNOWNS_AS_DEFAULT);
+		desc->buffer_length = pgtype_attr_buffer_length(conn, type, -1, PG_UNSPECIFIED, UNKNOWNS_AS_DEFAULT);
+		desc->decimal_digits = pgtype_attr_decimal_digits(conn, type, -1, PG_UNSPECIFIED, UNKNOWNS_AS_DEFAULT);
+	}
+	conn->type_descs_odbc3 = EN_is_odbc3(env) ? 1 : 0;
+	conn->type_descs_built = 1;
+}
+
 SQLSMALLINT
 pgtype_attr_to_concise_type(const ConnectionClass *conn, OID type, int atttypmod, int adtsize_or_longestlen)
 {
+	const PGTypeDesc	*desc;
 	const ConnInfo	*ci = &(conn->connInfo);
 	EnvironmentClass *env = (EnvironmentClass *) CC_get_env(conn);
 #ifdef	PG_INTERVAL_AS_SQL_INTERVAL
 	SQLSMALLINT	sqltype;
 #endif /* PG_INTERVAL_AS_SQL_INTERVAL */
 
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->concise_type;
 	switch (type)
 	{
 		case PG_TYPE_CHAR:
@@ -678,12 +773,15 @@ pgtype_attr_to_datetime_sub(const ConnectionClass *conn, OID type, int atttypmod
 SQLSMALLINT
 pgtype_attr_to_ctype(const ConnectionClass *conn, OID type, int atttypmod)
 {
+	const PGTypeDesc	*desc;
 	const ConnInfo	*ci = &(conn->connInfo);
 	EnvironmentClass *env = (EnvironmentClass *) CC_get_env(conn);
 #ifdef	PG_INTERVAL_AS_SQL_INTERVAL
 	SQLSMALLINT	ctype;
 #endif /* PG_INTERVAL_A_SQL_INTERVAL */
 
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->ctype;
 	switch (type)
 	{
 		case PG_TYPE_INT8:
@@ -846,8 +944,11 @@ inolog("pgtype_to_name int4\n");
 Int4	/* PostgreSQL restriction */
 pgtype_attr_column_size(const ConnectionClass *conn, OID type, int atttypmod, int adtsize_or_longest, int handle_unknown_size_as)
 {
+	const PGTypeDesc	*desc;
 	const ConnInfo	*ci = &(conn->connInfo);
 
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->column_size;
 	if (handle_unknown_size_as == UNKNOWNS_AS_DEFAULT)
 		handle_unknown_size_as = ci->drivers.unknown_sizes;
 	switch (type)
@@ -969,8 +1070,11 @@ pgtype_attr_precision(const ConnectionClass *conn, OID type, int atttypmod, int
 Int4
 pgtype_attr_display_size(const ConnectionClass *conn, OID type, int atttypmod, int adtsize_or_longestlen, int handle_unknown_size_as)
 {
+	const PGTypeDesc	*desc;
 	int	dsize;
 
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->display_size;
 	switch (type)
 	{
 		case PG_TYPE_INT2:
@@ -1018,8 +1122,11 @@ pgtype_attr_display_size(const ConnectionClass *conn, OID type, int atttypmod, i
 Int4
 pgtype_attr_buffer_length(const ConnectionClass *conn, OID type, int atttypmod, int adtsize_or_longestlen, int handle_unknown_size_as)
 {
+	const PGTypeDesc	*desc;
 	int	dsize;
 
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->buffer_length;
 	switch (type)
 	{
 		case PG_TYPE_INT2:
@@ -1145,6 +1252,10 @@ pgtype_attr_desclength(const ConnectionClass *conn, OID type, int atttypmod, int
 Int2
 pgtype_attr_decimal_digits(const ConnectionClass *conn, OID type, int atttypmod, int adtsize_or_longestlen, int handle_unknown_size_as)
 {
+	const PGTypeDesc	*desc;
+
+	if (desc = pgtype_get_desc(conn, type), NULL != desc)
+		return desc->decimal_digits;
 	switch (type)
 	{
 		case PG_TYPE_INT2:
@@ -81,6 +81,24 @@ extern SQLSMALLINT sqlTypes[];
 #define	PG_INTERVAL_AS_SQL_INTERVAL
  */
 
+/*
+ *	The attributes of a type which don't depend on its typmod.
+ *	They are computed once per connection by pgtype_init_type_descs()
+ *	so that the pgtype_attr_xxx() functions can answer with a lookup.
+ */
+typedef struct
+{
+	OID		type;	/* 0 for an empty slot */
+	SQLSMALLINT	concise_type;
+	SQLSMALLINT	ctype;
+	Int4		column_size;
+	Int4		display_size;
+	Int4		buffer_length;
+	Int2		decimal_digits;
+} PGTypeDesc;
+#define	PG_TYPE_DESC_SLOTS	64	/* a power of 2 */
+
+void		pgtype_init_type_descs(ConnectionClass *conn);
 OID		pg_true_type(const ConnectionClass *, OID, OID);
 OID		sqltype_to_pgtype(const ConnectionClass *conn, SQLSMALLINT fSqlType);
 
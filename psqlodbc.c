@@ -40,9 +40,9 @@ GLOBAL_VALUES globals;
 RETCODE SQL_API SQLDummyOrdinal(void);
 
 #if defined(WIN_MULTITHREAD_SUPPORT)
-extern	CRITICAL_SECTION	conns_cs, common_cs;
+extern	CRITICAL_SECTION	common_cs;
 #elif defined(POSIX_MULTITHREAD_SUPPORT)
-extern	pthread_mutex_t 	conns_cs, common_cs;
+extern	pthread_mutex_t 	common_cs;
 
 #ifdef	POSIX_THREADMUTEX_SUPPORT
 #ifdef	PG_RECURSIVE_MUTEXATTR
@@ -90,7 +90,6 @@ int	initialize_global_cs(void)
 #endif /* POSIX_THREADMUTEX_SUPPORT */
 	InitializeLogging();
 	memset(&globals, 0, sizeof(globals));
-	INIT_CONNS_CS;
 	INIT_COMMON_CS;
 
 	return 0;
@@ -143,7 +142,6 @@ void	finalize_globals(GLOBAL_VALUES *glbv)
 static void finalize_global_cs(void)
 {
 	DELETE_COMMON_CS;
-	DELETE_CONNS_CS;
 	finalize_globals(&globals);
 	FinalizeLogging();
 #ifdef	_DEBUG
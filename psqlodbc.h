@@ -309,6 +309,7 @@ BOOL isSqlServr(void);
 #define FETCH_MAX					100 /* default number of rows to cache
 										 * for declare/fetch */
 #define TUPLE_MALLOC_INC			100
+#define TUPLE_CHUNK_SIZE			65536	/* memory block for packed tuple values */
 #define SOCK_BUFFER_SIZE			4096		/* default socket buffer
 												 * size */
 #define MAX_CONNECTIONS				128 /* conns per environment
@@ -372,6 +373,7 @@ typedef struct IPDFields_ IPDFields;
 
 typedef struct col_info COL_INFO;
 typedef struct lo_arg LO_ARG;
+typedef struct lo_buffer LO_BUFFER;
 
 
 /*	pgNAME type define */
@@ -481,6 +483,7 @@ typedef struct StatementOptions_
 	SQLUINTEGER		use_bookmarks;
 	void			*bookmark_ptr;
 	SQLUINTEGER		metadata_id;
+	SQLULEN			stmt_timeout;
 } StatementOptions;
 
 /*	Used to pass extra query info to send_query */
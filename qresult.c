@@ -23,8 +23,97 @@
 #include <stdio.h>
 #include <string.h>
 #include <limits.h>
+#include <stddef.h>
 
 static char QR_read_a_tuple_from_db(QResultClass *, char);
+static BOOL QR_write_spilled_rows(QResultClass *);
+
+/*
+ *	A memory block which holds the tuple values of a result
+ *	with packed tuples one after another.
+ */
+struct TupleChunk_
+{
+	TupleChunk	*next;
+	size_t		size;
+	size_t		used;
+	char		data[1];
+};
+
+/*
+ *	Allocate a value buffer from the chunks of a packed result.
+ */
+static char *
+QR_alloc_value(QResultClass *self, size_t size)
+{
+	TupleChunk	*chunk = self->chunks;
+	char		*value;
+
+	if (NULL == chunk || chunk->used + size > chunk->size)
+	{
+		size_t	alloc_size = (size > TUPLE_CHUNK_SIZE ? size : TUPLE_CHUNK_SIZE);
+
+		if (chunk = (TupleChunk *) malloc(offsetof(TupleChunk, data) + alloc_size), NULL == chunk)
+			return NULL;
+		chunk->size = alloc_size;
+		chunk->used = 0;
+		chunk->next = self->chunks;
+		self->chunks = chunk;
+	}
+	value = chunk->data + chunk->used;
+	chunk->used += size;
+	return value;
+}
+
+/*
+ *	Release the chunks of a packed result. The latest one is
+ *	kept for reuse unless all is TRUE.
+ */
+static void
+QR_free_chunks(QResultClass *self, BOOL all)
+{
+	TupleChunk	*chunk, *next;
+
+	if (NULL == (chunk = self->chunks))
+		return;
+	next = chunk->next;
+	if (all)
+	{
+		free(chunk);
+		self->chunks = NULL;
+	}
+	else
+	{
+		chunk->used = 0;
+		chunk->next = NULL;
+	}
+	for (chunk = next; chunk; chunk = next)
+	{
+		next = chunk->next;
+		free(chunk);
+	}
+}
+
+/*
+ *	Clear tuples in the cache. The values of a packed result
+ *	are owned by its chunks and mustn't be freed one by one.
+ */
+static void
+QR_clear_tuples(QResultClass *self, TupleField *tuple, int num_fields, SQLLEN num_rows)
+{
+	SQLLEN	i;
+
+	if (!QR_has_packed_tuples(self))
+	{
+		ClearCachedRows(tuple, num_fields, num_rows);
+		return;
+	}
+	for (i = 0; i < num_fields * num_rows; i++, tuple++)
+	{
+		tuple->value = NULL;
+		tuple->len = -1;
+	}
+}
 
 /*
  *	Used for building a Manual Result only
@@ -136,6 +225,25 @@ QR_inc_rowstart_in_cache(QResultClass *self, SQLLEN base_inc)
 		self->key_base = self->base;
 }
 
+/*
+ *	Read in the field descriptions of the result. The column info it
+ *	already has, typically shared with the previous result of the same
+ *	statement, is kept if the fields are described alike.
+ */
+char
+QR_read_fields(QResultClass *self, ConnectionClass *conn)
+{
+	ColumnInfoClass	*fields = QR_get_fields(self), *newfields;
+
+	if (0 == CI_get_num_fields(fields))
+		return CI_read_fields(fields, conn);
+	if (newfields = CI_read_fields_again(fields, conn), NULL == newfields)
+		return FALSE;
+	QR_set_fields(self, newfields);
+
+	return TRUE;
+}
+
 void
 QR_set_fields(QResultClass *self, ColumnInfoClass *fields)
 {
@@ -163,6 +271,71 @@ QR_set_fields(QResultClass *self, ColumnInfoClass *fields)
 /*
  * CLASS QResult
  */
+static void
+QR_initialize(QResultClass *rv)
+{
+	rv->rstatus = PORES_EMPTY_QUERY;
+	rv->pstatus = 0;
+	rv->backend_tuples = NULL;
+	rv->sqlstate[0] = '\0';
+	rv->message = NULL;
+	rv->messageref = NULL;
+	rv->command = NULL;
+	rv->notice = NULL;
+	rv->conn = NULL;
+	rv->next = NULL;
+	rv->count_backend_allocated = 0;
+	rv->count_keyset_allocated = 0;
+	rv->num_total_read = 0;
+	rv->num_cached_rows = 0;
+	rv->num_cached_keys = 0;
+	rv->fetch_number = 0;
+	rv->flags = 0; /* must be cleared before calling QR_set_rowstart_in_cache() */
+	QR_set_rowstart_in_cache(rv, -1);
+	rv->key_base = -1;
+	rv->reread_end = -1;
+	rv->recent_processed_row_count = -1;
+	rv->cursTuple = -1;
+	rv->move_offset = 0;
+	rv->num_fields = 0;
+	rv->num_key_fields = PG_NUM_NORMAL_KEYS; /* CTID + OID */
+	rv->tupleField = NULL;
+	rv->cursor_name = NULL;
+	rv->aborted = FALSE;
+
+	rv->cache_size = 0;
+	rv->rowset_size_include_ommitted = 1;
+	rv->move_direction = 0;
+	rv->keyset = NULL;
+	rv->reload_count = 0;
+	rv->rb_alloc = 0;
+	rv->rb_count = 0;
+	rv->dataFilled = FALSE;
+	rv->rollback = NULL;
+	rv->ad_alloc = 0;
+	rv->ad_count = 0;
+	rv->added_keyset = NULL;
+	rv->added_tuples = NULL;
+	rv->up_alloc = 0;
+	rv->up_count = 0;
+	rv->updated = NULL;
+	rv->updated_keyset = NULL;
+	rv->updated_tuples = NULL;
+	rv->dl_alloc = 0;
+	rv->dl_count = 0;
+	rv->deleted = NULL;
+	rv->deleted_keyset = NULL;
+	rv->spill_rows = 0;
+	rv->num_spilled_rows = 0;
+	rv->spill_base = 0;
+	rv->spill_file = NULL;
+	rv->spill_alloc = 0;
+	rv->spill_index = NULL;
+	rv->stream_rows = 0;
+	rv->chunks = NULL;
+	rv->pool_conn = NULL;
+}
+
 QResultClass *
 QR_Constructor(void)
 {
@@ -175,9 +348,6 @@ QR_Constructor(void)
 	{
 		ColumnInfoClass	*fields;
 
-		rv->rstatus = PORES_EMPTY_QUERY;
-		rv->pstatus = 0;
-
 		/* construct the column info */
 		rv->fields = NULL;
 		if (fields = CI_Constructor(), NULL == fields)
@@ -186,60 +356,98 @@ QR_Constructor(void)
 			return NULL;
 		}
 		QR_set_fields(rv, fields);
-		rv->backend_tuples = NULL;
-		rv->sqlstate[0] = '\0';
-		rv->message = NULL;
-		rv->messageref = NULL;
-		rv->command = NULL;
-		rv->notice = NULL;
-		rv->conn = NULL;
-		rv->next = NULL;
-		rv->count_backend_allocated = 0;
-		rv->count_keyset_allocated = 0;
-		rv->num_total_read = 0;
-		rv->num_cached_rows = 0;
-		rv->num_cached_keys = 0;
-		rv->fetch_number = 0;
-		rv->flags = 0; /* must be cleared before calling QR_set_rowstart_in_cache() */
-		QR_set_rowstart_in_cache(rv, -1);
-		rv->key_base = -1;
-		rv->recent_processed_row_count = -1;
-		rv->cursTuple = -1;
-		rv->move_offset = 0;
-		rv->num_fields = 0;
-		rv->num_key_fields = PG_NUM_NORMAL_KEYS; /* CTID + OID */
-		rv->tupleField = NULL;
-		rv->cursor_name = NULL;
-		rv->aborted = FALSE;
-
-		rv->cache_size = 0;
-		rv->rowset_size_include_ommitted = 1;
-		rv->move_direction = 0;
-		rv->keyset = NULL;
-		rv->reload_count = 0;
-		rv->rb_alloc = 0;
-		rv->rb_count = 0;
-		rv->dataFilled = FALSE;
-		rv->rollback = NULL;
-		rv->ad_alloc = 0;
-		rv->ad_count = 0;
-		rv->added_keyset = NULL;
-		rv->added_tuples = NULL;
-		rv->up_alloc = 0;
-		rv->up_count = 0;
-		rv->updated = NULL;
-		rv->updated_keyset = NULL;
-		rv->updated_tuples = NULL;
-		rv->dl_alloc = 0;
-		rv->dl_count = 0;
-		rv->deleted = NULL;
-		rv->deleted_keyset = NULL;
+		QR_initialize(rv);
 	}
 
 	mylog("exit QR_Constructor\n");
 	return rv;
 }
 
+/*
+ *	The results of CC_send_query() are allocated and freed for every
+ *	query. A destroyed one is kept in the pool of its connection
+ *	together with its (emptied) column info unless that is shared with
+ *	other results, and is reused from here.
+ */
+#define	RESULT_POOL_SIZE	16
+
+QResultClass *
+QR_Constructor_from_pool(ConnectionClass *conn)
+{
+	QResultClass *rv;
+
+	CONNLOCK_ACQUIRE(conn);
+	if (rv = conn->result_pool, NULL != rv)
+	{
+		conn->result_pool = rv->next;
+		conn->num_pooled_results--;
+	}
+	CONNLOCK_RELEASE(conn);
+	if (NULL == rv)
+		rv = QR_Constructor();
+	else
+	{
+		mylog("%s: reusing %p\n", __FUNCTION__, rv);
+		if (NULL == QR_get_fields(rv))
+		{
+			ColumnInfoClass	*fields;
+
+			if (fields = CI_Constructor(), NULL == fields)
+			{
+				free(rv);
+				return NULL;
+			}
+			QR_set_fields(rv, fields);
+		}
+		QR_initialize(rv);
+	}
+	if (rv)
+		rv->pool_conn = conn;
+
+	return rv;
+}
+
+static BOOL
+QR_put_in_pool(QResultClass *self)
+{
+	ConnectionClass	*conn = self->pool_conn;
+	ColumnInfoClass	*fields = QR_get_fields(self);
+	BOOL	ret = FALSE;
+
+	if (NULL == fields)
+		return FALSE;
+	CONNLOCK_ACQUIRE(conn);
+	if (conn->num_pooled_results < RESULT_POOL_SIZE)
+	{
+		/* a column info shared with other results isn't pooled */
+		if (fields->refcount > 1)
+			QR_set_fields(self, NULL);
+		else
+			CI_free_memory(fields);
+		self->next = conn->result_pool;
+		conn->result_pool = self;
+		conn->num_pooled_results++;
+		ret = TRUE;
+	}
+	CONNLOCK_RELEASE(conn);
+
+	return ret;
+}
+
+void
+QR_clear_pool(ConnectionClass *conn)
+{
+	QResultClass	*res;
+
+	while (res = conn->result_pool, NULL != res)
+	{
+		conn->result_pool = res->next;
+		QR_set_fields(res, NULL);
+		free(res);
+	}
+	conn->num_pooled_results = 0;
+}
+
 
 void
 QR_close_result(QResultClass *self, BOOL destroy)
@@ -267,6 +475,9 @@ QR_close_result(QResultClass *self, BOOL destroy)
 			}
 		}
 
+		/* skip the tuples still coming from the backend */
+		if (QR_is_streaming(self))
+			QR_stream_tuples(self, -1, 0);
 		QR_free_memory(self);		/* safe to call anyway */
 
 		/*
@@ -277,10 +488,6 @@ QR_close_result(QResultClass *self, BOOL destroy)
 		if (top)
 			QR_set_cursor(self, NULL);
 
-		/* Free up column info */
-		if (destroy)
-			QR_set_fields(self, NULL);
-
 		/* Free command info (this is from strdup()) */
 		if (self->command)
 		{
@@ -304,8 +511,13 @@ QR_close_result(QResultClass *self, BOOL destroy)
 		/* Destruct the result object in the chain */
 		next = self->next;
 		self->next = NULL;
-		if (destroy)
+		if (destroy &&
+		    (NULL == self->pool_conn || !QR_put_in_pool(self)))
+		{
+			/* Free up column info */
+			QR_set_fields(self, NULL);
 			free(self);
+		}
 
 		/* Repeat for the next result in the chain */
 		self = next;
@@ -465,6 +677,68 @@ inolog("QR_AddNew %dth row(%d fields) alloc=%d\n", self->num_cached_rows, QR_Num
 	return self->backend_tuples + num_fields * (self->num_cached_rows - 1);
 }
 
+/*
+ *	Copy a Manual Result (e.g. for the catalog result cache).
+ *	The copy has its own column info and holds the values packed.
+ */
+QResultClass *
+QR_copy_manual(const QResultClass *self)
+{
+	QResultClass	*rv;
+	ColumnInfoClass	*fields, *sfields = QR_get_fields(self);
+	int		i, num_fields = self->num_fields;
+	SQLLEN		num_values = num_fields * self->num_cached_rows, j;
+	const TupleField	*src;
+	TupleField	*dst;
+
+	if (rv = QR_Constructor(), NULL == rv)
+		return NULL;
+	fields = QR_get_fields(rv);
+	CI_set_num_fields(fields, CI_get_num_fields(sfields));
+	if (NULL == fields->coli_array && 0 < fields->num_fields)
+		goto cleanup;
+	for (i = 0; i < CI_get_num_fields(sfields); i++)
+	{
+		CI_set_field_info(fields, i, CI_get_fieldname(sfields, i),
+			CI_get_oid(sfields, i), CI_get_fieldsize(sfields, i),
+			CI_get_atttypmod(sfields, i),
+			CI_get_relid(sfields, i), CI_get_attid(sfields, i));
+		fields->coli_array[i].display_size = CI_get_display_size(sfields, i);
+	}
+	rv->rstatus = self->rstatus;
+	rv->pstatus = self->pstatus;
+	rv->num_fields = self->num_fields;
+	rv->num_total_read = self->num_total_read;
+	rv->ad_count = self->ad_count;
+	QR_set_packed_tuples(rv);
+	if (num_values > 0)
+	{
+		if (rv->backend_tuples = (TupleField *) malloc(num_values * sizeof(TupleField)), NULL == rv->backend_tuples)
+			goto cleanup;
+		rv->count_backend_allocated = self->num_cached_rows;
+		rv->num_cached_rows = self->num_cached_rows;
+		for (j = 0, src = self->backend_tuples, dst = rv->backend_tuples; j < num_values; j++, src++, dst++)
+		{
+			dst->len = src->len;
+			if (NULL == src->value)
+				dst->value = NULL;
+			else
+			{
+				size_t	size = strlen(src->value) + 1;
+
+				if (dst->value = QR_alloc_value(rv, size), NULL == dst->value)
+					goto cleanup;
+				memcpy(dst->value, src->value, size);
+			}
+		}
+	}
+	return rv;
+
+cleanup:
+	QR_Destructor(rv);
+	return NULL;
+}
+
 void
 QR_free_memory(QResultClass *self)
 {
@@ -475,7 +749,7 @@ QR_free_memory(QResultClass *self)
 
 	if (self->backend_tuples)
 	{
-		ClearCachedRows(self->backend_tuples, num_fields, num_backend_rows);
+		QR_clear_tuples(self, self->backend_tuples, num_fields, num_backend_rows);
 		free(self->backend_tuples);
 		self->count_backend_allocated = 0;
 		self->backend_tuples = NULL;
@@ -562,6 +836,21 @@ QR_free_memory(QResultClass *self)
 	}
 	self->up_alloc = 0;
 	self->up_count = 0;
+	/* discard the spilled tuples */
+	if (self->spill_file)
+	{
+		fclose(self->spill_file);
+		self->spill_file = NULL;
+	}
+	if (self->spill_index)
+	{
+		free(self->spill_index);
+		self->spill_index = NULL;
+	}
+	self->spill_alloc = 0;
+	self->num_spilled_rows = 0;
+	self->spill_base = 0;
+	QR_free_chunks(self, TRUE);
 
 	self->num_total_read = 0;
 	self->num_cached_rows = 0;
@@ -615,7 +904,7 @@ QR_fetch_tuples(QResultClass *self, ConnectionClass *conn, const char *cursor, i
 		 *
 		 * $$$$ Should do some error control HERE! $$$$
 		 */
-		if (CI_read_fields(QR_get_fields(self), QR_get_conn(self)))
+		if (QR_read_fields(self, QR_get_conn(self)))
 		{
 			QR_set_rstatus(self, PORES_FIELDS_OK);
 			self->num_fields = CI_get_num_fields(QR_get_fields(self));
@@ -663,7 +952,10 @@ QR_fetch_tuples(QResultClass *self, ConnectionClass *conn, const char *cursor, i
 			self->count_keyset_allocated = tuple_size;
 		}
 
-		QR_set_fetching_tuples(self);
+		if (QR_is_streamed(self))
+			QR_set_streaming(self);
+		else
+			QR_set_fetching_tuples(self);
 
 		/* Force a read to occur in next_tuple */
 		QR_set_num_cached_rows(self, 0);
@@ -671,6 +963,18 @@ QR_fetch_tuples(QResultClass *self, ConnectionClass *conn, const char *cursor, i
 		QR_set_rowstart_in_cache(self, 0);
 		self->key_base = 0;
 
+		/* read only the first tuples of a streamed result now */
+		if (QR_is_streaming(self))
+		{
+			conn->streaming_res = self;
+			if (QR_stream_tuples(self, -1, self->stream_rows))
+				return TRUE;
+			/* the response has been read up to ReadyForQuery */
+			if (NULL != LastMessageType && CONN_DOWN != conn->status)
+				*LastMessageType = 'Z';
+			return FALSE;
+		}
+
 		return QR_next_tuple(self, NULL, LastMessageType);
 	}
 	else
@@ -791,6 +1095,20 @@ QR_get_tupledata(QResultClass *self, BOOL binary)
 inolog("QR_get_tupledata %p->num_fields=%d\n", self, self->num_fields);
 	if (!QR_get_cursor(self))
 	{
+		/*
+		 * Spill the cached tuples to the temporary file when
+		 * the tuple cache reaches its upper limit.
+		 */
+		if (self->spill_rows > 0 &&
+		    self->num_fields > 0 &&
+		    !haskeyset &&
+		    self->num_cached_rows >= self->spill_rows)
+		{
+			if (!QR_write_spilled_rows(self))
+				return FALSE;
+		}
+		if (QR_is_spilled(self) || QR_is_streamed(self))
+			num_total_rows = self->num_cached_rows;
 
 		if (self->num_fields > 0 &&
 		    num_total_rows >= self->count_backend_allocated)
@@ -842,6 +1160,327 @@ inolog("!!cursTup=%d total_read=%d\n", self->cursTuple, self->num_total_read);
 	return TRUE;
 }
 
+/*
+ *	Write the tuples in the cache to the temporary file as a new block
+ *	and clear the cache. Each field is stored as its length (-1 means
+ *	NULL) followed by the data.
+ */
+static BOOL
+QR_write_spilled_rows(QResultClass *self)
+{
+	CSTR	func = "QR_write_spilled_rows";
+	FILE	*fp = self->spill_file;
+	TupleField	*tuple = self->backend_tuples;
+	SQLULEN	i, blkno;
+	int	j, num_fields = self->num_fields;
+	Int4	len;
+
+	if (NULL == fp)
+	{
+		if (fp = tmpfile(), NULL == fp)
+		{
+			QR_set_rstatus(self, PORES_FATAL_ERROR);
+			QR_set_message(self, "Could not create a temporary file to spill tuples.");
+			return FALSE;
+		}
+		self->spill_file = fp;
+		self->num_spilled_rows = 0;
+	}
+	blkno = self->num_spilled_rows / self->spill_rows;
+	if (blkno >= self->spill_alloc)
+	{
+		SQLULEN	alloc = (self->spill_alloc < 1 ? 16 : self->spill_alloc * 2);
+
+		QR_REALLOC_return_with_error(self->spill_index, fpos_t, sizeof(fpos_t) * alloc, self, "Out of memory while spilling tuples.", FALSE);
+		self->spill_alloc = alloc;
+	}
+	if (0 != fseek(fp, 0, SEEK_END) ||
+	    0 != fgetpos(fp, self->spill_index + blkno))
+	{
+		QR_set_rstatus(self, PORES_FATAL_ERROR);
+		QR_set_message(self, "Could not write tuples to the temporary file.");
+		return FALSE;
+	}
+	mylog("%s: block %d (%d rows) from %d\n", func, blkno, self->num_cached_rows, self->num_spilled_rows);
+	for (i = 0; i < self->num_cached_rows; i++)
+	{
+		for (j = 0; j < num_fields; j++, tuple++)
+		{
+			len = (tuple->value ? tuple->len : -1);
+			fwrite(&len, sizeof(len), 1, fp);
+			if (len > 0)
+				fwrite(tuple->value, len, 1, fp);
+		}
+	}
+	if (ferror(fp))
+	{
+		QR_set_rstatus(self, PORES_FATAL_ERROR);
+		QR_set_message(self, "Could not write tuples to the temporary file.");
+		return FALSE;
+	}
+	QR_clear_tuples(self, self->backend_tuples, num_fields, self->num_cached_rows);
+	QR_free_chunks(self, FALSE);
+	self->num_spilled_rows += self->num_cached_rows;
+	self->spill_base = self->num_spilled_rows;
+	QR_set_num_cached_rows(self, 0);
+
+	return TRUE;
+}
+
+/*
+ *	Make sure that the idx-th tuple of a spilled result is in the
+ *	tuple cache, reading the block which contains it back from the
+ *	temporary file if necessary. A streamed result only has the tuples
+ *	read last, so the tuple must be one of them.
+ *	Returns the position of the tuple in backend_tuples or -1 on error.
+ */
+SQLLEN
+QR_spill_locate(QResultClass *self, SQLLEN idx)
+{
+	CSTR	func = "QR_spill_locate";
+	FILE	*fp = self->spill_file;
+	TupleField	*tuple;
+	SQLLEN	start;
+	SQLULEN	i, nrows;
+	int	j, num_fields = self->num_fields;
+	Int4	len;
+
+	if (!QR_is_spilled(self))
+	{
+		/* only the current part of a streamed result is in the cache */
+		if (QR_is_streamed(self))
+		{
+			idx -= self->spill_base;
+			if (idx < 0 || idx >= (SQLLEN) self->num_cached_rows)
+				return -1;
+		}
+		return idx;
+	}
+	if (idx >= self->spill_base &&
+	    idx < self->spill_base + (SQLLEN) self->num_cached_rows)
+		return idx - self->spill_base;
+	if (idx < 0 || idx >= (SQLLEN) QR_get_num_total_read(self))
+		return -1;
+	/* the tail of the result has never been spilled yet */
+	if (self->spill_base >= (SQLLEN) self->num_spilled_rows)
+	{
+		if (!QR_write_spilled_rows(self))
+			return -1;
+	}
+	else
+	{
+		QR_clear_tuples(self, self->backend_tuples, num_fields, self->num_cached_rows);
+		QR_free_chunks(self, FALSE);
+		QR_set_num_cached_rows(self, 0);
+	}
+	start = (idx / self->spill_rows) * self->spill_rows;
+	nrows = self->num_spilled_rows - start;
+	if (nrows > self->spill_rows)
+		nrows = self->spill_rows;
+	if (nrows > self->count_backend_allocated)
+	{
+		QR_REALLOC_return_with_error(self->backend_tuples, TupleField, num_fields * sizeof(TupleField) * nrows, self, "Out of memory while reading spilled tuples.", -1);
+		self->count_backend_allocated = nrows;
+	}
+inolog("%s: reading block from " FORMAT_LEN " (" FORMAT_ULEN " rows) for " FORMAT_LEN "\n", func, start, nrows, idx);
+	if (0 != fsetpos(fp, self->spill_index + idx / self->spill_rows))
+	{
+		QR_set_rstatus(self, PORES_FATAL_ERROR);
+		QR_set_message(self, "Could not read tuples from the temporary file.");
+		return -1;
+	}
+	self->spill_base = start;
+	for (i = 0, tuple = self->backend_tuples; i < nrows; i++)
+	{
+		for (j = 0; j < num_fields; j++, tuple++)
+		{
+			if (1 != fread(&len, sizeof(len), 1, fp))
+				goto read_error;
+			if (len < 0)
+			{
+				tuple->len = 0;
+				tuple->value = NULL;
+				continue;
+			}
+			if (QR_has_packed_tuples(self))
+			{
+				if (NULL == (tuple->value = QR_alloc_value(self, len + 1)))
+				{
+					QR_set_rstatus(self, PORES_NO_MEMORY_ERROR);
+					QR_free_memory(self);
+					QR_set_messageref(self, "Out of memory while reading spilled tuples.");
+					return -1;
+				}
+			}
+			else
+				QR_MALLOC_return_with_error(tuple->value, char, len + 1, self, "Out of memory while reading spilled tuples.", -1);
+			if (len > 0 && 1 != fread(tuple->value, len, 1, fp))
+			{
+				if (!QR_has_packed_tuples(self))
+					free(tuple->value);
+				tuple->value = NULL;
+				goto read_error;
+			}
+			((char *) tuple->value)[len] = '\0';
+			tuple->len = len;
+		}
+		QR_set_num_cached_rows(self, i + 1);
+	}
+
+	return idx - start;
+
+read_error:
+	QR_clear_tuples(self, self->backend_tuples, num_fields, i);
+	QR_clear_tuples(self, self->backend_tuples + i * num_fields, j, 1);
+	QR_set_num_cached_rows(self, 0);
+	QR_set_rstatus(self, PORES_FATAL_ERROR);
+	QR_set_message(self, "Could not read tuples from the temporary file.");
+	return -1;
+}
+
+/*
+ *	Read the tuples of a streamed result which are still coming from
+ *	the backend into the tuple cache.
+ *	The cached tuples before the absolute position keep_from are
+ *	discarded first (keep_from < 0 keeps all of them). Then tuples are
+ *	read until nrows of them are in the cache or the result ends.
+ *	nrows < 0 reads all the remaining tuples and nrows == 0 skips them.
+ *	At the end of the result the rest of the response is read up to
+ *	ReadyForQuery, and the connection is free for other requests.
+ */
+BOOL
+QR_stream_tuples(QResultClass *self, SQLLEN keep_from, SQLLEN nrows)
+{
+	CSTR	func = "QR_stream_tuples";
+	ConnectionClass	*conn = QR_get_conn(self);
+	SocketClass	*sock;
+	SQLLEN	ndrop;
+	int	id, num_fields = self->num_fields;
+	Int4	response_length;
+	BOOL	ret = TRUE, kill_conn = FALSE;
+
+	/* ERROR_MSG_LENGTH is sufficient */
+	char msgbuffer[ERROR_MSG_LENGTH + 1];
+
+	/* QR_set_command() dups this string so doesn't need static */
+	char		cmdbuffer[ERROR_MSG_LENGTH + 1];
+
+	if (!QR_is_streaming(self))
+		return TRUE;
+	if (NULL == conn || NULL == (sock = CC_get_socket(conn)))
+	{
+		QR_set_no_streaming(self);
+		if (NULL != conn && self == conn->streaming_res)
+			conn->streaming_res = NULL;
+		QR_set_rstatus(self, PORES_BAD_RESPONSE);
+		QR_set_message(self, "The connection is lost while reading the tuples");
+		return FALSE;
+	}
+#define	return	DONT_CALL_RETURN_FROM_HERE???
+	ENTER_CONN_CS(conn);
+	if (keep_from >= 0 && num_fields > 0)
+	{
+		ndrop = keep_from - ((SQLLEN) QR_get_num_total_read(self) - (SQLLEN) self->num_cached_rows);
+		if (ndrop > (SQLLEN) self->num_cached_rows)
+			ndrop = self->num_cached_rows;
+		if (ndrop > 0)
+		{
+			QR_clear_tuples(self, self->backend_tuples, num_fields, ndrop);
+			memmove(self->backend_tuples, self->backend_tuples + ndrop * num_fields,
+				sizeof(TupleField) * num_fields * (self->num_cached_rows - ndrop));
+			QR_set_num_cached_rows(self, self->num_cached_rows - ndrop);
+			self->spill_base += ndrop;
+		}
+	}
+inolog("%s: base=" FORMAT_LEN " cached=" FORMAT_ULEN " nrows=" FORMAT_LEN "\n", func, self->spill_base, self->num_cached_rows, nrows);
+	while (QR_is_streaming(self))
+	{
+		if (ret && nrows > 0 && (SQLLEN) self->num_cached_rows >= nrows &&
+		    !QR_once_reached_eof(self))
+			break;
+		id = SOCK_get_id(sock);
+		if (0 != SOCK_get_errcode(sock))
+			break;
+		response_length = SOCK_get_response_length(sock);
+		if (0 != SOCK_get_errcode(sock))
+			break;
+inolog("id='%c' response_length=%d\n", id, response_length);
+		switch (id)
+		{
+			case 'D':			/* Tuples in ASCII format  */
+				if (0 == nrows || !ret || QR_once_reached_eof(self))
+					break;	/* skipped by the next SOCK_get_id() */
+				if (!QR_get_tupledata(self, FALSE))
+					ret = FALSE;
+				break;
+			case 'C':			/* End of tuple list */
+				SOCK_get_string(sock, cmdbuffer, ERROR_MSG_LENGTH);
+				mylog("%s: end of tuple list %s\n", func, cmdbuffer);
+				if (!QR_once_reached_eof(self))
+				{
+					QR_set_command(self, cmdbuffer);
+					QR_set_reached_eof(self);
+					self->dataFilled = TRUE;
+				}
+				break;
+			case 'E':			/* Error */
+				handle_error_message(conn, msgbuffer, sizeof(msgbuffer), self->sqlstate, func, self);
+				mylog("ERROR from backend in %s: '%s'\n", func, msgbuffer);
+				QR_set_reached_eof(self);
+				ret = FALSE;
+				break;
+			case 'N':			/* Notice */
+				handle_notice_message(conn, cmdbuffer, sizeof(cmdbuffer), self->sqlstate, func, self);
+				break;
+			case 'Z':	/* Ready for query */
+				EatReadyForQuery(conn);
+				QR_set_reached_eof(self);
+				QR_set_no_streaming(self);
+				break;
+			case 'S':	/* parameter status */
+				getParameterValues(conn);
+				break;
+			default:
+				/* skip the unexpected response if possible */
+				if (response_length >= 0)
+					break;
+				mylog("%s: Unexpected result from backend: id = '%c' (%d)\n", func, id, id);
+				qlog("%s: Unexpected result from backend: id = '%c' (%d)\n", func, id, id);
+				QR_set_message(self, "Unexpected result from backend. It probably crashed");
+				kill_conn = TRUE;
+				break;
+		}
+		if (kill_conn || CONN_DOWN == conn->status)
+			break;
+	}
+	if (CONN_DOWN == conn->status) /* the socket may have gone already */
+	{
+		QR_set_no_streaming(self);
+		ret = FALSE;
+	}
+	else
+	{
+		if (0 != SOCK_get_errcode(sock))
+		{
+			if (QR_command_maybe_successful(self))
+				QR_set_message(self, "Communication error while getting a tuple");
+			kill_conn = TRUE;
+		}
+		if (kill_conn)
+		{
+			QR_set_rstatus(self, PORES_BAD_RESPONSE);
+			QR_set_no_streaming(self);
+			CC_on_abort(conn, CONN_DEAD);
+			ret = FALSE;
+		}
+	}
+	if (!QR_is_streaming(self) && self == conn->streaming_res)
+		conn->streaming_res = NULL;
+	LEAVE_CONN_CS(conn);
+#undef	return
+	return ret;
+}
+
 static SQLLEN enlargeKeyCache(QResultClass *self, SQLLEN add_size, const char *message)
 {
 	size_t	alloc, alloc_req;
@@ -1170,7 +1809,8 @@ inolog("tupleField=%p\n", self->tupleField);
 			self->cache_size = fetch_size;
 			/* clear obsolete tuples */
 inolog("clear obsolete %d tuples\n", num_backend_rows);
-			ClearCachedRows(tuple, num_fields, num_backend_rows);
+			QR_clear_tuples(self, tuple, num_fields, num_backend_rows);
+			QR_free_chunks(self, FALSE);
 			self->dataFilled = FALSE;
 			QR_stop_movement(self);
 			self->move_offset = 0;
@@ -1625,6 +2265,16 @@ else
 		{
 			if (field_lf >= effective_cols)
 				buffer = tidoidbuf;
+			else if (QR_has_packed_tuples(self))
+			{
+				if (NULL == (buffer = QR_alloc_value(self, len + 1)))
+				{
+					QR_set_rstatus(self, PORES_NO_MEMORY_ERROR);
+					QR_free_memory(self);
+					QR_set_messageref(self, "Out of memory in allocating item buffer.");
+					return FALSE;
+				}
+			}
 			else
 			{
 				QR_MALLOC_return_with_error(buffer, char, len + 1, self, "Out of memory in allocating item buffer.", FALSE);
@@ -48,8 +48,12 @@ enum
 	,FQR_REACHED_EOF = (1L << 1)	/* reached eof */
 	,FQR_HAS_VALID_BASE = (1L << 2)
 	,FQR_NEEDS_SURVIVAL_CHECK = (1L << 3) /* check if the cursor is open */
+	,FQR_STREAMING = (1L << 4)	/* the tuples are still coming from the backend */
+	,FQR_REREAD_ROWSET = (1L << 5)	/* re-read the rows of the rowset by the keys as they are fetched */
 };
 
+typedef struct TupleChunk_ TupleChunk;
+
 struct QResultClass_
 {
 	ColumnInfoClass *fields;	/* the Column information */
@@ -93,6 +97,7 @@ struct QResultClass_
 	SQLULEN		num_cached_keys;	/* count of keys kept in backend_keys member */
 	KeySet		*keyset;
 	SQLLEN		key_base;	/* relative position of rowset start in the current keyset cache */
+	SQLLEN		reread_end;	/* the rows of the rowset before this one are re-read */
 	UInt2		reload_count;
 	UInt2		rb_alloc;	/* count of allocated rollback info */
 	UInt2		rb_count;	/* count of rollback info */
@@ -111,6 +116,16 @@ struct QResultClass_
 	SQLLEN		*updated;	/* updated index info */
 	KeySet		*updated_keyset;	/* uddated keyset info */
 	TupleField	*updated_tuples;	/* uddated data by myself */
+	/* Stuff for spilling tuples of static results to a temporary file */
+	SQLULEN		spill_rows;	/* max count of tuples kept in memory (0 means no spill) */
+	SQLULEN		num_spilled_rows;	/* count of tuples written to the spill file */
+	SQLLEN		spill_base;	/* absolute position of the first tuple in backend_tuples */
+	FILE		*spill_file;	/* temporary file which holds the spilled tuples */
+	SQLULEN		spill_alloc;	/* count of allocated spill_index */
+	fpos_t		*spill_index;	/* positions of the spilled blocks in spill_file */
+	SQLULEN		stream_rows;	/* count of tuples read off the socket at a time (0 means no streaming) */
+	TupleChunk	*chunks;	/* memory blocks holding the packed tuple values */
+	ConnectionClass	*pool_conn;	/* the connection whose pool this is returned to */
 };
 
 enum {
@@ -118,13 +133,17 @@ enum {
 	,FQR_WITHHOLD	= (1L << 1)
 	,FQR_HOLDPERMANENT = (1L << 2) /* the cursor is alive across transactions */
 	,FQR_SYNCHRONIZEKEYS = (1L<<3) /* synchronize the keyset range with that of cthe tuples cache */
+	,FQR_PACKEDTUPLES = (1L<<4) /* the tuple values are packed into chunks instead of being malloced one by one */
 };
 
 #define	QR_haskeyset(self)		(0 != (self->flags & FQR_HASKEYSET))
 #define	QR_is_withhold(self)		(0 != (self->flags & FQR_WITHHOLD))
 #define	QR_is_permanent(self)		(0 != (self->flags & FQR_HOLDPERMANENT))
 #define	QR_synchronize_keys(self)	(0 != (self->flags & FQR_SYNCHRONIZEKEYS))
+#define	QR_has_packed_tuples(self)	(0 != (self->flags & FQR_PACKEDTUPLES))
 #define QR_get_fields(self)		(self->fields)
+#define	QR_is_spilled(self)		(NULL != (self)->spill_file)
+#define	QR_is_streamed(self)		(0 < (self)->stream_rows)
 
 
 /*	These functions are for retrieving data from the qresult */
@@ -162,7 +181,10 @@ enum {
 #define QR_set_aborted(self, aborted_)		( self->aborted = aborted_)
 #define QR_set_haskeyset(self)		(self->flags |= FQR_HASKEYSET)
 #define QR_set_synchronize_keys(self)	(self->flags |= FQR_SYNCHRONIZEKEYS)
+#define QR_set_packed_tuples(self)	(self->flags |= FQR_PACKEDTUPLES)
 #define QR_set_no_cursor(self)		((self)->flags &= ~(FQR_WITHHOLD | FQR_HOLDPERMANENT), (self)->pstatus &= ~FQR_NEEDS_SURVIVAL_CHECK)
+#define QR_set_spill_rows(self, rows)	((self)->spill_rows = ((rows) > 0 ? (rows) : 0))
+#define QR_set_stream_rows(self, rows)	((self)->stream_rows = ((rows) > 0 ? (rows) : 0))
 #define QR_set_withhold(self)		(self->flags |= FQR_WITHHOLD)
 #define QR_set_permanent(self)		(self->flags |= FQR_HOLDPERMANENT)
 #define	QR_set_reached_eof(self)	(self->pstatus |= FQR_REACHED_EOF)
@@ -172,6 +194,10 @@ enum {
 #define QR_set_no_valid_base(self)	(self->pstatus &= ~FQR_HAS_VALID_BASE)
 #define QR_set_survival_check(self)	(self->pstatus |= FQR_NEEDS_SURVIVAL_CHECK)
 #define QR_set_no_survival_check(self)	(self->pstatus &= ~FQR_NEEDS_SURVIVAL_CHECK)
+#define	QR_set_streaming(self)		(self->pstatus |= FQR_STREAMING)
+#define	QR_set_no_streaming(self)	(self->pstatus &= ~FQR_STREAMING)
+#define	QR_set_reread_rowset(self)	(self->pstatus |= FQR_REREAD_ROWSET, self->reread_end = -1)
+#define	QR_set_no_reread_rowset(self)	(self->pstatus &= ~FQR_REREAD_ROWSET)
 #define	QR_inc_num_cache(self) \
 do { \
 	self->num_cached_rows++; \
@@ -202,6 +228,8 @@ do { \
 #define QR_is_fetching_tuples(self)	((self->pstatus & FQR_FETCHING_TUPLES) != 0)
 #define	QR_has_valid_base(self)		(0 != (self->pstatus & FQR_HAS_VALID_BASE))
 #define	QR_needs_survival_check(self)		(0 != (self->pstatus & FQR_NEEDS_SURVIVAL_CHECK))
+#define	QR_is_streaming(self)		(0 != (self->pstatus & FQR_STREAMING))
+#define	QR_needs_reread_rowset(self)	(0 != (self->pstatus & FQR_REREAD_ROWSET))
 
 #define QR_aborted(self)		(!self || self->aborted)
 #define QR_get_reqsize(self)		(self->rowset_size_include_ommitted)
@@ -219,8 +247,11 @@ do { \
 
 /*	Core Functions */
 QResultClass	*QR_Constructor(void);
+QResultClass	*QR_Constructor_from_pool(ConnectionClass *conn);
+void		QR_clear_pool(ConnectionClass *conn);
 void		QR_Destructor(QResultClass *self);
 TupleField	*QR_AddNew(QResultClass *self);
+QResultClass	*QR_copy_manual(const QResultClass *self);
 BOOL		QR_get_tupledata(QResultClass *self, BOOL binary);
 int		QR_next_tuple(QResultClass *self, StatementClass *, int *LastMessageType);
 int			QR_close(QResultClass *self);
@@ -237,6 +268,7 @@ void		QR_add_notice(QResultClass *self, const char *msg);
 
 void		QR_set_num_fields(QResultClass *self, int new_num_fields); /* catalog functions' result only */
 void		QR_set_fields(QResultClass *self, ColumnInfoClass *);
+char		QR_read_fields(QResultClass *self, ConnectionClass *conn);
 
 void		QR_set_num_cached_rows(QResultClass *, SQLLEN);
 void		QR_set_rowstart_in_cache(QResultClass *, SQLLEN);
@@ -245,6 +277,8 @@ void		QR_set_cache_size(QResultClass *self, SQLLEN cache_size);
 void		QR_set_rowset_size(QResultClass *self, Int4 rowset_size);
 void		QR_set_position(QResultClass *self, SQLLEN pos);
 void		QR_set_cursor(QResultClass *self, const char *name);
+SQLLEN		QR_spill_locate(QResultClass *self, SQLLEN idx);
+BOOL		QR_stream_tuples(QResultClass *self, SQLLEN keep_from, SQLLEN nrows);
 SQLLEN		getNthValid(const QResultClass *self, SQLLEN sta, UWORD orientation, SQLULEN nth, SQLLEN *nearest);
 
 #define QR_MALLOC_return_with_error(t, tp, s, a, m, r) \
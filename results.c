@@ -76,7 +76,7 @@ PGAPI_RowCount(HSTMT hstmt,
 		}
 		else if (QR_NumResultCols(res) > 0)
 		{
-			*pcrow = QR_get_cursor(res) ? -1 : QR_get_num_total_tuples(res) - res->dl_count;
+			*pcrow = (QR_get_cursor(res) || QR_is_streaming(res)) ? -1 : QR_get_num_total_tuples(res) - res->dl_count;
 			mylog("RowCount=%d\n", *pcrow);
 			return SQL_SUCCESS;
 		}
@@ -982,6 +982,15 @@ inolog("GetData Column 0 is type %d not of type SQL_C_BOOKMARK", target_type);
 		if (!get_bookmark)
 		{
 			SQLLEN	curt = GIdx2CacheIdx(stmt->currTuple, stmt, res);
+
+			/* the row may have been spilled to the temporary file */
+			if ((QR_is_spilled(res) || QR_is_streamed(res)) &&
+			    (curt = QR_spill_locate(res, curt)) < 0)
+			{
+				SC_set_error(stmt, STMT_EXEC_ERROR, "Couldn't read the spilled tuples", func);
+				result = SQL_ERROR;
+				goto cleanup;
+			}
 			value = QR_get_value_backend_row(res, curt, icol);
 inolog("currT=%d base=%d rowset=%d\n", stmt->currTuple, QR_get_rowstart_in_cache(res), SC_get_rowset_start(stmt));
 			mylog("     value = '%s'\n", NULL_IF_NULL(value));
@@ -1373,6 +1382,7 @@ PGAPI_ExtendedFetch(HSTMT hstmt,
 	SQLLEN		currp;
 	UWORD		pstatus;
 	BOOL		currp_is_valid, reached_eof, useCursor;
+	int		rowset_cols = 0;
 
 	mylog("%s: stmt=%p rowsetSize=%d\n", func, stmt, rowsetSize);
 
@@ -1677,6 +1687,13 @@ inolog("num_tuples=%d\n", num_tuples);
 	}
 	else
 	{
+		/* read the rowset of a streamed result now */
+		if (QR_is_streamed(res))
+		{
+			if (SQL_ERROR == SC_stream_rowset(stmt, rowset_start, rowsetSize))
+				return SQL_ERROR;
+			num_tuples = QR_get_num_total_tuples(res);
+		}
 		/* If *new* rowset is after the result_set, return no data found */
 		if (rowset_start >= num_tuples)
 		{
@@ -1736,6 +1753,21 @@ inolog("num_tuples=%d\n", num_tuples);
 			SC_pos_reload_needed(stmt, req_size, flag);
 		}
 	}
+	else if (res->keyset &&
+		 SQL_CURSOR_KEYSET_DRIVEN == stmt->options.cursor_type)
+	{
+		/*
+		 * The keys come from the cursor along with the rows, a block at
+		 * a time. Re-read the rowset in the same cases as above, as
+		 * SC_fetch() gets its rows into the cache.
+		 */
+		QR_set_no_reread_rowset(res);
+		if (SQL_RD_ON == stmt->options.retrieve_data &&
+		    (fFetchType != SQL_FETCH_NEXT ||
+		     QR_get_rowstart_in_cache(res) < 0 ||
+		     QR_get_rowstart_in_cache(res) + rowsetSize > QR_get_num_cached_tuples(res)))
+			QR_set_reread_rowset(res);
+	}
 	/* Physical Row advancement occurs for each row fetched below */
 
 	mylog("PGAPI_ExtendedFetch: new currTuple = %d\n", stmt->currTuple);
@@ -1743,6 +1775,8 @@ inolog("num_tuples=%d\n", num_tuples);
 	truncated = error = FALSE;
 
 	currp = -1;
+	/* the bound columns which are converted a rowset at a time */
+	rowset_cols = SC_mark_rowset_columns(stmt, rowsetSize);
 	stmt->bind_row = 0;		/* set the binding location */
 	result = SC_fetch(stmt);
 	if (SQL_ERROR == result)
@@ -1824,6 +1858,18 @@ inolog("just skipping deleted row %d\n", currp);
 	}
 	if (SQL_ERROR == result)
 		goto cleanup;
+	if (rowset_cols > 0 && i > 0)
+	{
+		switch (SC_fetch_rowset_columns(stmt, i, rgfRowStatus))
+		{
+			case SQL_ERROR:
+				result = SQL_ERROR;
+				goto cleanup;
+			case SQL_SUCCESS_WITH_INFO:
+				truncated = TRUE;
+				break;
+		}
+	}
 
 	/* Save the fetch count for SQLSetPos */
 	stmt->last_fetch_count = i;
@@ -1863,6 +1909,8 @@ inolog("pcrow=%d\n", i);
 
 cleanup:
 #undef	return
+	if (rowset_cols > 0)
+		SC_unmark_rowset_columns(stmt);
 	if (stmt->internal)
 		result = DiscardStatementSvp(stmt, result, FALSE);
 	return result;
@@ -3036,7 +3084,7 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 	char	*qval = NULL, *sval = NULL;
 	int	keys_per_fetch = 10;
 
-	for (i = SC_get_rowset_start(stmt), kres_ridx = GIdx2KResIdx(i, stmt, res), rowc = 0;; i++)
+	for (i = SC_get_rowset_start(stmt), kres_ridx = GIdx2KResIdx(i, stmt, res), rowc = 0;; i++, kres_ridx++)
 	{
 		if (i >= limitrow)
 		{
@@ -3063,9 +3111,11 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 			qres = CC_send_query(conn, qval, NULL, CREATE_KEYSET, stmt);
 			if (QR_command_maybe_successful(qres))
 			{
-				SQLLEN		j, k, l;
+				SQLLEN		j, k, l, kidx;
 				Int2		m;
 				TupleField	*tuple, *tuplew;
+				UInt4		kblocknum;
+				UInt2		koffset;
 
 				for (j = 0; j < QR_get_num_total_read(qres); j++)
 				{
@@ -3073,7 +3123,14 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 					getTid(qres, j, &blocknum, &offset);
 					for (k = SC_get_rowset_start(stmt); k < limitrow; k++)
 					{
-						if (oid == getOid(res, k))
+						kidx = GIdx2KResIdx(k, stmt, res);
+						if (kidx < 0 ||
+						    0 == (res->keyset[kidx].status & CURS_NEEDS_REREAD))
+							continue;
+						getTid(res, kidx, &kblocknum, &koffset);
+						if (oid == getOid(res, kidx) &&
+						    blocknum == kblocknum &&
+						    offset == koffset)
 						{
 							l = GIdx2CacheIdx(k, stmt, res);
 							tuple = res->backend_tuples + res->num_fields * l;
@@ -3087,7 +3144,7 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 								tuplew->value = NULL;
 								tuplew->len = -1;
 							}
-							res->keyset[k].status &= ~CURS_NEEDS_REREAD;
+							res->keyset[kidx].status &= ~CURS_NEEDS_REREAD;
 							break;
 						}
 					}
@@ -3189,9 +3246,10 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 			}
 			sval = strchr(sval, '\0');
 		}
-		if (0 != (res->keyset[kres_ridx].status & CURS_NEEDS_REREAD))
+		if (kres_ridx >= 0 &&
+		    0 != (res->keyset[kres_ridx].status & CURS_NEEDS_REREAD))
 		{
-			getTid(res, i, &blocknum, &offset);
+			getTid(res, kres_ridx, &blocknum, &offset);
 			if (rowc)
 				sprintf(sval, ",'(%u,%u)'", blocknum, offset);
 			else
@@ -3206,16 +3264,50 @@ static SQLLEN LoadFromKeyset(StatementClass *stmt, QResultClass * res, int rows_
 	return rcnt;
 }
 
+/*
+ *	Re-read the rows from the rowset start up to limitrow which are
+ *	marked CURS_NEEDS_REREAD, several keys per query first and then
+ *	the missing ones one by one.
+ */
+static RETCODE
+reload_marked_rows(StatementClass *stmt, QResultClass *res, int rows_per_fetch, SQLLEN limitrow)
+{
+	RETCODE		ret = SQL_SUCCESS;
+	SQLLEN		i, kres_ridx;
+	UInt2		qcount;
+
+	if (LoadFromKeyset(stmt, res, rows_per_fetch, limitrow) < 0)
+		return SQL_ERROR;
+	for (i = SC_get_rowset_start(stmt), kres_ridx = GIdx2KResIdx(i, stmt, res); i < limitrow; i++, kres_ridx++)
+	{
+		if (kres_ridx < 0)
+			continue;
+		if (0 != (res->keyset[kres_ridx].status & CURS_NEEDS_REREAD))
+		{
+			ret = SC_pos_reload(stmt, i, &qcount, 0);
+			if (SQL_ERROR == ret)
+			{
+				break;
+			}
+			if (SQL_ROW_DELETED == (res->keyset[kres_ridx].status & KEYSET_INFO_PUBLIC))
+			{
+				res->keyset[kres_ridx].status |= CURS_OTHER_DELETED;
+			}
+			res->keyset[kres_ridx].status &= ~CURS_NEEDS_REREAD;
+		}
+	}
+	return ret;
+}
+
 static RETCODE	SQL_API
 SC_pos_reload_needed(StatementClass *stmt, SQLULEN req_size, UDWORD flag)
 {
 	CSTR	func = "SC_pos_reload_needed";
 	Int4		req_rows_size;
 	SQLLEN		i, limitrow;
-	UInt2		qcount;
 	QResultClass	*res;
-	RETCODE		ret = SQL_ERROR;
-	SQLLEN		kres_ridx, rowc;
+	RETCODE		ret;
+	SQLLEN		kres_ridx;
 	Int4		rows_per_fetch;
 	BOOL		create_from_scratch = (0 != flag);
 
@@ -3246,8 +3338,8 @@ SC_pos_reload_needed(StatementClass *stmt, SQLULEN req_size, UDWORD flag)
 	{
 		limitrow = RowIdx2GIdx(req_rows_size, stmt);
 	}
-	if (limitrow > res->num_cached_keys)
-		limitrow = res->num_cached_keys;
+	if (limitrow > KResIdx2GIdx(res->num_cached_keys, stmt, res))
+		limitrow = KResIdx2GIdx(res->num_cached_keys, stmt, res);
 	if (create_from_scratch ||
 	    !res->dataFilled)
 	{
@@ -3274,30 +3366,50 @@ SC_pos_reload_needed(StatementClass *stmt, SQLULEN req_size, UDWORD flag)
 				res->keyset[kres_ridx].status |= CURS_NEEDS_REREAD;
 		}
 	}
-	if (rowc = LoadFromKeyset(stmt, res, rows_per_fetch, limitrow), rowc < 0)
-	{
-		return SQL_ERROR;
-	}
-	for (i = SC_get_rowset_start(stmt), kres_ridx = GIdx2KResIdx(i, stmt, res); i < limitrow; i++)
-	{
-		if (0 != (res->keyset[kres_ridx].status & CURS_NEEDS_REREAD))
-		{
-			ret = SC_pos_reload(stmt, i, &qcount, 0);
-			if (SQL_ERROR == ret)
-			{
-				break;
-			}
-			if (SQL_ROW_DELETED == (res->keyset[kres_ridx].status & KEYSET_INFO_PUBLIC))
-			{
-				res->keyset[kres_ridx].status |= CURS_OTHER_DELETED;
-			}
-			res->keyset[kres_ridx].status &= ~CURS_NEEDS_REREAD;
-		}
-	}
+	ret = reload_marked_rows(stmt, res, rows_per_fetch, limitrow);
 	res->dataFilled = TRUE;
 	return ret;
 }
 
+/*
+ *	Re-read the rows of the rowset of a keyset-driven cursor by their
+ *	keys, from global_ridx up to the end of the rowset or of the cache,
+ *	whichever comes first. The rows and the keys are in the cache as
+ *	they were fetched from the server's cursor, which shows the table
+ *	as of the time it was opened.
+ */
+RETCODE
+SC_pos_reload_rowset(StatementClass *stmt, SQLLEN global_ridx)
+{
+	CSTR	func = "SC_pos_reload_rowset";
+	QResultClass	*res;
+	SQLLEN		i, kres_ridx, limitrow;
+	Int4		req_rows_size;
+
+	mylog("%s: from " FORMAT_LEN "\n", func, global_ridx);
+	if (!(res = SC_get_Curres(stmt)))
+		return SQL_SUCCESS;
+	req_rows_size = QR_get_reqsize(res);
+	limitrow = RowIdx2GIdx(req_rows_size, stmt);
+	if (limitrow > KResIdx2GIdx(res->num_cached_keys, stmt, res))
+		limitrow = KResIdx2GIdx(res->num_cached_keys, stmt, res);
+	res->reread_end = limitrow;
+	if (!res->keyset || global_ridx >= limitrow)
+		return SQL_SUCCESS;
+	if (SC_update_not_ready(stmt))
+		parse_statement(stmt, TRUE);	/* not preferable */
+	if (!SC_is_updatable(stmt))
+		return SQL_SUCCESS;
+	for (i = global_ridx, kres_ridx = GIdx2KResIdx(i, stmt, res); i < limitrow; i++, kres_ridx++)
+	{
+		if (kres_ridx < 0)
+			continue;
+		if (0 == (res->keyset[kres_ridx].status & (CURS_SELF_DELETING | CURS_SELF_DELETED | CURS_OTHER_DELETED)))
+			res->keyset[kres_ridx].status |= CURS_NEEDS_REREAD;
+	}
+	return reload_marked_rows(stmt, res, req_rows_size, limitrow);
+}
+
 static RETCODE	SQL_API
 SC_pos_newload(StatementClass *stmt, const UInt4 *oidint, BOOL tidRef,
 			   const char *tidval)
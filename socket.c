@@ -31,6 +31,7 @@
 
 #include "connection.h"
 
+#include <limits.h>
 #ifdef WIN32
 #include <time.h>
 #include <Wspiapi.h>	/* Ensure to support the backward-compatibility version
@@ -38,6 +39,7 @@
 #else
 #include <stdlib.h>
 #include <string.h>				/* for memset */
+#include <sys/uio.h>				/* for struct iovec */
 #ifdef TIME_WITH_SYS_TIME
 #include <sys/time.h>
 #include <time.h>
@@ -53,6 +55,7 @@
 extern GLOBAL_VALUES globals;
 
 static int SOCK_get_next_n_bytes(SocketClass *s, int n, char *buf);
+static int SOCK_put_next_n_bytes(SocketClass *s, const char *buf, size_t n);
 
 static void SOCK_set_error(SocketClass *s, int _no, const char *_msg)
 {
@@ -97,6 +100,9 @@ SOCK_Constructor(const ConnectionClass *conn)
 		rv->buffer_filled_in = 0;
 		rv->buffer_filled_out = 0;
 		rv->buffer_read_in = 0;
+		rv->conn = conn;
+		rv->deadline = 0;
+		rv->timed_out = FALSE;
 
 		if (conn)
 		{
@@ -613,12 +619,101 @@ cleanup:
 }
 
 
+/*
+ *	Milliseconds from a monotonic clock, which jumps of the wall clock
+ *	don't affect.
+ */
+static SQLBIGINT
+SOCK_get_msec(void)
+{
+#ifdef	WIN32
+	return (SQLBIGINT) GetTickCount64();
+#elif	defined(CLOCK_MONOTONIC)
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (SQLBIGINT) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#else
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return (SQLBIGINT) tv.tv_sec * 1000 + tv.tv_usec / 1000;
+#endif /* WIN32 */
+}
+
+/*
+ *	Arm (timeout > 0) or disarm (timeout == 0) the query timeout.
+ *	While it's armed, SOCK_wait_for_ready() and SOCK_flush_output()
+ *	send a cancel request once the deadline has passed, and the
+ *	socket fails if the response doesn't come within
+ *	SOCK_CANCEL_WAIT_MSEC after that.
+ */
+void
+SOCK_set_query_timeout(SocketClass *self, SQLULEN timeout)
+{
+	if (timeout > INT_MAX)
+		timeout = INT_MAX;
+	self->timed_out = FALSE;
+	self->deadline = (timeout > 0 ? SOCK_get_msec() + (SQLBIGINT) timeout * 1000 : 0);
+}
+
+/*
+ *	Disarm the query timeout and return whether it has expired.
+ */
+BOOL
+SOCK_reset_query_timeout(SocketClass *self)
+{
+	BOOL	timed_out = self->timed_out;
+
+	self->deadline = 0;
+	self->timed_out = FALSE;
+	return timed_out;
+}
+
+/*
+ *	Send a cancel request if the query has run out of its time.
+ *	Returns the milliseconds left until the deadline, -1 if
+ *	there's nothing to wait for, or -2 if the backend didn't
+ *	respond to the cancel request in time.
+ */
+static int
+SOCK_check_deadline(SocketClass *self)
+{
+	CSTR	func = "SOCK_check_deadline";
+	SQLBIGINT	left;
+
+	if (0 == self->deadline)
+		return -1;
+	left = self->deadline - SOCK_get_msec();
+	if (left > 0)
+		return (left < INT_MAX ? (int) left : INT_MAX);
+	if (self->timed_out)
+	{
+		/*
+		 * The backend or the network doesn't respond at all. Give up
+		 * the connection rather than wait forever.
+		 */
+		mylog("%s: no response to the cancel request\n", func);
+		SOCK_set_error(self, SOCKET_READ_TIMEOUT, "The server didn't respond to the cancel request of the query timeout.");
+		return -2;
+	}
+	/*
+	 * Ask the backend to cancel the query and keep waiting for the
+	 * error response for a while.
+	 */
+	mylog("%s: query timeout expired, sending a cancel request\n", func);
+	self->timed_out = TRUE;
+	self->deadline = SOCK_get_msec() + SOCK_CANCEL_WAIT_MSEC;
+	CC_send_cancel_request(self->conn);
+	return SOCK_CANCEL_WAIT_MSEC;
+}
+
 /*
  *	To handle EWOULDBLOCK etc (mainly for libpq non-blocking connection).
  */
 static int SOCK_wait_for_ready(SocketClass *sock, BOOL output, BOOL nowait)
 {
-	int	ret, gerrno;
+	int	ret, gerrno, wait_msec;
 #ifdef	HAVE_POLL
 	struct pollfd	fds;
 #else
@@ -633,11 +728,14 @@ static int SOCK_wait_for_ready(SocketClass *sock, BOOL output, BOOL nowait)
 #endif /* USE_SSL */
 
 	do {
+		wait_msec = (nowait ? -1 : SOCK_check_deadline(sock));
+		if (wait_msec < -1)
+			return -1;
 #ifdef	HAVE_POLL
 		fds.fd = sock->socket;
 		fds.events = output ? POLLOUT : POLLIN;
 		fds.revents = 0;
-		ret = poll(&fds, 1, nowait ? 0 : -1);
+		ret = poll(&fds, 1, nowait ? 0 : wait_msec);
 mylog("!!!  poll ret=%d revents=%x\n", ret, fds.revents);
 #else
 		FD_ZERO(&fds);
@@ -649,10 +747,16 @@ mylog("!!!  poll ret=%d revents=%x\n", ret, fds.revents);
 			tm.tv_sec = 0;
 			tm.tv_usec = 0;
 		}
-		ret = select((int) sock->socket + 1, output ? NULL : &fds, output ? &fds : NULL, &except_fds, nowait ? &tm : NULL);
+		else if (wait_msec >= 0)
+		{
+			tm.tv_sec = wait_msec / 1000;
+			tm.tv_usec = (wait_msec % 1000) * 1000;
+		}
+		ret = select((int) sock->socket + 1, output ? NULL : &fds, output ? &fds : NULL, &except_fds, (nowait || wait_msec >= 0) ? &tm : NULL);
 #endif /* HAVE_POLL */
 		gerrno = SOCK_ERRNO;
-	} while (ret < 0 && EINTR == gerrno);
+	} while ((ret < 0 && EINTR == gerrno) ||
+		 (0 == ret && wait_msec >= 0)); /* woken up by the deadline */
 	return ret;
 }
 
@@ -833,8 +937,6 @@ SOCK_get_n_char(SocketClass *self, char *buffer, Int4 len)
 void
 SOCK_put_n_char(SocketClass *self, const char *buffer, size_t len)
 {
-	size_t			lf;
-
 	if (!self)
 		return;
 	if (!buffer)
@@ -843,12 +945,7 @@ SOCK_put_n_char(SocketClass *self, const char *buffer, size_t len)
 		return;
 	}
 
-	for (lf = 0; lf < len; lf++)
-	{
-		if (0 != self->errornumber)
-			break;
-		SOCK_put_next_byte(self, (UCHAR) buffer[lf]);
-	}
+	SOCK_put_next_n_bytes(self, buffer, len);
 }
 
 
@@ -860,11 +957,40 @@ SOCK_put_n_char(SocketClass *self, const char *buffer, size_t len)
 BOOL
 SOCK_get_string(SocketClass *self, char *buffer, Int4 bufsize)
 {
-	int lf;
+	int		lf, rlen;
+	const UCHAR	*ptr, *term;
 
-	for (lf = 0; lf < bufsize - 1; lf++)
-		if (!(buffer[lf] = SOCK_get_next_byte(self, FALSE)))
+	for (lf = 0; lf < bufsize - 1;)
+	{
+		if (!self)
+		{
+			buffer[lf] = '\0';
+			return FALSE;
+		}
+		if (self->buffer_read_in >= self->buffer_filled_in)
+		{
+			/* reload the buffer */
+			SOCK_get_next_byte(self, TRUE);
+			if (self->buffer_read_in >= self->buffer_filled_in)
+			{
+				buffer[lf] = '\0';
+				return FALSE;
+			}
+		}
+		/* copy the buffered bytes up to the null terminator at once */
+		ptr = self->buffer_in + self->buffer_read_in;
+		rlen = self->buffer_filled_in - self->buffer_read_in;
+		if (rlen > bufsize - 1 - lf)
+			rlen = bufsize - 1 - lf;
+		if (term = memchr(ptr, '\0', rlen), NULL != term)
+			rlen = (int) (term - ptr) + 1;
+		memcpy(buffer + lf, ptr, rlen);
+		self->buffer_read_in += rlen;
+		self->reslen -= rlen;
+		lf += rlen;
+		if (NULL != term)
 			return FALSE;
+	}
 
 	buffer[bufsize - 1] = '\0';
 	return TRUE;
@@ -874,16 +1000,7 @@ SOCK_get_string(SocketClass *self, char *buffer, Int4 bufsize)
 void
 SOCK_put_string(SocketClass *self, const char *string)
 {
-	size_t	lf, len;
-
-	len = strlen(string) + 1;
-
-	for (lf = 0; lf < len; lf++)
-	{
-		if (0 != self->errornumber)
-			break;
-		SOCK_put_next_byte(self, (UCHAR) string[lf]);
-	}
+	SOCK_put_next_n_bytes(self, string, strlen(string) + 1);
 }
 
 int
@@ -987,6 +1104,8 @@ SOCK_flush_output(SocketClass *self)
 		self->buffer_filled_out -= written;
 		ttlsnd += written;
 	}
+	/* the deadline may have passed while the query was being sent */
+	SOCK_check_deadline(self);
 
 	return ttlsnd;
 }
@@ -1164,54 +1283,200 @@ inolog("ECONNRESET\n");
 	return n - rest;
 }
 
-void
-SOCK_put_next_byte(SocketClass *self, UCHAR next_byte)
+/*
+ *	Send len bytes straight from buffer. Returns the number of bytes
+ *	sent, or -1 on error.
+ */
+static int
+SOCK_send_n_bytes(SocketClass *self, const char *buffer, int len)
 {
 	int			bytes_sent, pos = 0;
 	int			gerrno;
 
-	if (!self)
-		return;
-	if (0 != self->errornumber)
-		return;
-	self->buffer_out[self->buffer_filled_out++] = next_byte;
-
-	if (self->buffer_filled_out == self->buffer_size)
+	while (pos < len)
 	{
-		/* buffer is full, so write it out */
-		do
-		{
 #ifdef USE_SSL
-			if (self->ssl)
-				bytes_sent = SOCK_SSL_send(self, (char *) self->buffer_out + pos, self->buffer_filled_out);
-			else
+		if (self->ssl)
+			bytes_sent = SOCK_SSL_send(self, (char *) buffer + pos, len - pos);
+		else
 #endif /* USE_SSL */
+		{
+			bytes_sent = SOCK_SSPI_send(self, buffer + pos, len - pos);
+		}
+		gerrno = SOCK_ERRNO;
+		if (bytes_sent < 0)
+		{
+			switch (gerrno)
 			{
-				bytes_sent = SOCK_SSPI_send(self, (char *) self->buffer_out + pos, self->buffer_filled_out);
+				case	EINTR:
+					continue;
+#ifdef EAGAIN
+				case	EAGAIN:
+#endif /* EAGAIN */
+#if defined(EWOULDBLOCK) && (!defined(EAGAIN) || (EWOULDBLOCK != EAGAIN))
+				case	EWOULDBLOCK:
+#endif /* EWOULDBLOCK */
+					if (SOCK_wait_for_ready(self, TRUE, FALSE) >= 0)
+						continue;
 			}
-			gerrno = SOCK_ERRNO;
-			if (bytes_sent < 0)
+			if (0 == self->errornumber)
+				SOCK_set_error(self, SOCKET_WRITE_ERROR, "Error while writing to the socket.");
+			return -1;
+		}
+		pos += bytes_sent;
+	}
+
+	return pos;
+}
+
+#ifndef	WIN32
+/*
+ *	Send the pending output and len bytes of buffer together with
+ *	sendmsg(), so that the buffer doesn't have to be copied to buffer_out.
+ */
+static int
+SOCK_sendmsg_n_bytes(SocketClass *self, const char *buffer, int len)
+{
+	struct iovec	iov[2];
+	struct msghdr	msg;
+	int		bytes_sent, pos = 0, ttlsnd = 0, ttllen;
+	int		gerrno;
+
+	ttllen = self->buffer_filled_out + len;
+	while (ttlsnd < ttllen)
+	{
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = iov;
+		if (self->buffer_filled_out > 0)
+		{
+			iov[0].iov_base = self->buffer_out + pos;
+			iov[0].iov_len = self->buffer_filled_out;
+			iov[1].iov_base = (char *) buffer;
+			iov[1].iov_len = len;
+			msg.msg_iovlen = 2;
+		}
+		else
+		{
+			iov[0].iov_base = (char *) buffer + (ttlsnd - pos);
+			iov[0].iov_len = ttllen - ttlsnd;
+			msg.msg_iovlen = 1;
+		}
+		bytes_sent = sendmsg(self->socket, &msg, SEND_FLAG);
+		gerrno = SOCK_ERRNO;
+		if (bytes_sent < 0)
+		{
+			switch (gerrno)
 			{
-				switch (gerrno)
-				{
-					case	EINTR:
-						continue;
+				case	EINTR:
+					continue;
 #ifdef EAGAIN
-					case	EAGAIN:
+				case	EAGAIN:
 #endif /* EAGAIN */
 #if defined(EWOULDBLOCK) && (!defined(EAGAIN) || (EWOULDBLOCK != EAGAIN))
-					case	EWOULDBLOCK:
+				case	EWOULDBLOCK:
 #endif /* EWOULDBLOCK */
-						if (SOCK_wait_for_ready(self, TRUE, FALSE) >= 0)
-							continue;
-				}
-				if (0 == self->errornumber)
-					SOCK_set_error(self, SOCKET_WRITE_ERROR, "Error while writing to the socket.");
-				break;
+					if (SOCK_wait_for_ready(self, TRUE, FALSE) >= 0)
+						continue;
 			}
+			if (0 == self->errornumber)
+				SOCK_set_error(self, SOCKET_WRITE_ERROR, "Error while writing to the socket.");
+			return -1;
+		}
+		ttlsnd += bytes_sent;
+		if (self->buffer_filled_out > 0)
+		{
+			if (bytes_sent > self->buffer_filled_out)
+				bytes_sent = self->buffer_filled_out;
 			pos += bytes_sent;
 			self->buffer_filled_out -= bytes_sent;
-		} while (self->buffer_filled_out > 0);
+		}
+	}
+
+	return len;
+}
+#endif /* WIN32 */
+
+/*
+ *	Append n bytes to the output. They are copied to buffer_out while
+ *	they fit, and a larger chunk is sent straight from the caller's
+ *	memory together with the pending output.
+ */
+static int
+SOCK_put_next_n_bytes(SocketClass *self, const char *buf, size_t n)
+{
+	size_t		rest, clen;
+	int		slen, room;
+	BOOL		plain_socket = TRUE;
+
+	if (!self)
+		return -1;
+#ifdef USE_SSL
+	if (self->ssl)
+		plain_socket = FALSE;
+#endif /* USE_SSL */
+#ifdef	USE_SSPI
+	if (self->sspisvcs && self->ssd)
+		plain_socket = FALSE;
+#endif /* USE_SSPI */
+	for (rest = n; rest > 0;)
+	{
+		if (0 != self->errornumber)
+			return -1;
+		if (rest >= (size_t) self->buffer_size)
+		{
+			slen = (rest > INT_MAX / 2) ? INT_MAX / 2 : (int) rest;
+#ifndef	WIN32
+			if (plain_socket)
+			{
+				if (SOCK_sendmsg_n_bytes(self, buf, slen) < 0)
+					return -1;
+			}
+			else
+#endif /* WIN32 */
+			{
+				if (self->buffer_filled_out > 0 &&
+				    SOCK_send_n_bytes(self, (char *) self->buffer_out, self->buffer_filled_out) < 0)
+					return -1;
+				self->buffer_filled_out = 0;
+				if (SOCK_send_n_bytes(self, buf, slen) < 0)
+					return -1;
+			}
+			buf += slen;
+			rest -= slen;
+			continue;
+		}
+		room = self->buffer_size - self->buffer_filled_out;
+		clen = (rest < (size_t) room) ? rest : (size_t) room;
+		memcpy(self->buffer_out + self->buffer_filled_out, buf, clen);
+		self->buffer_filled_out += (int) clen;
+		buf += clen;
+		rest -= clen;
+		if (self->buffer_filled_out == self->buffer_size)
+		{
+			/* buffer is full, so write it out */
+			if (SOCK_send_n_bytes(self, (char *) self->buffer_out, self->buffer_filled_out) < 0)
+				return -1;
+			self->buffer_filled_out = 0;
+		}
+	}
+
+	return (int) n;
+}
+
+void
+SOCK_put_next_byte(SocketClass *self, UCHAR next_byte)
+{
+	if (!self)
+		return;
+	if (0 != self->errornumber)
+		return;
+	self->buffer_out[self->buffer_filled_out++] = next_byte;
+
+	if (self->buffer_filled_out == self->buffer_size)
+	{
+		/* buffer is full, so write it out */
+		if (SOCK_send_n_bytes(self, (char *) self->buffer_out, self->buffer_filled_out) >= 0)
+			self->buffer_filled_out = 0;
 	}
 }
 
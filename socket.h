@@ -10,6 +10,7 @@
 #define __SOCKET_H__
 
 #include "psqlodbc.h"
+#include <time.h>
 #if defined (USE_GSS)
 #ifdef	HAVE_GSSAPI_H
 #include <gssapi.h>
@@ -141,6 +142,10 @@ typedef int (WSAAPI *inet_pton_func) (int, const char *, void *);
 #define SOCKET_READ_TIMEOUT			11
 #define SOCKET_WRITE_TIMEOUT			12
 
+#define SOCK_CANCEL_WAIT_MSEC	10000	/* how long to wait for the response
+					   to a cancel request of a query
+					   timeout before giving up */
+
 
 struct SocketClass_
 {
@@ -180,6 +185,13 @@ struct SocketClass_
 	char		keepalive;	/* TCP keepalive */
 	int		keepalive_idle;
 	int		keepalive_interval;
+
+	const ConnectionClass	*conn;	/* used to send a cancel request */
+	SQLBIGINT	deadline;	/* when the running query times out in msec of
+				   a monotonic clock, or 0 */
+	BOOL		timed_out;	/* the deadline has passed and cancel was sent,
+				   the deadline is then the end of the wait
+				   for its response */
 };
 
 #define SOCK_get_char(self)	(SOCK_get_next_byte(self, FALSE))
@@ -236,5 +248,7 @@ Int4		SOCK_flush_output(SocketClass *self);
 UCHAR		SOCK_get_next_byte(SocketClass *self, BOOL peek);
 void		SOCK_put_next_byte(SocketClass *self, UCHAR next_byte);
 Int4		SOCK_get_response_length(SocketClass *self);
+void		SOCK_set_query_timeout(SocketClass *self, SQLULEN timeout);
+BOOL		SOCK_reset_query_timeout(SocketClass *self);
 
 #endif /* __SOCKET_H__ */
@@ -376,12 +376,85 @@ static void SC_init_parse_method(StatementClass *self)
 		SC_set_parse_tricky(self);
 }
 
+/*
+ *	Dropped statements are kept in a pool of the connection, so that
+ *	applications (and the driver itself) which allocate a statement per
+ *	query don't have to allocate the statement, its critical section
+ *	and its SQLGetData array again.
+ */
+#define	STMT_POOL_SIZE	16
+
+static StatementClass *
+SC_get_from_pool(ConnectionClass *conn)
+{
+	StatementClass	*stmt;
+
+	CONNLOCK_ACQUIRE(conn);
+	if (stmt = conn->stmt_pool, NULL != stmt)
+	{
+		conn->stmt_pool = stmt->next_pooled;
+		conn->num_pooled_stmts--;
+	}
+	CONNLOCK_RELEASE(conn);
+
+	return stmt;
+}
+
+static BOOL
+SC_put_in_pool(ConnectionClass *conn, StatementClass *self)
+{
+	BOOL	ret = FALSE;
+
+	CONNLOCK_ACQUIRE(conn);
+	if (conn->num_pooled_stmts < STMT_POOL_SIZE)
+	{
+		self->next_pooled = conn->stmt_pool;
+		conn->stmt_pool = self;
+		conn->num_pooled_stmts++;
+		ret = TRUE;
+	}
+	CONNLOCK_RELEASE(conn);
+
+	return ret;
+}
+
+static void
+SC_free_block(StatementClass *self)
+{
+	GDATA_unbind_cols(SC_get_GDTI(self), TRUE);
+	DELETE_STMT_CS(self);
+	free(self);
+}
+
+void
+SC_clear_pool(ConnectionClass *conn)
+{
+	StatementClass	*stmt;
+
+	while (stmt = conn->stmt_pool, NULL != stmt)
+	{
+		conn->stmt_pool = stmt->next_pooled;
+		SC_free_block(stmt);
+	}
+	conn->num_pooled_stmts = 0;
+}
+
 StatementClass *
 SC_Constructor(ConnectionClass *conn)
 {
 	StatementClass *rv;
+	BOOL	pooled;
 
-	rv = (StatementClass *) malloc(sizeof(StatementClass));
+	if (rv = SC_get_from_pool(conn), NULL != rv)
+	{
+		mylog("SC_Constructor: reusing %p\n", rv);
+		pooled = TRUE;
+	}
+	else
+	{
+		rv = (StatementClass *) malloc(sizeof(StatementClass));
+		pooled = FALSE;
+	}
 	if (rv)
 	{
 		rv->hdbc = conn;
@@ -427,9 +500,12 @@ SC_Constructor(ConnectionClass *conn)
 		rv->lock_CC_for_rb = 0;
 		rv->join_info = 0;
 		rv->curr_param_result = 0;
+		rv->cols_info_kept = FALSE;
+		rv->last_fields = NULL;
 		SC_init_parse_method(rv);
 
 		rv->lobj_fd = -1;
+		LO_BUFFER_init(&rv->lobj_buf);
 		INIT_NAME(rv->cursor_name);
 
 		/* Parse Stuff */
@@ -464,9 +540,13 @@ SC_Constructor(ConnectionClass *conn)
 		rv->allocated_callbacks = 0;
 		rv->num_callbacks = 0;
 		rv->callbacks = NULL;
-		GetDataInfoInitialize(SC_get_GDTI(rv));
+		rv->next_pooled = NULL;
+		/* a pooled statement keeps its (reset) SQLGetData array */
+		if (!pooled)
+			GetDataInfoInitialize(SC_get_GDTI(rv));
 		PutDataInfoInitialize(SC_get_PDTI(rv));
-		INIT_STMT_CS(rv);
+		if (!pooled)
+			INIT_STMT_CS(rv);
 	}
 	return rv;
 }
@@ -476,8 +556,10 @@ SC_Destructor(StatementClass *self)
 {
 	CSTR func	= "SC_Destrcutor";
 	QResultClass	*res = SC_get_Result(self);
+	ConnectionClass	*conn;
 
 	if (!self)	return FALSE;
+	conn = SC_get_conn(self);
 	mylog("SC_Destructor: self=%p, self->result=%p, self->hdbc=%p\n", self, res, self->hdbc);
 	SC_clear_error(self);
 	if (STMT_EXECUTING == self->status)
@@ -505,7 +587,7 @@ SC_Destructor(StatementClass *self)
 	DC_Destructor((DescriptorClass *) SC_get_APDi(self));
 	DC_Destructor((DescriptorClass *) SC_get_IRDi(self));
 	DC_Destructor((DescriptorClass *) SC_get_IPDi(self));
-	GDATA_unbind_cols(SC_get_GDTI(self), TRUE);
+	GDATA_unbind_cols(SC_get_GDTI(self), FALSE);
 	PDATA_free_params(SC_get_PDTI(self), STMT_FREE_PARAMS_ALL);
 
 	if (self->__error_message)
@@ -515,9 +597,11 @@ SC_Destructor(StatementClass *self)
 	cancelNeedDataState(self);
 	if (self->callbacks)
 		free(self->callbacks);
+	LO_BUFFER_free(&self->lobj_buf);
 
-	DELETE_STMT_CS(self);
-	free(self);
+	/* A statement detached from its connection isn't kept */
+	if (NULL == conn || !SC_put_in_pool(conn, self))
+		SC_free_block(self);
 
 	mylog("SC_Destructor: EXIT\n");
 
@@ -735,6 +819,7 @@ SC_initialize_stmts(StatementClass *self, BOOL initializeOriginal)
 		self->join_info = 0;
 		SC_init_parse_method(self);
 		SC_init_discard_output_params(self);
+		SC_set_last_fields(self, NULL);
 	}
 	if (self->stmt_with_params)
 	{
@@ -812,6 +897,38 @@ SC_reset_result_for_rerun(StatementClass *self)
 	}
 }
 
+/*
+ *	Keep the column info of the statement's result, so that the result
+ *	of the next execution can share it if the fields are described alike.
+ */
+void
+SC_set_last_fields(StatementClass *self, ColumnInfoClass *fields)
+{
+	ColumnInfoClass	*curfields = self->last_fields;
+
+	if (self->cols_info_kept)
+	{
+		self->cols_info_kept = FALSE;
+		if (fields != curfields)
+		{
+			SC_initialize_cols_info(self, TRUE, TRUE);
+			SC_clear_parse_status(self, SC_get_conn(self));
+		}
+	}
+	if (fields == curfields)
+		return;
+	if (NULL != curfields)
+	{
+		if (curfields->refcount > 1)
+			curfields->refcount--;
+		else
+			CI_Destructor(curfields);
+	}
+	self->last_fields = fields;
+	if (NULL != fields)
+		fields->refcount++;
+}
+
 /*
  *	Called from SQLPrepare if STMT_PREMATURE, or
  *	from SQLExecute if STMT_FINISHED, or
@@ -872,6 +989,16 @@ SC_recycle_statement(StatementClass *self)
 	{
 		case NOT_YET_PREPARED:
 		case ONCE_DESCRIBED:
+			/*
+			 * The parsed table/field information is still valid if
+			 * the next result is described alike. SC_set_last_fields()
+			 * frees it otherwise.
+			 */
+			if (NULL != self->last_fields)
+			{
+				self->cols_info_kept = TRUE;
+				break;
+			}
 			/* Free the parsed table/field information */
 			SC_initialize_cols_info(self, TRUE, TRUE);
 
@@ -915,6 +1042,7 @@ inolog("%s statement=%p ommitted=0\n", func, self);
 	self->__error_number = 0;
 
 	self->lobj_fd = -1;
+	LO_BUFFER_reset(&self->lobj_buf);
 
 	/*
 	 * Free any data at exec params before the statement is executed
@@ -1281,7 +1409,8 @@ static const struct
 	{ STMT_COUNT_FIELD_INCORRECT, "07002", "07002" },
 	{ STMT_INVALID_NULL_ARG, "HY009", "S1009" },
 	{ STMT_NO_RESPONSE, "08S01", "08S01" },
-	{ STMT_COMMUNICATION_ERROR, "08S01", "08S01" }
+	{ STMT_COMMUNICATION_ERROR, "08S01", "08S01" },
+	{ STMT_QUERY_TIMEOUT_EXPIRED, "HYT00", "S1T00" }
 };
 
 static PG_ErrorInfo *
@@ -1618,6 +1747,87 @@ SC_get_bookmark(StatementClass *self)
 }
 
 
+/*
+ * Map the return value of copy_and_convert_field() for the column lf
+ * to the result of the fetch.
+ */
+static RETCODE
+SC_copy_retval_to_result(StatementClass *self, int retval, int lf, const char *value, RETCODE result)
+{
+	CSTR func = "SC_fetch";
+
+	switch (retval)
+	{
+		case COPY_OK:
+			break;		/* OK, do next bound column */
+
+		case COPY_UNSUPPORTED_TYPE:
+			SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR, "Received an unsupported type from Postgres.", func);
+			result = SQL_ERROR;
+			break;
+
+		case COPY_UNSUPPORTED_CONVERSION:
+			SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR, "Couldn't handle the necessary data type conversion.", func);
+			result = SQL_ERROR;
+			break;
+
+		case COPY_RESULT_TRUNCATED:
+			SC_set_error(self, STMT_TRUNCATED, "Fetched item was truncated.", func);
+			qlog("The %dth item was truncated\n", lf + 1);
+			qlog("The buffer size = %d", SC_get_ARDF(self)->bindings[lf].buflen);
+			if (value)
+				qlog(" and the value is '%s'", value);
+			qlog("\n");
+			result = SQL_SUCCESS_WITH_INFO;
+			break;
+
+			/* error msg already filled in */
+		case COPY_GENERAL_ERROR:
+			result = SQL_ERROR;
+			break;
+
+			/* This would not be meaningful in SQLFetch. */
+		case COPY_NO_DATA_FOUND:
+			break;
+
+		default:
+			SC_set_error(self, STMT_INTERNAL_ERROR, "Unrecognized return value from copy_and_convert_field.", func);
+			result = SQL_ERROR;
+			break;
+	}
+
+	return result;
+}
+
+/*
+ * Make sure that the nrows rows from the position start of a streamed
+ * result are in the cache if the result has them, reading the next
+ * rows off the socket and dropping those before start.
+ */
+RETCODE
+SC_stream_rowset(StatementClass *self, SQLLEN start, SQLLEN nrows)
+{
+	CSTR func = "SC_stream_rowset";
+	QResultClass	*res = SC_get_Curres(self);
+
+	if (start < 0)
+		start = 0;
+	if (QR_is_streaming(res) &&
+	    start + nrows > (SQLLEN) QR_get_num_total_read(res))
+	{
+		if (nrows < (SQLLEN) res->stream_rows)
+			nrows = res->stream_rows;
+		QR_stream_tuples(res, start, nrows);
+	}
+	if (!QR_command_maybe_successful(res))
+	{
+		SC_set_error(self, STMT_EXEC_ERROR, QR_get_message(res), func);
+		return SQL_ERROR;
+	}
+
+	return SQL_SUCCESS;
+}
+
 RETCODE
 SC_fetch(StatementClass *self)
 {
@@ -1636,6 +1846,7 @@ SC_fetch(StatementClass *self)
 	ColumnInfoClass *coli;
 	BindInfoClass	*bookmark;
 	BOOL		useCursor;
+	SQLLEN		curt = -1;
 
 	/* TupleField *tupleField; */
 
@@ -1650,6 +1861,9 @@ inolog("%s statement=%p res=%x ommitted=0\n", func, self, res);
 	useCursor = (SC_is_fetchcursor(self) && (NULL != QR_get_cursor(res)));
 	if (!useCursor)
 	{
+		if (QR_is_streamed(res) &&
+		    SQL_ERROR == SC_stream_rowset(self, SC_get_rowset_start(self), self->currTuple + 2 - SC_get_rowset_start(self)))
+			return SQL_ERROR;
 		if (self->currTuple >= (Int4) QR_get_num_total_tuples(res) - 1 ||
 			(self->options.maxRows > 0 && self->currTuple == self->options.maxRows - 1))
 		{
@@ -1680,7 +1894,18 @@ inolog("%s statement=%p res=%x ommitted=0\n", func, self, res);
 			return SQL_NO_DATA_FOUND;
 		}
 		else if (retval > 0)
+		{
 			(self->currTuple)++;	/* all is well */
+			/*
+			 * Re-read the rows of the rowset which are in the cache by
+			 * now. The rest of a rowset which doesn't fit in the cache
+			 * is read in later, and re-read then.
+			 */
+			if (QR_needs_reread_rowset(res) &&
+			    self->currTuple >= res->reread_end &&
+			    SQL_ERROR == SC_pos_reload_rowset(self, self->currTuple))
+				return SQL_ERROR;
+		}
 		else
 		{
 			ConnectionClass *conn = SC_get_conn(self);
@@ -1766,6 +1991,17 @@ inolog("%s: stmt=%p ommitted++\n", func, self);
 
 	if (self->options.retrieve_data == SQL_RD_OFF)		/* data isn't required */
 		return SQL_SUCCESS;
+	if (!useCursor)
+	{
+		curt = GIdx2CacheIdx(self->currTuple, self, res);
+		/* the row may have been spilled to the temporary file */
+		if ((QR_is_spilled(res) || QR_is_streamed(res)) &&
+		    (curt = QR_spill_locate(res, curt)) < 0)
+		{
+			SC_set_error(self, STMT_EXEC_ERROR, "Couldn't read the spilled tuples", func);
+			return SQL_ERROR;
+		}
+	}
 	/* The following adjustment would be needed after SQLMoreResults() */
 	if (opts->allocated < num_cols)
 		extend_column_bindings(opts, num_cols);
@@ -1781,6 +2017,9 @@ inolog("%s: stmt=%p ommitted++\n", func, self);
 
 		if (NULL == opts->bindings)
 			continue;
+		/* converted later by SC_fetch_rowset_columns() */
+		if (gdata->gdata[lf].rowset_convert)
+			continue;
 		if (opts->bindings[lf].buffer != NULL)
 		{
 			/* this column has a binding */
@@ -1795,7 +2034,6 @@ inolog("%s: stmt=%p ommitted++\n", func, self);
 				value = QR_get_value_backend(res, lf);
 			else
 			{
-				SQLLEN	curt = GIdx2CacheIdx(self->currTuple, self, res);
 inolog("%p->base=%d curr=%d st=%d valid=%d\n", res, QR_get_rowstart_in_cache(res), self->currTuple, SC_get_rowset_start(self), QR_has_valid_base(res));
 inolog("curt=%d\n", curt);
 				value = QR_get_value_backend_row(res, curt, lf);
@@ -1807,42 +2045,126 @@ inolog("curt=%d\n", curt);
 
 			mylog("copy_and_convert: retval = %d\n", retval);
 
-			switch (retval)
-			{
-				case COPY_OK:
-					break;		/* OK, do next bound column */
+			result = SC_copy_retval_to_result(self, retval, lf, value, result);
+		}
+	}
 
-				case COPY_UNSUPPORTED_TYPE:
-					SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR, "Received an unsupported type from Postgres.", func);
-					result = SQL_ERROR;
-					break;
+	return result;
+}
 
-				case COPY_UNSUPPORTED_CONVERSION:
-					SC_set_error(self, STMT_RESTRICTED_DATA_TYPE_ERROR, "Couldn't handle the necessary data type conversion.", func);
-					result = SQL_ERROR;
-					break;
+/*
+ * Mark the bound columns which SC_fetch() should leave to
+ * SC_fetch_rowset_columns(), so that they are converted a column at
+ * a time for the whole rowset. This is only done for the column-wise
+ * bindings of static results held in the cache.
+ * Returns the number of the marked columns.
+ */
+int
+SC_mark_rowset_columns(StatementClass *self, SQLLEN rowsetSize)
+{
+	QResultClass	*res = SC_get_Curres(self);
+	ARDFields	*opts = SC_get_ARDF(self);
+	GetDataInfo	*gdata = SC_get_GDTI(self);
+	ColumnInfoClass	*coli;
+	BindInfoClass	*bic;
+	int		lf, num_cols, marked = 0;
+
+	if (rowsetSize <= 1 || !res || !opts->bindings || opts->bind_size > 0)
+		return 0;
+	if (SQL_RD_OFF == self->options.retrieve_data)
+		return 0;
+	if (NULL != res->keyset ||
+	    (SC_is_fetchcursor(self) && NULL != QR_get_cursor(res)))
+		return 0;
+	if (gdata->allocated != opts->allocated)
+		extend_getdata_info(gdata, opts->allocated, TRUE);
+	coli = QR_get_fields(res);
+	num_cols = QR_NumPublicResultCols(res);
+	if (num_cols > gdata->allocated)
+		num_cols = gdata->allocated;
+	for (lf = 0; lf < num_cols; lf++)
+	{
+		bic = &opts->bindings[lf];
+		if (NULL != bic->buffer &&
+		    copy_and_convert_column_available(self, CI_get_oid(coli, lf), bic->returntype))
+		{
+			gdata->gdata[lf].rowset_convert = TRUE;
+			marked++;
+		}
+	}
+	mylog("%s: %d columns are converted a rowset at a time\n", __FUNCTION__, marked);
 
-				case COPY_RESULT_TRUNCATED:
-					SC_set_error(self, STMT_TRUNCATED, "Fetched item was truncated.", func);
-					qlog("The %dth item was truncated\n", lf + 1);
-					qlog("The buffer size = %d", opts->bindings[lf].buflen);
-					qlog(" and the value is '%s'\n", value);
-					result = SQL_SUCCESS_WITH_INFO;
-					break;
+	return marked;
+}
 
-					/* error msg already filled in */
-				case COPY_GENERAL_ERROR:
-					result = SQL_ERROR;
-					break;
+void
+SC_unmark_rowset_columns(StatementClass *self)
+{
+	GetDataInfo	*gdata = SC_get_GDTI(self);
+	int		lf;
 
-					/* This would not be meaningful in SQLFetch. */
-				case COPY_NO_DATA_FOUND:
-					break;
+	for (lf = 0; lf < gdata->allocated; lf++)
+		gdata->gdata[lf].rowset_convert = FALSE;
+}
 
-				default:
-					SC_set_error(self, STMT_INTERNAL_ERROR, "Unrecognized return value from copy_and_convert_field.", func);
-					result = SQL_ERROR;
-					break;
+/*
+ * Convert the columns marked by SC_mark_rowset_columns() for the
+ * nrows rows fetched from the rowset start. The rows are processed in
+ * runs which are contiguous in the cache, and a column at a time
+ * within each run.
+ * As with SC_fetch() for a row, a row which fails to convert is marked
+ * SQL_ROW_ERROR in rowStatus, and the rest of the rowset is still
+ * fetched with SQL_SUCCESS_WITH_INFO.
+ */
+RETCODE
+SC_fetch_rowset_columns(StatementClass *self, SQLLEN nrows, SQLUSMALLINT *rowStatus)
+{
+	CSTR func = "SC_fetch_rowset_columns";
+	QResultClass	*res = SC_get_Curres(self);
+	ColumnInfoClass	*coli = QR_get_fields(res);
+	GetDataInfo	*gdata = SC_get_GDTI(self);
+	RETCODE		result = SQL_SUCCESS;
+	SQLLEN		row, run, curt;
+	int		lf, num_cols, retval, row_error;
+
+	num_cols = QR_NumPublicResultCols(res);
+	if (num_cols > gdata->allocated)
+		num_cols = gdata->allocated;
+	for (row = 0; row < nrows; row += run)
+	{
+		curt = GIdx2CacheIdx(SC_get_rowset_start(self) + row, self, res);
+		/* the row may have been spilled to the temporary file */
+		if ((QR_is_spilled(res) || QR_is_streamed(res)) &&
+		    (curt = QR_spill_locate(res, curt)) < 0)
+		{
+			SC_set_error(self, STMT_EXEC_ERROR, "Couldn't read the spilled tuples", func);
+			return SQL_ERROR;
+		}
+		run = QR_get_num_cached_tuples(res) - curt;
+		if (curt < 0 || run <= 0)
+		{
+			SC_set_error(self, STMT_INTERNAL_ERROR, "the rowset is not in the cache", func);
+			return SQL_ERROR;
+		}
+		if (run > nrows - row)
+			run = nrows - row;
+inolog("%s: row=" FORMAT_LEN " curt=" FORMAT_LEN " run=" FORMAT_LEN "\n", func, row, curt, run);
+		for (lf = 0; lf < num_cols; lf++)
+		{
+			if (!gdata->gdata[lf].rowset_convert)
+				continue;
+			row_error = COPY_OK;
+			retval = copy_and_convert_column(self,
+					CI_get_oid(coli, lf), CI_get_atttypmod(coli, lf),
+					res->backend_tuples + curt * res->num_fields + lf,
+					res->num_fields, lf, (SQLSETPOSIROW) row, run,
+					rowStatus, &row_error);
+			result = SC_copy_retval_to_result(self, retval, lf, NULL, result);
+			if (COPY_OK != row_error)
+			{
+				/* the diagnostics of the failed rows */
+				SC_copy_retval_to_result(self, row_error, lf, NULL, SQL_ERROR);
+				result = SQL_SUCCESS_WITH_INFO;
 			}
 		}
 	}
@@ -1852,6 +2174,33 @@ inolog("curt=%d\n", curt);
 
 
 #include "dlg_specific.h"
+
+/*
+ *	Has the query been cancelled because it ran out of the query timeout ?
+ *	The backend reports 57014 for it, which is forgotten so that HYT00 is
+ *	returned instead.
+ */
+static BOOL
+SC_query_timed_out(const StatementClass *self, QResultClass *res, BOOL cancel_sent)
+{
+	BOOL	timed_out = FALSE;
+
+	if (0 == self->options.stmt_timeout)
+		return FALSE;
+	if (!cancel_sent &&
+	    0 >= SC_get_conn(self)->connInfo.server_side_timeout)
+		return FALSE;
+	for (; NULL != res; res = res->next)
+	{
+		if (strncmp(res->sqlstate, "57014", 5) == 0)
+		{
+			res->sqlstate[0] = '\0';
+			timed_out = TRUE;
+		}
+	}
+	return timed_out;
+}
+
 RETCODE
 SC_execute(StatementClass *self)
 {
@@ -1869,7 +2218,7 @@ SC_execute(StatementClass *self)
 	BOOL		is_in_trans, issue_begin, has_out_para;
 	BOOL		use_extended_protocol;
 	int		func_cs_count = 0, i;
-	BOOL		useCursor, isSelectType;
+	BOOL		useCursor, isSelectType, cancel_sent = FALSE;
 
 	conn = SC_get_conn(self);
 	ci = &(conn->connInfo);
@@ -1952,6 +2301,12 @@ SC_execute(StatementClass *self)
 	}
 	conn->status = CONN_EXECUTING;
 
+	/* Arm the query timeout */
+	if (0 < ci->server_side_timeout)
+		CC_set_statement_timeout(conn, self->options.stmt_timeout);
+	else if (self->options.stmt_timeout > 0 && conn->sock)
+		SOCK_set_query_timeout(conn->sock, self->options.stmt_timeout);
+
 	/* If it's a SELECT statement, use a cursor. */
 
 	/*
@@ -1997,10 +2352,25 @@ SC_execute(StatementClass *self)
 	{
 		char	*plan_name = self->plan_name;
 
-		if (issue_begin)
-			CC_begin(conn);
 		if (!plan_name)
 			plan_name = "";
+		if (issue_begin)
+		{
+			/*
+			 * Queue the BEGIN ahead of the Bind/Execute so that both go
+			 * under the same Sync. It uses the unnamed statement, so it
+			 * can't be used when the plan itself is the unnamed one.
+			 */
+			if (!plan_name[0])
+				CC_begin(conn);
+			else if (SendCommandRequest(self, "BEGIN"))
+				CC_set_in_trans(conn);
+			else
+			{
+				SC_set_error(self, STMT_EXEC_ERROR, "Could not send the implicit BEGIN", func);
+				goto cleanup;
+			}
+		}
 		if (!SendBindRequest(self, plan_name))
 		{
 			if (SC_get_errornumber(self) <= 0)
@@ -2030,6 +2400,26 @@ inolog("get_Result=%p %p %d\n", res, SC_get_Result(self), self->curr_param_resul
 		QueryInfo	*qryi = NULL;
 
 		qflag |= (SQL_CONCUR_READ_ONLY != self->options.scroll_concurrency ? CREATE_KEYSET : 0);
+		if (!useCursor && 0 == (qflag & CREATE_KEYSET))
+		{
+			qflag |= ALLOW_SPILL_TUPLES;
+			/*
+			 * The tuples of a forward-only result may be read as
+			 * they are fetched unless other results follow them.
+			 */
+			if (0 < ci->stream_results &&
+			    SQL_CURSOR_FORWARD_ONLY == self->options.cursor_type &&
+			    SC_may_use_cursor(self) &&
+			    !self->internal)
+			{
+				po_ind_t	multi = self->multi_statement;
+
+				if (multi < 0)
+					SC_scanQueryAndCountParams(self->stmt_with_params, conn, NULL, NULL, &multi, NULL);
+				if (!multi)
+					qflag |= STREAM_TUPLES;
+			}
+		}
 		mylog("       Sending SELECT statement on stmt=%p, cursor_name='%s' qflag=%d,%d\n", self, SC_cursor_name(self), qflag, self->options.scroll_concurrency);
 
 		/* send the declare/select */
@@ -2090,7 +2480,12 @@ inolog("get_Result=%p %p %d\n", res, SC_get_Result(self), self->curr_param_resul
 		mylog("      it's NOT a select statement: stmt=%p\n", self);
 		res = CC_send_query(conn, self->stmt_with_params, NULL, qflag, SC_get_ancestor(self));
 	}
+	if (conn->sock)
+		cancel_sent = SOCK_reset_query_timeout(conn->sock);
 
+	/* a multi-statement string may begin with a SELECT */
+	if (SC_may_change_catalog(self))
+		CC_on_catalog_change(conn);
 	if (!isSelectType)
 	{
 		/*
@@ -2125,6 +2520,8 @@ inolog("get_Result=%p %p %d\n", res, SC_get_Result(self), self->curr_param_resul
 
 		if (was_ok)
 			SC_set_errornumber(self, STMT_OK);
+		else if (SC_query_timed_out(self, res, cancel_sent))
+			SC_set_error(self, STMT_QUERY_TIMEOUT_EXPIRED, "Query timeout expired", func);
 		else if (0 < SC_get_errornumber(self))
 			;
 		else if (was_nonfatal)
@@ -2332,6 +2729,11 @@ inolog("!!SC_fetch return =%d\n", ret);
 	}
 cleanup:
 #undef	return
+	/* Settle the commands queued ahead of a failed Bind/Execute request */
+	if (0 < conn->num_queued_cmds && NULL != conn->sock)
+		QR_Destructor(SendSyncAndReceive(self, NULL, "discard the queued commands"));
+	if (conn->sock)
+		SOCK_reset_query_timeout(conn->sock);
 	SC_SetExecuting(self, FALSE);
 	CLEANUP_FUNC_CONN_CS(func_cs_count, conn);
 	if (CONN_DOWN != conn->status)
@@ -2476,6 +2878,8 @@ RequestStart(StatementClass *stmt, ConnectionClass *conn, const char *func)
 {
 	BOOL	ret = TRUE;
 
+	/* a streamed result may still be coming */
+	CC_finish_streaming(conn);
 #ifdef	_HANDLE_ENLIST_IN_DTC_
 	if (conn->asdum)
 		CALL_IsolateDtcConn(conn, TRUE);
@@ -2527,6 +2931,9 @@ ReflectColumnsInfo(StatementClass *self, QResultClass *res)
 			QR_set_haskeyset(res);
 		if (QR_is_withhold(pres))
 			QR_set_withhold(res);
+		if (QR_has_packed_tuples(pres))
+			QR_set_packed_tuples(res);
+		QR_set_spill_rows(res, pres->spill_rows);
 		res->num_fields = pres->num_fields;
 
 		return TRUE;
@@ -2584,6 +2991,27 @@ inolog("desc id=%c", id);
 		if (0 != SOCK_get_errcode(conn->sock))
 			break;
 inolog(" response_length=%d\n", response_length);
+		if (0 < conn->num_queued_cmds)
+		{
+			/*
+			 * The responses to the commands queued by SendCommandRequest()
+			 * come first and aren't the statement's own.
+			 */
+			switch (id)
+			{
+				case '1': /* ParseComplete */
+				case '2': /* BindComplete */
+					continue;
+				case 'C': /* CommandComplete */
+					SOCK_get_string(conn->sock, msgbuffer, sizeof(msgbuffer));
+					mylog("%s: queued command response=%s\n", func, msgbuffer);
+					conn->num_queued_cmds--;
+					continue;
+				case 'E': /* the server skips the rest until the Sync */
+					conn->num_queued_cmds = 0;
+					break;
+			}
+		}
 		switch (id)
 		{
 			case 'C':
@@ -2699,15 +3127,25 @@ inolog("num_params=%d info=%d\n", stmt->num_params, num_p);
 				break;
 			case 'T': /* RowDesription */
 				QR_set_conn(res, conn);
-				if (CI_read_fields(QR_get_fields(res), conn))
+				/* a statement prepared again is likely described alike */
+				if (NULL != stmt->last_fields &&
+				    0 == CI_get_num_fields(QR_get_fields(res)))
+					QR_set_fields(res, stmt->last_fields);
+				if (QR_read_fields(res, conn))
 				{
 					Int2	dummy1, dummy2;
 					int	cidx;
 
+					SC_set_last_fields(stmt, QR_get_fields(res));
 					QR_set_rstatus(res, PORES_FIELDS_OK);
 					res->num_fields = CI_get_num_fields(QR_get_fields(res));
 					if (QR_haskeyset(res))
 						res->num_fields -= res->num_key_fields;
+					else
+					{
+						QR_set_packed_tuples(res);
+						QR_set_spill_rows(res, conn->connInfo.spill_rows);
+					}
 					num_io_params = CountParameters(stmt, NULL, &dummy1, &dummy2);
 					if (stmt->proc_return > 0 ||
 					    num_io_params > 0)
@@ -2793,6 +3231,7 @@ inolog("!![%d].PGType %u->%u\n", i, PIC_get_pgtype(ipdopts->parameters[i]), CI_g
 	    NULL != newres)
 		QR_Destructor(newres);
 	conn->stmt_in_extquery = NULL;
+	conn->num_queued_cmds = 0;
 	return res;
 }
 
@@ -2801,7 +3240,7 @@ SendParseRequest(StatementClass *stmt, const char *plan_name, const char *query,
 {
 	CSTR	func = "SendParseRequest";
 	ConnectionClass	*conn = SC_get_conn(stmt);
-	SocketClass	*sock = conn->sock;
+	SocketClass	*sock;
 	Int4		sta_pidx = -1, end_pidx = -1;
 	size_t		pileng, leng;
 
@@ -2809,6 +3248,7 @@ SendParseRequest(StatementClass *stmt, const char *plan_name, const char *query,
 	qlog("%s: plan_name=%s query=%s\n", func, plan_name, query);
 	if (!RequestStart(stmt, conn, func))
 		return FALSE;
+	sock = conn->sock;
 
 	SOCK_put_char(sock, 'P'); /* Parse command */
 	if (SOCK_get_errcode(sock) != 0)
@@ -2922,13 +3362,14 @@ SendDescribeRequest(StatementClass *stmt, const char *plan_name, BOOL paramAlso)
 {
 	CSTR	func = "SendDescribeRequest";
 	ConnectionClass	*conn = SC_get_conn(stmt);
-	SocketClass	*sock = conn->sock;
+	SocketClass	*sock;
 	size_t		leng;
 	BOOL		sockerr = FALSE;
 
 	mylog("%s:plan_name=%s\n", func, plan_name);
 	if (!RequestStart(stmt, conn, func))
 		return FALSE;
+	sock = conn->sock;
 
 	SOCK_put_char(sock, 'D'); /* Describe command */
 	if (SOCK_get_errcode(sock) != 0)
@@ -2990,6 +3431,7 @@ SendExecuteRequest(StatementClass *stmt, const char *plan_name, UInt4 count)
 	}
 	if (!RequestStart(stmt, conn, func))
 		return FALSE;
+	if (sock = conn->sock, !sock)	return FALSE;
 
 	SOCK_put_char(sock, 'E'); /* Execute command */
 	SC_forget_unnamed(stmt); /* unnamed plans are unavailable */
@@ -3026,14 +3468,68 @@ inolog("Close leng=%d\n", leng);
 	return TRUE;
 }
 
+/*
+ *	Queue a command without parameters nor result, e.g. an implicit BEGIN,
+ *	as Parse/Bind/Execute of the unnamed statement and portal. No Sync is
+ *	sent; the responses are consumed by the next SendSyncAndReceive()
+ *	ahead of those of the statement's own requests.
+ */
+BOOL
+SendCommandRequest(StatementClass *stmt, const char *query)
+{
+	CSTR	func = "SendCommandRequest";
+	ConnectionClass	*conn = SC_get_conn(stmt);
+	SocketClass	*sock;
+	size_t		leng;
+
+	mylog("%s: query=%s\n", func, query);
+	qlog("%s: query=%s\n", func, query);
+	CC_finish_streaming(conn);
+	sock = conn->sock;
+	SOCK_put_char(sock, 'P'); /* Parse command */
+	leng = 1 + strlen(query) + 1 + sizeof(Int2);
+	SOCK_put_int(sock, (Int4) (leng + 4), 4); /* length */
+	SOCK_put_string(sock, "");
+	SOCK_put_string(sock, query);
+	SOCK_put_int(sock, 0, sizeof(Int2)); /* number of parameters */
+
+	SOCK_put_char(sock, 'B'); /* Bind command */
+	leng = 1 + 1 + sizeof(Int2) * 3;
+	SOCK_put_int(sock, (Int4) (leng + 4), 4); /* length */
+	SOCK_put_string(sock, ""); /* portal */
+	SOCK_put_string(sock, ""); /* statement */
+	SOCK_put_int(sock, 0, sizeof(Int2)); /* number of parameter formats */
+	SOCK_put_int(sock, 0, sizeof(Int2)); /* number of parameters */
+	SOCK_put_int(sock, 0, sizeof(Int2)); /* number of result formats */
+
+	SOCK_put_char(sock, 'E'); /* Execute command */
+	leng = 1 + 4;
+	SOCK_put_int(sock, (Int4) (leng + 4), 4); /* length */
+	SOCK_put_string(sock, ""); /* portal */
+	SOCK_put_int(sock, 0, sizeof(Int4));
+	if (SOCK_get_errcode(sock) != 0)
+	{
+		CC_set_error(conn, CONNECTION_COULD_NOT_SEND, "Could not send the queued command to backend", func);
+		CC_on_abort(conn, CONN_DEAD);
+		return FALSE;
+	}
+	conn->num_queued_cmds++;
+	conn->stmt_in_extquery = stmt;
+
+	return TRUE;
+}
+
 BOOL	SendSyncRequest(ConnectionClass *conn)
 {
-	SocketClass	*sock = conn->sock;
+	SocketClass	*sock;
 
+	CC_finish_streaming(conn);
+	sock = conn->sock;
 	SOCK_put_char(sock, 'S');	/* Sync command */
 	SOCK_put_int(sock, 4, 4);
 	SOCK_flush_output(sock);
 	conn->stmt_in_extquery = NULL;
+	conn->num_queued_cmds = 0;
 
 	return TRUE;
 }
@@ -15,6 +15,7 @@
 #include "pgtypes.h"
 #include "bind.h"
 #include "descriptor.h"
+#include "lobj.h"
 
 #if defined (POSIX_MULTITHREAD_SUPPORT)
 #include <pthread.h>
@@ -95,6 +96,7 @@ enum {
 	,STMT_INVALID_NULL_ARG
 	,STMT_NO_RESPONSE
 	,STMT_COMMUNICATION_ERROR
+	,STMT_QUERY_TIMEOUT_EXPIRED
 };
 
 /* statement types */
@@ -215,6 +217,7 @@ struct StatementClass_
 	SQLLEN		last_fetch_count;	/* number of rows retrieved in
 						 * last fetch/extended fetch */
 	int		lobj_fd;		/* fd of the current large object */
+	LO_BUFFER	lobj_buf;		/* and its read ahead/write buffer */
 
 	char	   *statement;		/* if non--null pointer to the SQL
 					 * statement that has been executed */
@@ -248,6 +251,8 @@ struct StatementClass_
 	po_ind_t	join_info;	/* have joins ? */
 	po_ind_t	parse_method;	/* parse_statement is forced or ? */
 	po_ind_t	curr_param_result; /* current param result is set ? */
+	po_ind_t	cols_info_kept;	/* the parsed field info is kept for a
+					 * re-execution described alike ? */
 	pgNAME		cursor_name;
 	char		*plan_name;
 
@@ -274,6 +279,9 @@ struct StatementClass_
 	UInt2		allocated_callbacks;
 	UInt2		num_callbacks;
 	NeedDataCallback	*callbacks;
+	ColumnInfoClass	*last_fields;	/* the column info of the last result,
+					 * shared by the next one if alike */
+	StatementClass	*next_pooled;	/* in the pool of the connection */
 #if defined(WIN_MULTITHREAD_SUPPORT)
 	CRITICAL_SECTION	cs;
 #elif defined(POSIX_THREADMUTEX_SUPPORT)
@@ -419,6 +427,10 @@ void SC_forget_unnamed(StatementClass *self);
 #define SC_may_use_cursor(a) \
 	(SC_get_APDF(a)->paramset_size <= 1 &&								\
 	 (STMT_TYPE_SELECT == (a)->statement_type || STMT_TYPE_WITH == (a)->statement_type) )
+/* anything but plain DML, e.g. DDL, TRUNCATE, COMMENT, DO, procedure calls or a multi-statement string */
+#define SC_may_change_catalog(a) ((a)->multi_statement > 0 || \
+		 STMT_TYPE_SELECT > (a)->statement_type || \
+		 STMT_TYPE_WITH < (a)->statement_type)
 #define SC_may_fetch_rows(a) (STMT_TYPE_SELECT == (a)->statement_type || STMT_TYPE_WITH == (a)->statement_type)
 #define SC_can_req_colinfo(a) (STMT_TYPE_SELECT == (a)->statement_type || \
 		 STMT_TYPE_WITH == (a)->statement_type || \
@@ -453,10 +465,12 @@ void SC_forget_unnamed(StatementClass *self);
 StatementClass *SC_Constructor(ConnectionClass *);
 void		InitializeStatementOptions(StatementOptions *opt);
 char		SC_Destructor(StatementClass *self);
+void		SC_clear_pool(ConnectionClass *conn);
 BOOL		SC_opencheck(StatementClass *self, const char *func);
 RETCODE		SC_initialize_and_recycle(StatementClass *self);
 void		SC_initialize_cols_info(StatementClass *self, BOOL DCdestroy, BOOL parseReset);
 void		SC_reset_result_for_rerun(StatementClass *self);
+void		SC_set_last_fields(StatementClass *self, ColumnInfoClass *fields);
 int		statement_type(const char *statement);
 char		parse_statement(StatementClass *stmt, BOOL);
 char		parse_sqlsvr(StatementClass *stmt);
@@ -477,12 +491,17 @@ void		SC_set_rowset_start(StatementClass *self, SQLLEN, BOOL);
 void		SC_inc_rowset_start(StatementClass *self, SQLLEN);
 RETCODE		SC_initialize_stmts(StatementClass *self, BOOL);
 RETCODE		SC_execute(StatementClass *self);
+RETCODE		SC_stream_rowset(StatementClass *self, SQLLEN start, SQLLEN nrows);
 RETCODE		SC_fetch(StatementClass *self);
+int		SC_mark_rowset_columns(StatementClass *self, SQLLEN rowsetSize);
+void		SC_unmark_rowset_columns(StatementClass *self);
+RETCODE		SC_fetch_rowset_columns(StatementClass *self, SQLLEN nrows, SQLUSMALLINT *rowStatus);
 void		SC_free_params(StatementClass *self, char option);
 void		SC_log_error(const char *func, const char *desc, const StatementClass *self);
 time_t		SC_get_time(StatementClass *self);
 SQLULEN		SC_get_bookmark(StatementClass *self);
 RETCODE		SC_pos_reload(StatementClass *self, SQLULEN index, UInt2 *, Int4);
+RETCODE		SC_pos_reload_rowset(StatementClass *self, SQLLEN global_ridx);
 RETCODE		SC_pos_update(StatementClass *self, SQLSETPOSIROW irow, SQLULEN index);
 RETCODE		SC_pos_delete(StatementClass *self, SQLSETPOSIROW irow, SQLULEN index);
 RETCODE		SC_pos_refresh(StatementClass *self, SQLSETPOSIROW irow, SQLULEN index);
@@ -512,6 +531,7 @@ BOOL		SendDescribeRequest(StatementClass *self, const char *name, BOOL paramAlso
 BOOL		SendBindRequest(StatementClass *self, const char *name);
 BOOL		BuildBindRequest(StatementClass *stmt, const char *name);
 BOOL		SendExecuteRequest(StatementClass *stmt, const char *portal, UInt4 count);
+BOOL		SendCommandRequest(StatementClass *stmt, const char *query);
 QResultClass	*SendSyncAndReceive(StatementClass *stmt, QResultClass *res, const char *comment);
 /*
  *	Macros to convert global index <-> relative index in resultset/rowset
@@ -0,0 +1,156 @@
+#include "bench.h"
+
+#ifndef WIN32
+#include <time.h>
+#include <sys/time.h>
+#endif
+
+/*
+ * Multiplier for the number of rows and iterations of each benchmark,
+ * from the PSQLODBC_BENCH_SCALE environment variable. Defaults to 1.
+ */
+int
+bench_scale(void)
+{
+	const char *s = getenv("PSQLODBC_BENCH_SCALE");
+	int			scale;
+
+	if (!s || (scale = atoi(s)) <= 0)
+		return 1;
+	return scale;
+}
+
+/* Current time in seconds, from a monotonic clock where available */
+double
+bench_now(void)
+{
+#ifdef WIN32
+	LARGE_INTEGER freq, count;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return (double) count.QuadPart / (double) freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+#else
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+#endif
+}
+
+/* Execute a statement which returns no rows, and exit on failure */
+void
+bench_exec(HSTMT hstmt, const char *sql)
+{
+	SQLRETURN rc;
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	if (!SQL_SUCCEEDED(rc) && rc != SQL_NO_DATA)
+	{
+		printf("%s\n", sql);
+		print_diag("SQLExecDirect failed", SQL_HANDLE_STMT, hstmt);
+		exit(1);
+	}
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
+HSTMT
+bench_alloc_stmt(void)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	return hstmt;
+}
+
+void
+bench_latency_init(bench_latency *lat, int maxsamples)
+{
+	lat->samples = malloc(sizeof(double) * maxsamples);
+	if (!lat->samples)
+	{
+		printf("out of memory\n");
+		exit(1);
+	}
+	lat->nsamples = 0;
+	lat->maxsamples = maxsamples;
+}
+
+void
+bench_latency_add(bench_latency *lat, double seconds)
+{
+	if (lat->nsamples < lat->maxsamples)
+		lat->samples[lat->nsamples++] = seconds * 1000000.0;
+}
+
+void
+bench_latency_free(bench_latency *lat)
+{
+	free(lat->samples);
+	lat->samples = NULL;
+	lat->nsamples = lat->maxsamples = 0;
+}
+
+static int
+cmp_double(const void *a, const void *b)
+{
+	double		da = *(const double *) a;
+	double		db = *(const double *) b;
+
+	return da < db ? -1 : (da > db ? 1 : 0);
+}
+
+/* The sample at the given percentile, of samples sorted in ascending order */
+static double
+percentile(const bench_latency *lat, int pct)
+{
+	int			idx = (lat->nsamples * pct + 99) / 100 - 1;
+
+	if (idx < 0)
+		idx = 0;
+	return lat->samples[idx];
+}
+
+void
+bench_report_throughput(const char *name, long rows, double bytes, double seconds)
+{
+	if (seconds <= 0)
+		seconds = 1e-9;
+	printf("BENCH name=%s rows=%ld seconds=%.3f rows_per_s=%.0f mb_per_s=%.2f\n",
+		   name, rows, seconds, rows / seconds,
+		   bytes / (1024.0 * 1024.0) / seconds);
+	fflush(stdout);
+}
+
+void
+bench_report_latency(const char *name, bench_latency *lat)
+{
+	double		total = 0;
+	int			i;
+
+	if (lat->nsamples == 0)
+	{
+		printf("BENCH name=%s count=0\n", name);
+		return;
+	}
+	qsort(lat->samples, lat->nsamples, sizeof(double), cmp_double);
+	for (i = 0; i < lat->nsamples; i++)
+		total += lat->samples[i];
+	printf("BENCH name=%s count=%d mean_us=%.1f p50_us=%.1f p99_us=%.1f max_us=%.1f\n",
+		   name, lat->nsamples, total / lat->nsamples,
+		   percentile(lat, 50), percentile(lat, 99),
+		   lat->samples[lat->nsamples - 1]);
+	fflush(stdout);
+}
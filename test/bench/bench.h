@@ -0,0 +1,32 @@
+/*
+ * Helpers for the performance benchmarks. The benchmarks use the same
+ * connection and error checking helpers as the regression tests, from
+ * ../src/common.c, and print their results as lines of the form
+ *
+ *   BENCH name=<benchmark> key=value ...
+ *
+ * so that they are easy to pick out of the output and compare between
+ * runs.
+ */
+#include "../src/common.h"
+
+/* A set of latency samples, in microseconds */
+typedef struct
+{
+	double	   *samples;
+	int			nsamples;
+	int			maxsamples;
+} bench_latency;
+
+extern int	bench_scale(void);
+extern double bench_now(void);
+extern void bench_exec(HSTMT hstmt, const char *sql);
+extern HSTMT bench_alloc_stmt(void);
+
+extern void bench_latency_init(bench_latency *lat, int maxsamples);
+extern void bench_latency_add(bench_latency *lat, double seconds);
+extern void bench_latency_free(bench_latency *lat);
+
+extern void bench_report_throughput(const char *name, long rows,
+									double bytes, double seconds);
+extern void bench_report_latency(const char *name, bench_latency *lat);
@@ -0,0 +1,104 @@
+/*
+ * Latency of the catalog functions, fetching all of the rows they return,
+ * with and without the catalog cache.
+ */
+#include "bench.h"
+
+enum
+{
+	CAT_TABLES,
+	CAT_COLUMNS,
+	CAT_PRIMARYKEYS,
+	CAT_STATISTICS,
+	CAT_TYPEINFO
+};
+
+static const struct
+{
+	const char *name;
+	int			func;
+} catalog_calls[] =
+{
+	{"tables", CAT_TABLES},
+	{"columns", CAT_COLUMNS},
+	{"primarykeys", CAT_PRIMARYKEYS},
+	{"statistics", CAT_STATISTICS},
+	{"typeinfo", CAT_TYPEINFO},
+	{NULL}
+};
+
+static SQLRETURN
+call_catalog(HSTMT hstmt, int func)
+{
+	SQLCHAR    *table = (SQLCHAR *) "bench_catalog";
+
+	switch (func)
+	{
+		case CAT_TABLES:
+			return SQLTables(hstmt, NULL, 0, NULL, 0,
+							 (SQLCHAR *) "bench_%", SQL_NTS,
+							 (SQLCHAR *) "TABLE", SQL_NTS);
+		case CAT_COLUMNS:
+			return SQLColumns(hstmt, NULL, 0, NULL, 0,
+							  table, SQL_NTS, NULL, 0);
+		case CAT_PRIMARYKEYS:
+			return SQLPrimaryKeys(hstmt, NULL, 0, NULL, 0, table, SQL_NTS);
+		case CAT_STATISTICS:
+			return SQLStatistics(hstmt, NULL, 0, NULL, 0, table, SQL_NTS,
+								 SQL_INDEX_ALL, SQL_QUICK);
+		case CAT_TYPEINFO:
+			return SQLGetTypeInfo(hstmt, SQL_ALL_TYPES);
+	}
+	return SQL_ERROR;
+}
+
+static void
+run_catalog(const char *prefix, const char *connparams, int iterations)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	bench_latency lat;
+	char		name[64];
+	double		start;
+	int			i, j;
+
+	test_connect_ext((char *) connparams);
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DROP TABLE IF EXISTS bench_catalog");
+	bench_exec(hstmt, "CREATE TABLE bench_catalog (id int4 PRIMARY KEY, a int4, b text, c timestamp, d numeric(10,2), e bytea)");
+	bench_exec(hstmt, "CREATE INDEX bench_catalog_a ON bench_catalog (a)");
+
+	for (j = 0; catalog_calls[j].name; j++)
+	{
+		bench_latency_init(&lat, iterations);
+		for (i = 0; i < iterations; i++)
+		{
+			start = bench_now();
+			rc = call_catalog(hstmt, catalog_calls[j].func);
+			CHECK_STMT_RESULT(rc, "catalog function failed", hstmt);
+			while ((rc = SQLFetch(hstmt)) != SQL_NO_DATA)
+				CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+			rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+			CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+			bench_latency_add(&lat, bench_now() - start);
+		}
+		snprintf(name, sizeof(name), "%s/%s", prefix, catalog_calls[j].name);
+		bench_report_latency(name, &lat);
+		bench_latency_free(&lat);
+	}
+
+	bench_exec(hstmt, "DROP TABLE bench_catalog");
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	test_disconnect();
+}
+
+int main(int argc, char **argv)
+{
+	int			iterations = 200 * bench_scale();
+
+	run_catalog("catalog", "CatalogCacheTTL=0", iterations);
+	run_catalog("catalog-cached", "CatalogCacheTTL=60", iterations);
+
+	return 0;
+}
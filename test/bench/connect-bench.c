@@ -0,0 +1,57 @@
+/*
+ * Time to connect and disconnect. The environment is allocated once, and
+ * a new connection handle is used for each connection.
+ */
+#include "bench.h"
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	SQLHDBC		hdbc;
+	SQLCHAR		str[1024];
+	SQLSMALLINT strl;
+	bench_latency connect_lat, disconnect_lat;
+	int			iterations = 100 * bench_scale();
+	double		start;
+	int			i;
+
+	SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &env);
+	SQLSetEnvAttr(env, SQL_ATTR_ODBC_VERSION, (void *) SQL_OV_ODBC3, 0);
+
+	bench_latency_init(&connect_lat, iterations);
+	bench_latency_init(&disconnect_lat, iterations);
+	for (i = 0; i < iterations; i++)
+	{
+		SQLAllocHandle(SQL_HANDLE_DBC, env, &hdbc);
+
+		start = bench_now();
+		rc = SQLDriverConnect(hdbc, NULL, (SQLCHAR *) "DSN=psqlodbc_test_dsn;", SQL_NTS,
+							  str, sizeof(str), &strl,
+							  SQL_DRIVER_NOPROMPT);
+		if (!SQL_SUCCEEDED(rc))
+		{
+			print_diag("SQLDriverConnect failed.", SQL_HANDLE_DBC, hdbc);
+			exit(1);
+		}
+		bench_latency_add(&connect_lat, bench_now() - start);
+
+		start = bench_now();
+		rc = SQLDisconnect(hdbc);
+		if (!SQL_SUCCEEDED(rc))
+		{
+			print_diag("SQLDisconnect failed", SQL_HANDLE_DBC, hdbc);
+			exit(1);
+		}
+		bench_latency_add(&disconnect_lat, bench_now() - start);
+
+		SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+	}
+	bench_report_latency("connect", &connect_lat);
+	bench_report_latency("disconnect", &disconnect_lat);
+	bench_latency_free(&connect_lat);
+	bench_latency_free(&disconnect_lat);
+
+	SQLFreeHandle(SQL_HANDLE_ENV, env);
+
+	return 0;
+}
@@ -0,0 +1,752 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "fakebackend.h"
+
+#ifndef WIN32
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif /* WIN32 */
+
+/*
+ * Buffer and message construction
+ */
+void
+fake_buf_init(fake_buf *buf)
+{
+	buf->data = NULL;
+	buf->len = buf->alloc = 0;
+}
+
+void
+fake_buf_free(fake_buf *buf)
+{
+	free(buf->data);
+	fake_buf_init(buf);
+}
+
+static void
+put_bytes(fake_buf *buf, const void *p, size_t n)
+{
+	if (buf->len + n > buf->alloc)
+	{
+		size_t		newalloc = buf->alloc ? buf->alloc * 2 : 4096;
+
+		while (newalloc < buf->len + n)
+			newalloc *= 2;
+		if (!(buf->data = realloc(buf->data, newalloc)))
+		{
+			fprintf(stderr, "fake backend: out of memory\n");
+			exit(1);
+		}
+		buf->alloc = newalloc;
+	}
+	memcpy(buf->data + buf->len, p, n);
+	buf->len += n;
+}
+
+static void
+put_byte(fake_buf *buf, int c)
+{
+	char		b = (char) c;
+
+	put_bytes(buf, &b, 1);
+}
+
+static void
+put_int16(fake_buf *buf, int v)
+{
+	unsigned char b[2];
+
+	b[0] = (unsigned char) (v >> 8);
+	b[1] = (unsigned char) v;
+	put_bytes(buf, b, 2);
+}
+
+static void
+put_int32(fake_buf *buf, int v)
+{
+	unsigned char b[4];
+
+	b[0] = (unsigned char) (v >> 24);
+	b[1] = (unsigned char) (v >> 16);
+	b[2] = (unsigned char) (v >> 8);
+	b[3] = (unsigned char) v;
+	put_bytes(buf, b, 4);
+}
+
+static void
+put_string(fake_buf *buf, const char *s)
+{
+	put_bytes(buf, s, strlen(s) + 1);
+}
+
+/* Start a message, and return the offset of its length word */
+static size_t
+msg_begin(fake_buf *buf, char type)
+{
+	size_t		off;
+
+	put_byte(buf, type);
+	off = buf->len;
+	put_int32(buf, 0);
+	return off;
+}
+
+static void
+msg_end(fake_buf *buf, size_t off)
+{
+	int			len = (int) (buf->len - off);
+
+	buf->data[off] = (char) (len >> 24);
+	buf->data[off + 1] = (char) (len >> 16);
+	buf->data[off + 2] = (char) (len >> 8);
+	buf->data[off + 3] = (char) len;
+}
+
+void
+fake_msg_rowdesc(fake_buf *buf, int ncols, const fake_column *cols)
+{
+	size_t		off = msg_begin(buf, 'T');
+	int			i;
+
+	put_int16(buf, ncols);
+	for (i = 0; i < ncols; i++)
+	{
+		put_string(buf, cols[i].name);
+		put_int32(buf, 0);		/* table oid */
+		put_int16(buf, 0);		/* attnum */
+		put_int32(buf, (int) cols[i].typoid);
+		put_int16(buf, cols[i].typlen);
+		put_int32(buf, cols[i].typmod);
+		put_int16(buf, 0);		/* text format */
+	}
+	msg_end(buf, off);
+}
+
+/* A NULL value is sent as SQL NULL. lengths may be NULL for C strings. */
+void
+fake_msg_datarow(fake_buf *buf, int ncols, const char **values, const int *lengths)
+{
+	size_t		off = msg_begin(buf, 'D');
+	int			i, len;
+
+	put_int16(buf, ncols);
+	for (i = 0; i < ncols; i++)
+	{
+		if (!values[i])
+		{
+			put_int32(buf, -1);
+			continue;
+		}
+		len = lengths ? lengths[i] : (int) strlen(values[i]);
+		put_int32(buf, len);
+		put_bytes(buf, values[i], len);
+	}
+	msg_end(buf, off);
+}
+
+void
+fake_msg_command_complete(fake_buf *buf, const char *tag)
+{
+	size_t		off = msg_begin(buf, 'C');
+
+	put_string(buf, tag);
+	msg_end(buf, off);
+}
+
+void
+fake_msg_error(fake_buf *buf, const char *sqlstate, const char *message)
+{
+	size_t		off = msg_begin(buf, 'E');
+
+	put_byte(buf, 'S');
+	put_string(buf, "ERROR");
+	put_byte(buf, 'C');
+	put_string(buf, sqlstate);
+	put_byte(buf, 'M');
+	put_string(buf, message);
+	put_byte(buf, '\0');
+	msg_end(buf, off);
+}
+
+/*
+ * A recorded response is a file of raw backend messages, as they appear
+ * on the wire, without the ReadyForQuery at the end.
+ */
+int
+fake_buf_load(fake_buf *buf, const char *path)
+{
+	FILE	   *fp;
+	char		chunk[8192];
+	size_t		n;
+
+	if (!(fp = fopen(path, "rb")))
+		return -1;
+	while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+		put_bytes(buf, chunk, n);
+	fclose(fp);
+	return 0;
+}
+
+int
+fake_buf_save(const fake_buf *buf, const char *path)
+{
+	FILE	   *fp;
+	int			ret = 0;
+
+	if (!(fp = fopen(path, "wb")))
+		return -1;
+	if (buf->len > 0 && fwrite(buf->data, 1, buf->len, fp) != buf->len)
+		ret = -1;
+	if (fclose(fp) != 0)
+		ret = -1;
+	return ret;
+}
+
+#ifndef WIN32
+
+#define FAKE_PORT			5432
+#define MAX_STATEMENTS		32
+
+#define NEGOTIATE_SSL_CODE	80877103
+#define NEGOTIATE_GSS_CODE	80877104
+#define CANCEL_REQUEST_CODE	80877102
+
+static int
+get_int32(const char *p)
+{
+	const unsigned char *b = (const unsigned char *) p;
+
+	return (int) (((unsigned int) b[0] << 24) | (b[1] << 16) | (b[2] << 8) | b[3]);
+}
+
+/*
+ * The backend side of a connection
+ */
+typedef struct
+{
+	int			fd;
+	const char *query;			/* the query with the canned response */
+	const fake_buf *response;
+	int			response_fails;	/* the canned response has an ErrorResponse */
+	char		txstatus;
+	int			skip_to_sync;
+	char	   *stmt_names[MAX_STATEMENTS];
+	char	   *stmt_queries[MAX_STATEMENTS];
+	char	   *portal_query;
+	fake_buf	out;
+} fake_conn;
+
+static int
+read_full(int fd, void *p, size_t n)
+{
+	char	   *b = p;
+	ssize_t		r;
+
+	while (n > 0)
+	{
+		r = read(fd, b, n);
+		if (r < 0 && errno == EINTR)
+			continue;
+		if (r <= 0)
+			return -1;
+		b += r;
+		n -= r;
+	}
+	return 0;
+}
+
+static int
+write_full(int fd, const void *p, size_t n)
+{
+	const char *b = p;
+	ssize_t		r;
+
+	while (n > 0)
+	{
+		r = write(fd, b, n);
+		if (r < 0 && errno == EINTR)
+			continue;
+		if (r <= 0)
+			return -1;
+		b += r;
+		n -= r;
+	}
+	return 0;
+}
+
+static int
+flush_out(fake_conn *fc)
+{
+	int			ret = write_full(fc->fd, fc->out.data, fc->out.len);
+
+	fc->out.len = 0;
+	return ret;
+}
+
+static void
+empty_message(fake_buf *buf, char type)
+{
+	msg_end(buf, msg_begin(buf, type));
+}
+
+static void
+parameter_status(fake_buf *buf, const char *name, const char *value)
+{
+	size_t		off = msg_begin(buf, 'S');
+
+	put_string(buf, name);
+	put_string(buf, value);
+	msg_end(buf, off);
+}
+
+static void
+ready_for_query(fake_conn *fc)
+{
+	size_t		off = msg_begin(&fc->out, 'Z');
+
+	put_byte(&fc->out, fc->txstatus);
+	msg_end(&fc->out, off);
+}
+
+/* Compare a query with a string, ignoring case, white space and ';' around it */
+static int
+same_query(const char *q, size_t len, const char *s)
+{
+	size_t		slen = strlen(s);
+
+	while (len > 0 && isspace((unsigned char) *q))
+		q++, len--;
+	while (len > 0 && (isspace((unsigned char) q[len - 1]) || q[len - 1] == ';'))
+		len--;
+	return len == slen && strncasecmp(q, s, slen) == 0;
+}
+
+/*
+ * Answer one statement. The RowDescription, if the statement returns rows,
+ * is added to desc and the rest of the answer to body. The transaction
+ * status only changes when the statement is executed.
+ */
+static void
+answer_statement(fake_conn *fc, const char *q, size_t len, int execute,
+				 fake_buf *desc, fake_buf *body)
+{
+	static const fake_column text_col = {"?column?", 25, -1, -1};
+	const char *value = NULL;
+	char		word[16], tag[32];
+	size_t		i, rdlen;
+
+	if (same_query(q, len, fc->query))
+	{
+		rdlen = 0;
+		if (fc->response->len > 5 && fc->response->data[0] == 'T')
+			rdlen = 1 + get_int32(fc->response->data + 1);
+		put_bytes(desc, fc->response->data, rdlen);
+		put_bytes(body, fc->response->data + rdlen, fc->response->len - rdlen);
+		if (execute && fc->response_fails && fc->txstatus != 'I')
+			fc->txstatus = 'E';
+		return;
+	}
+
+	/* A few queries the driver sends on its own need a row */
+	if (same_query(q, len, "show max_identifier_length"))
+		value = "63";
+	else if (same_query(q, len, "select current_schema()"))
+		value = "public";
+	if (value)
+	{
+		fake_msg_rowdesc(desc, 1, &text_col);
+		fake_msg_datarow(body, 1, &value, NULL);
+		fake_msg_command_complete(body, "SELECT 1");
+		return;
+	}
+
+	while (len > 0 && (isspace((unsigned char) *q) || *q == '('))
+		q++, len--;
+	for (i = 0; i < len && i < sizeof(word) - 1 && isalpha((unsigned char) q[i]); i++)
+		word[i] = tolower((unsigned char) q[i]);
+	word[i] = '\0';
+
+	if (strcmp(word, "select") == 0 || strcmp(word, "show") == 0 ||
+		strcmp(word, "with") == 0 || strcmp(word, "values") == 0)
+	{
+		fake_msg_rowdesc(desc, 1, &text_col);
+		fake_msg_command_complete(body, "SELECT 0");
+		return;
+	}
+
+	if (strcmp(word, "insert") == 0)
+		strcpy(tag, "INSERT 0 0");
+	else
+	{
+		for (i = 0; word[i]; i++)
+			tag[i] = toupper((unsigned char) word[i]);
+		tag[i] = '\0';
+		if (strcmp(word, "update") == 0 || strcmp(word, "delete") == 0)
+			strcat(tag, " 0");
+	}
+	fake_msg_command_complete(body, tag);
+	if (!execute)
+		return;
+	if (strcmp(word, "begin") == 0 || strcmp(word, "start") == 0)
+		fc->txstatus = 'T';
+	else if (strcmp(word, "commit") == 0 || strcmp(word, "end") == 0)
+		fc->txstatus = 'I';
+	else if (strcmp(word, "rollback") == 0)
+	{
+		/* ROLLBACK TO SAVEPOINT leaves the transaction open */
+		if (len > 8 && strncasecmp(q + 8, " to", 3) == 0)
+		{
+			if (fc->txstatus == 'E')
+				fc->txstatus = 'T';
+		}
+		else
+			fc->txstatus = 'I';
+	}
+}
+
+/* A simple Query message, which may hold several statements */
+static void
+simple_query(fake_conn *fc, const char *query)
+{
+	fake_buf	desc, body;
+	const char *start, *end;
+	int			any = 0;
+
+	fake_buf_init(&desc);
+	fake_buf_init(&body);
+	for (start = query; *start; start = *end ? end + 1 : end)
+	{
+		if (!(end = strchr(start, ';')))
+			end = start + strlen(start);
+		if (same_query(start, end - start, ""))
+			continue;
+		any = 1;
+		desc.len = body.len = 0;
+		answer_statement(fc, start, end - start, 1, &desc, &body);
+		put_bytes(&fc->out, desc.data, desc.len);
+		put_bytes(&fc->out, body.data, body.len);
+		if (body.len > 0 && body.data[0] == 'E')
+			break;
+	}
+	if (!any)
+		empty_message(&fc->out, 'I');
+	fake_buf_free(&desc);
+	fake_buf_free(&body);
+	ready_for_query(fc);
+}
+
+static const char *
+find_statement(fake_conn *fc, const char *name)
+{
+	int			i;
+
+	for (i = 0; i < MAX_STATEMENTS; i++)
+	{
+		if (fc->stmt_names[i] && strcmp(fc->stmt_names[i], name) == 0)
+			return fc->stmt_queries[i];
+	}
+	return NULL;
+}
+
+static void
+store_statement(fake_conn *fc, const char *name, const char *query)
+{
+	int			i, slot = 0;
+
+	for (i = 0; i < MAX_STATEMENTS; i++)
+	{
+		if (fc->stmt_names[i] && strcmp(fc->stmt_names[i], name) == 0)
+		{
+			slot = i;
+			break;
+		}
+		if (!fc->stmt_names[i])
+			slot = i;
+	}
+	free(fc->stmt_names[slot]);
+	free(fc->stmt_queries[slot]);
+	fc->stmt_names[slot] = strdup(name);
+	fc->stmt_queries[slot] = strdup(query);
+}
+
+/* Describe and Execute of the extended query protocol */
+static void
+extended_answer(fake_conn *fc, const char *query, int execute)
+{
+	fake_buf	desc, body;
+
+	if (!query)
+		query = "";
+	fake_buf_init(&desc);
+	fake_buf_init(&body);
+	answer_statement(fc, query, strlen(query), execute, &desc, &body);
+	if (!execute)
+	{
+		if (desc.len > 0)
+			put_bytes(&fc->out, desc.data, desc.len);
+		else
+			empty_message(&fc->out, 'n');
+	}
+	else
+	{
+		put_bytes(&fc->out, body.data, body.len);
+		if (body.len > 0 && body.data[0] == 'E')
+			fc->skip_to_sync = 1;
+	}
+	fake_buf_free(&desc);
+	fake_buf_free(&body);
+}
+
+static void
+serve(int fd, const char *query, const fake_buf *response)
+{
+	fake_conn	fc;
+	char		hdr[5];
+	char	   *msg = NULL;
+	int			len, code, i;
+	size_t		off;
+
+	memset(&fc, 0, sizeof(fc));
+	fc.fd = fd;
+	fc.query = query;
+	fc.response = response;
+	fc.txstatus = 'I';
+	for (off = 0; off + 5 <= response->len; off += 1 + get_int32(response->data + off + 1))
+	{
+		if (response->data[off] == 'E')
+			fc.response_fails = 1;
+	}
+
+	/* Startup, after refusing SSL and GSSAPI encryption */
+	for (;;)
+	{
+		if (read_full(fd, hdr, 4) < 0 || (len = get_int32(hdr)) < 8)
+			return;
+		msg = realloc(msg, len);
+		if (read_full(fd, msg, len - 4) < 0)
+			return;
+		code = get_int32(msg);
+		if (code == NEGOTIATE_SSL_CODE || code == NEGOTIATE_GSS_CODE)
+		{
+			if (write_full(fd, "N", 1) < 0)
+				return;
+			continue;
+		}
+		if (code == CANCEL_REQUEST_CODE)
+			return;
+		break;
+	}
+	off = msg_begin(&fc.out, 'R');
+	put_int32(&fc.out, 0);		/* AuthenticationOk */
+	msg_end(&fc.out, off);
+	parameter_status(&fc.out, "server_version", "9.6.0");
+	parameter_status(&fc.out, "server_encoding", "UTF8");
+	parameter_status(&fc.out, "client_encoding", "UTF8");
+	parameter_status(&fc.out, "DateStyle", "ISO, MDY");
+	parameter_status(&fc.out, "integer_datetimes", "on");
+	parameter_status(&fc.out, "standard_conforming_strings", "on");
+	off = msg_begin(&fc.out, 'K');
+	put_int32(&fc.out, (int) getpid());
+	put_int32(&fc.out, 12345);
+	msg_end(&fc.out, off);
+	ready_for_query(&fc);
+	if (flush_out(&fc) < 0)
+		return;
+
+	for (;;)
+	{
+		const char *p;
+
+		if (read_full(fd, hdr, 5) < 0 || (len = get_int32(hdr + 1)) < 4)
+			break;
+		msg = realloc(msg, len - 4 + 1);
+		if (read_full(fd, msg, len - 4) < 0)
+			break;
+		msg[len - 4] = '\0';
+		if (fc.skip_to_sync && hdr[0] != 'S' && hdr[0] != 'X')
+			continue;
+		switch (hdr[0])
+		{
+			case 'Q':
+				simple_query(&fc, msg);
+				if (flush_out(&fc) < 0)
+					goto done;
+				break;
+			case 'P':			/* Parse: name, query, parameter types */
+				store_statement(&fc, msg, msg + strlen(msg) + 1);
+				empty_message(&fc.out, '1');
+				break;
+			case 'B':			/* Bind: portal, statement, ... */
+				p = find_statement(&fc, msg + strlen(msg) + 1);
+				free(fc.portal_query);
+				fc.portal_query = p ? strdup(p) : NULL;
+				empty_message(&fc.out, '2');
+				break;
+			case 'D':			/* Describe: 'S' or 'P', name */
+				if (msg[0] == 'S')
+				{
+					off = msg_begin(&fc.out, 't');
+					put_int16(&fc.out, 0);
+					msg_end(&fc.out, off);
+					extended_answer(&fc, find_statement(&fc, msg + 1), 0);
+				}
+				else
+					extended_answer(&fc, fc.portal_query, 0);
+				break;
+			case 'E':			/* Execute: portal, max rows */
+				extended_answer(&fc, fc.portal_query, 1);
+				break;
+			case 'C':			/* Close */
+				empty_message(&fc.out, '3');
+				break;
+			case 'H':			/* Flush */
+				if (flush_out(&fc) < 0)
+					goto done;
+				break;
+			case 'S':			/* Sync */
+				fc.skip_to_sync = 0;
+				ready_for_query(&fc);
+				if (flush_out(&fc) < 0)
+					goto done;
+				break;
+			case 'X':			/* Terminate */
+				goto done;
+			default:
+				break;
+		}
+	}
+done:
+	free(msg);
+	free(fc.portal_query);
+	for (i = 0; i < MAX_STATEMENTS; i++)
+	{
+		free(fc.stmt_names[i]);
+		free(fc.stmt_queries[i]);
+	}
+	fake_buf_free(&fc.out);
+}
+
+static void
+socket_path(const fake_backend *fb, char *path, size_t len)
+{
+	snprintf(path, len, "%s/.s.PGSQL.%d", fb->sockdir, fb->port);
+}
+
+/*
+ * Start a backend which answers the given query with the given response,
+ * in a child process. Each connection is served by a process of its own.
+ */
+int
+fakebackend_start(fake_backend *fb, const char *query, const fake_buf *response)
+{
+	struct sockaddr_un addr;
+	int			lfd, fd;
+	pid_t		pid;
+
+	strcpy(fb->sockdir, "/tmp/fakepgXXXXXX");
+	if (!mkdtemp(fb->sockdir))
+		return -1;
+	fb->port = FAKE_PORT;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	socket_path(fb, addr.sun_path, sizeof(addr.sun_path));
+	if ((lfd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+	{
+		rmdir(fb->sockdir);
+		return -1;
+	}
+	if (bind(lfd, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+		listen(lfd, 5) < 0)
+	{
+		close(lfd);
+		unlink(addr.sun_path);
+		rmdir(fb->sockdir);
+		return -1;
+	}
+
+	fflush(stdout);
+	fflush(stderr);
+	if ((pid = fork()) < 0)
+	{
+		close(lfd);
+		unlink(addr.sun_path);
+		rmdir(fb->sockdir);
+		return -1;
+	}
+	if (pid == 0)
+	{
+		signal(SIGCHLD, SIG_IGN);
+		for (;;)
+		{
+			if ((fd = accept(lfd, NULL, NULL)) < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				_exit(1);
+			}
+			if (fork() == 0)
+			{
+				close(lfd);
+				serve(fd, query, response);
+				_exit(0);
+			}
+			close(fd);
+		}
+	}
+	close(lfd);
+	fb->pid = (int) pid;
+	return 0;
+}
+
+void
+fakebackend_stop(fake_backend *fb)
+{
+	char		path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+
+	if (fb->pid <= 0)
+		return;
+	kill((pid_t) fb->pid, SIGTERM);
+	waitpid((pid_t) fb->pid, NULL, 0);
+	fb->pid = 0;
+	socket_path(fb, path, sizeof(path));
+	unlink(path);
+	rmdir(fb->sockdir);
+}
+
+/* Connection string attributes which point the driver at the backend */
+void
+fakebackend_connstr(const fake_backend *fb, char *str, size_t len)
+{
+	snprintf(str, len, "Servername=%s;Port=%d;Database=fake;Username=fake;Password=;SSLmode=disable;Protocol=7.4",
+			 fb->sockdir, fb->port);
+}
+
+#else /* WIN32 */
+
+int
+fakebackend_start(fake_backend *fb, const char *query, const fake_buf *response)
+{
+	return -1;
+}
+
+void
+fakebackend_stop(fake_backend *fb)
+{
+}
+
+void
+fakebackend_connstr(const fake_backend *fb, char *str, size_t len)
+{
+	*str = '\0';
+}
+
+#endif /* WIN32 */
@@ -0,0 +1,57 @@
+/*
+ * A fake PostgreSQL backend, for measuring the CPU cost of the client side
+ * of the driver without the noise of a real server.
+ *
+ * It listens on a UNIX socket in a temporary directory, accepts any user
+ * without a password, and speaks just enough of the v3 protocol for the
+ * driver to connect and run queries. One query is answered with a canned
+ * response, a buffer of backend messages which is either generated with
+ * the fake_msg_*() functions or loaded from a file. Other queries get an
+ * empty result, or the command tag of their first word.
+ *
+ * The backend runs in a child process, so the CPU time it spends is not
+ * charged to the client.
+ */
+#ifndef __FAKEBACKEND_H__
+#define __FAKEBACKEND_H__
+
+#include <stddef.h>
+
+/* A growable buffer of backend messages */
+typedef struct
+{
+	char	   *data;
+	size_t		len;
+	size_t		alloc;
+} fake_buf;
+
+typedef struct
+{
+	const char *name;
+	unsigned int typoid;
+	short		typlen;
+	int			typmod;
+} fake_column;
+
+typedef struct
+{
+	char		sockdir[64];
+	int			port;
+	int			pid;
+} fake_backend;
+
+extern void fake_buf_init(fake_buf *buf);
+extern void fake_buf_free(fake_buf *buf);
+extern int	fake_buf_load(fake_buf *buf, const char *path);
+extern int	fake_buf_save(const fake_buf *buf, const char *path);
+
+extern void fake_msg_rowdesc(fake_buf *buf, int ncols, const fake_column *cols);
+extern void fake_msg_datarow(fake_buf *buf, int ncols, const char **values, const int *lengths);
+extern void fake_msg_command_complete(fake_buf *buf, const char *tag);
+extern void fake_msg_error(fake_buf *buf, const char *sqlstate, const char *message);
+
+extern int	fakebackend_start(fake_backend *fb, const char *query, const fake_buf *response);
+extern void fakebackend_stop(fake_backend *fb);
+extern void fakebackend_connstr(const fake_backend *fb, char *str, size_t len);
+
+#endif /* __FAKEBACKEND_H__ */
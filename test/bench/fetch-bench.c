@@ -0,0 +1,98 @@
+/*
+ * Fetch throughput, for columns of different types and widths. Each case
+ * creates a temporary table with one column, and fetches all of it with
+ * a bound rowset.
+ */
+#include "bench.h"
+
+#define ROWSET_SIZE		100
+
+typedef struct
+{
+	const char *name;
+	const char *expr;		/* value of the column, as a function of g */
+	SQLSMALLINT ctype;
+	SQLLEN		buflen;
+} fetch_case;
+
+static const fetch_case cases[] =
+{
+	{"int4", "g::int4", SQL_C_LONG, sizeof(SQLINTEGER)},
+	{"int8", "g::int8 * 1000000007", SQL_C_SBIGINT, sizeof(SQLBIGINT)},
+	{"float8", "g * 1.5::float8", SQL_C_DOUBLE, sizeof(SQLDOUBLE)},
+	{"numeric", "(g * 1.01)::numeric(14,2)", SQL_C_CHAR, 20},
+	{"timestamp", "timestamp '2000-01-01' + g * interval '1 second'", SQL_C_TYPE_TIMESTAMP, sizeof(TIMESTAMP_STRUCT)},
+	{"text10", "repeat('x', 10)", SQL_C_CHAR, 11},
+	{"text100", "repeat('x', 100)", SQL_C_CHAR, 101},
+	{"text1000", "repeat('x', 1000)", SQL_C_CHAR, 1001},
+	{"bytea100", "decode(repeat('ab', 100), 'hex')", SQL_C_BINARY, 100},
+	{NULL}
+};
+
+static void
+run_case(const fetch_case *fc, long nrows)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	char		sql[256];
+	char		name[64];
+	char	   *buf;
+	SQLLEN		ind[ROWSET_SIZE];
+	SQLULEN		rowsfetched;
+	long		rows = 0;
+	double		bytes = 0, start;
+	int			i;
+
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DROP TABLE IF EXISTS bench_fetch");
+	snprintf(sql, sizeof(sql),
+			 "CREATE TEMPORARY TABLE bench_fetch AS SELECT %s AS c FROM generate_series(1, %ld) g",
+			 fc->expr, nrows);
+	bench_exec(hstmt, sql);
+
+	buf = malloc(fc->buflen * ROWSET_SIZE);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) ROWSET_SIZE, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLBindCol(hstmt, 1, fc->ctype, buf, fc->buflen, ind);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	start = bench_now();
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT c FROM bench_fetch", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	while ((rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0)) != SQL_NO_DATA)
+	{
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+		for (i = 0; i < (int) rowsfetched; i++)
+		{
+			if (ind[i] != SQL_NULL_DATA)
+				bytes += ind[i];
+		}
+		rows += (long) rowsfetched;
+	}
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	snprintf(name, sizeof(name), "fetch/%s", fc->name);
+	bench_report_throughput(name, rows, bytes, bench_now() - start);
+	if (rows != nrows)
+		printf("fetched %ld rows, expected %ld\n", rows, nrows);
+
+	free(buf);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	long		nrows = 100000L * bench_scale();
+	const fetch_case *fc;
+
+	test_connect();
+	for (fc = cases; fc->name; fc++)
+		run_case(fc, nrows);
+	test_disconnect();
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Batch insert throughput with array binding, with different numbers of
+ * rows in each batch. All the batches are inserted in one transaction, so
+ * that the numbers don't depend on the cost of a commit on the server.
+ */
+#include "bench.h"
+
+static const int batch_sizes[] = {1, 10, 100, 1000, 0};
+
+static void
+run_batch(int batch_size, long nrows)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	SQLINTEGER *ids;
+	char	   *texts;
+	SQLLEN	   *ind;
+	SQLULEN		processed;
+	char		name[64];
+	double		start;
+	long		done;
+	int			i;
+
+	ids = malloc(sizeof(SQLINTEGER) * batch_size);
+	texts = malloc(32 * batch_size);
+	ind = malloc(sizeof(SQLLEN) * batch_size);
+
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DROP TABLE IF EXISTS bench_insert");
+	bench_exec(hstmt, "CREATE TEMPORARY TABLE bench_insert (i int4, t text)");
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_COMMIT);
+	CHECK_STMT_RESULT(rc, "SQLEndTran failed", hstmt);
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER) SQL_PARAM_BIND_BY_COLUMN, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) (SQLLEN) batch_size, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+						  0, 0, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+	rc = SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+						  31, 0, texts, 32, ind);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "INSERT INTO bench_insert VALUES (?, ?)", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+
+	start = bench_now();
+	for (done = 0; done < nrows; done += batch_size)
+	{
+		for (i = 0; i < batch_size; i++)
+		{
+			ids[i] = (SQLINTEGER) (done + i);
+			snprintf(texts + 32 * i, 32, "row %ld", done + i);
+			ind[i] = SQL_NTS;
+		}
+		rc = SQLExecute(hstmt);
+		CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+	}
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_COMMIT);
+	CHECK_STMT_RESULT(rc, "SQLEndTran failed", hstmt);
+
+	snprintf(name, sizeof(name), "insert/batch%d", batch_size);
+	bench_report_throughput(name, done, 0, bench_now() - start);
+
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	free(ids);
+	free(texts);
+	free(ind);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	long		nrows = 20000L * bench_scale();
+	int			i;
+
+	test_connect();
+	rc = SQLSetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT,
+						   (SQLPOINTER) SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLSetConnectAttr failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	for (i = 0; batch_sizes[i] > 0; i++)
+		run_batch(batch_sizes[i], nrows);
+	test_disconnect();
+
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Throughput of writing large values with SQLPutData and reading them
+ * back with SQLGetData, in pieces, both as bytea and as large objects.
+ */
+#include "bench.h"
+
+#define LOB_SIZE		(4 * 1024 * 1024)
+#define LOB_PIECE		(64 * 1024)
+
+static char *lobbuf;
+
+static void
+run_lob(const char *type, int nvalues)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	SQLINTEGER id;
+	SQLLEN		cbParam, ind;
+	PTR			paramid;
+	char		sql[128];
+	char		name[64];
+	char	   *piece;
+	double		start, bytes;
+	int			i, pos, len;
+
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DROP TABLE IF EXISTS bench_lob");
+	snprintf(sql, sizeof(sql), "CREATE TEMPORARY TABLE bench_lob (id int4, data %s)", type);
+	bench_exec(hstmt, sql);
+
+	/* Write */
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "INSERT INTO bench_lob VALUES (?, ?)", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+						  0, 0, &id, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+	rc = SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY,
+						  LOB_SIZE, 0, (void *) 2, 0, &cbParam);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+
+	start = bench_now();
+	for (id = 0; id < nvalues; id++)
+	{
+		cbParam = SQL_DATA_AT_EXEC;
+		rc = SQLExecute(hstmt);
+		if (rc != SQL_NEED_DATA)
+			CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+		while ((rc = SQLParamData(hstmt, &paramid)) == SQL_NEED_DATA)
+		{
+			for (pos = 0; pos < LOB_SIZE; pos += len)
+			{
+				len = LOB_SIZE - pos;
+				if (len > LOB_PIECE)
+					len = LOB_PIECE;
+				rc = SQLPutData(hstmt, lobbuf + pos, len);
+				CHECK_STMT_RESULT(rc, "SQLPutData failed", hstmt);
+			}
+		}
+		CHECK_STMT_RESULT(rc, "SQLParamData failed", hstmt);
+	}
+	snprintf(name, sizeof(name), "%s/write", type);
+	bench_report_throughput(name, nvalues, (double) LOB_SIZE * nvalues, bench_now() - start);
+	rc = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* Read */
+	piece = malloc(LOB_PIECE);
+	bytes = 0;
+	start = bench_now();
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT data FROM bench_lob", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	for (i = 0; (rc = SQLFetch(hstmt)) != SQL_NO_DATA; i++)
+	{
+		CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+		while ((rc = SQLGetData(hstmt, 1, SQL_C_BINARY, piece, LOB_PIECE, &ind)) != SQL_NO_DATA)
+		{
+			CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+			bytes += (ind == SQL_NO_TOTAL || ind > LOB_PIECE) ? LOB_PIECE : ind;
+		}
+	}
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	snprintf(name, sizeof(name), "%s/read", type);
+	bench_report_throughput(name, i, bytes, bench_now() - start);
+	if (bytes != (double) LOB_SIZE * nvalues)
+		printf("read %.0f bytes, expected %.0f\n", bytes, (double) LOB_SIZE * nvalues);
+
+	/* Large objects are not removed with the rows that refer to them */
+	if (strcmp(type, "lo") == 0)
+		bench_exec(hstmt, "SELECT lo_unlink(data) FROM bench_lob");
+
+	free(piece);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	int			nvalues = 4 * bench_scale();
+	int			i;
+
+	lobbuf = malloc(LOB_SIZE);
+	for (i = 0; i < LOB_SIZE; i++)
+		lobbuf[i] = (char) (i % 253);
+
+	test_connect();
+
+	/* The driver recognizes large object columns by the "lo" type name */
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DO $$ BEGIN CREATE DOMAIN lo AS oid; EXCEPTION WHEN duplicate_object THEN NULL; END $$");
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	run_lob("bytea", nvalues);
+	run_lob("lo", nvalues);
+	test_disconnect();
+	free(lobbuf);
+
+	return 0;
+}
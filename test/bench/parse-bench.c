@@ -0,0 +1,98 @@
+/*
+ * Number parsing throughput. The columns are fetched into bound numeric
+ * C types with a bound rowset, with values that take the driver's own
+ * parsers and values that fall back to the C library: integers near the
+ * limits, and floats with many significant digits or large exponents.
+ */
+#include "bench.h"
+
+#define ROWSET_SIZE		100
+
+typedef struct
+{
+	const char *name;
+	const char *expr;		/* value of the column, as a function of g */
+	SQLSMALLINT ctype;
+	SQLLEN		buflen;
+} parse_case;
+
+static const parse_case cases[] =
+{
+	{"int4/short", "g::int4", SQL_C_LONG, sizeof(SQLINTEGER)},
+	{"int4/long", "(2147483647 - g)::int4", SQL_C_LONG, sizeof(SQLINTEGER)},
+	{"int8/short", "g::int8", SQL_C_SBIGINT, sizeof(SQLBIGINT)},
+	{"int8/long", "(9223372036854775807 - g)::int8", SQL_C_SBIGINT, sizeof(SQLBIGINT)},
+	{"float8/short", "g * 0.25::float8", SQL_C_DOUBLE, sizeof(SQLDOUBLE)},
+	{"float8/17digits", "g * 0.1::float8", SQL_C_DOUBLE, sizeof(SQLDOUBLE)},
+	{"float8/exponent", "g * 1e30::float8", SQL_C_DOUBLE, sizeof(SQLDOUBLE)},
+	{"float4", "(g * 0.5)::float4", SQL_C_FLOAT, sizeof(SQLREAL)},
+	{NULL}
+};
+
+static void
+run_case(const parse_case *pc, long nrows)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	char		sql[256];
+	char		name[64];
+	char	   *buf;
+	SQLLEN		ind[ROWSET_SIZE];
+	SQLULEN		rowsfetched;
+	long		rows = 0;
+	double		bytes = 0, start;
+	int			i;
+
+	hstmt = bench_alloc_stmt();
+	bench_exec(hstmt, "DROP TABLE IF EXISTS bench_parse");
+	snprintf(sql, sizeof(sql),
+			 "CREATE TEMPORARY TABLE bench_parse AS SELECT %s AS c FROM generate_series(1, %ld) g",
+			 pc->expr, nrows);
+	bench_exec(hstmt, sql);
+
+	buf = malloc(pc->buflen * ROWSET_SIZE);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) ROWSET_SIZE, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLBindCol(hstmt, 1, pc->ctype, buf, pc->buflen, ind);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	start = bench_now();
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT c FROM bench_parse", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	while ((rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0)) != SQL_NO_DATA)
+	{
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+		for (i = 0; i < (int) rowsfetched; i++)
+		{
+			if (ind[i] != SQL_NULL_DATA)
+				bytes += ind[i];
+		}
+		rows += (long) rowsfetched;
+	}
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	snprintf(name, sizeof(name), "parse/%s", pc->name);
+	bench_report_throughput(name, rows, bytes, bench_now() - start);
+	if (rows != nrows)
+		printf("fetched %ld rows, expected %ld\n", rows, nrows);
+
+	free(buf);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	long		nrows = 100000L * bench_scale();
+	const parse_case *pc;
+
+	test_connect();
+	for (pc = cases; pc->name; pc++)
+		run_case(pc, nrows);
+	test_disconnect();
+
+	return 0;
+}
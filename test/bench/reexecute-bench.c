@@ -0,0 +1,60 @@
+/*
+ * Latency of re-executing a prepared statement, which returns a single
+ * row, with and without server-side prepare.
+ */
+#include "bench.h"
+
+static void
+run_reexecute(const char *name, const char *connparams, int iterations)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	SQLINTEGER param, result;
+	SQLLEN		ind;
+	bench_latency lat;
+	double		start;
+	int			i;
+
+	test_connect_ext((char *) connparams);
+	hstmt = bench_alloc_stmt();
+
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "SELECT ?::int4 + 1", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+						  0, 0, &param, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, &result, 0, &ind);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	bench_latency_init(&lat, iterations);
+	for (i = 0; i < iterations; i++)
+	{
+		param = i;
+		start = bench_now();
+		rc = SQLExecute(hstmt);
+		CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+		rc = SQLFetch(hstmt);
+		CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+		rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+		CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+		bench_latency_add(&lat, bench_now() - start);
+		if (result != i + 1)
+			printf("unexpected result %d in iteration %d\n", (int) result, i);
+	}
+	bench_report_latency(name, &lat);
+	bench_latency_free(&lat);
+
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	test_disconnect();
+}
+
+int main(int argc, char **argv)
+{
+	int			iterations = 5000 * bench_scale();
+
+	run_reexecute("reexecute/simple", "UseServerSidePrepare=0", iterations);
+	run_reexecute("reexecute/server-prepared", "UseServerSidePrepare=1;Protocol=7.4-2", iterations);
+
+	return 0;
+}
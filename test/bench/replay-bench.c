@@ -0,0 +1,398 @@
+/*
+ * Client-side CPU cost of fetching results, against a fake backend which
+ * replays canned protocol messages over a UNIX socket (see fakebackend.c).
+ * Without a real server, the numbers only depend on the driver: reading
+ * the messages off the socket, storing the tuples and converting the
+ * values for the application.
+ *
+ * The CPU time of this process is measured, and the CPU cycles too where
+ * the kernel provides a cycle counter, and reported per row and per byte
+ * of DataRow messages.
+ *
+ * Usage: replay-bench [-s DIR] [FILE ...]
+ *
+ * By default, generated responses for a set of column types and widths
+ * are measured. -s saves each of them in DIR, as a file of raw backend
+ * messages. Given FILEs of such messages, e.g. saved earlier or cut out of
+ * a packet capture, those are replayed instead.
+ */
+#include "bench.h"
+#include "fakebackend.h"
+
+#ifndef WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define FAKE_QUERY		"SELECT * FROM fakebench"
+#define ROWSET_SIZE		100
+#define MAX_COLS		10
+#define ITERATIONS		3
+
+typedef enum
+{
+	VAL_INT,
+	VAL_FLOAT,
+	VAL_NUMERIC,
+	VAL_TIMESTAMP,
+	VAL_TEXT,
+	VAL_BYTEA,
+	VAL_NULL,
+	VAL_ERROR
+} value_kind;
+
+typedef struct
+{
+	const char *name;
+	int			ncols;
+	unsigned int typoid;
+	short		typlen;
+	int			typmod;
+	value_kind	kind;
+	int			width;			/* of text and bytea values */
+	SQLSMALLINT ctype;
+	SQLLEN		buflen;
+} replay_case;
+
+static const replay_case cases[] =
+{
+	{"int4", 1, 23, 4, -1, VAL_INT, 0, SQL_C_LONG, sizeof(SQLINTEGER)},
+	{"int4x10", 10, 23, 4, -1, VAL_INT, 0, SQL_C_LONG, sizeof(SQLINTEGER)},
+	{"int8", 1, 20, 8, -1, VAL_INT, 0, SQL_C_SBIGINT, sizeof(SQLBIGINT)},
+	{"float8", 1, 701, 8, -1, VAL_FLOAT, 0, SQL_C_DOUBLE, sizeof(SQLDOUBLE)},
+	{"numeric", 1, 1700, -1, ((14 << 16) | 2) + 4, VAL_NUMERIC, 0, SQL_C_CHAR, 20},
+	{"timestamp", 1, 1114, 8, -1, VAL_TIMESTAMP, 0, SQL_C_TYPE_TIMESTAMP, sizeof(TIMESTAMP_STRUCT)},
+	{"text10", 1, 25, -1, -1, VAL_TEXT, 10, SQL_C_CHAR, 11},
+	{"text100", 1, 25, -1, -1, VAL_TEXT, 100, SQL_C_CHAR, 101},
+	{"text1000", 1, 25, -1, -1, VAL_TEXT, 1000, SQL_C_CHAR, 1001},
+	{"text10x10", 10, 25, -1, -1, VAL_TEXT, 10, SQL_C_CHAR, 11},
+	{"bytea100", 1, 17, -1, -1, VAL_BYTEA, 100, SQL_C_BINARY, 100},
+	{"nullx10", 10, 25, -1, -1, VAL_NULL, 0, SQL_C_CHAR, 11},
+	{"error", 0, 0, 0, 0, VAL_ERROR, 0, 0, 0},
+	{NULL}
+};
+
+/* Bindings used for the recorded responses, whose columns aren't known */
+static const replay_case recorded_case =
+	{"recorded", 0, 0, 0, 0, VAL_TEXT, 0, SQL_C_CHAR, 8192};
+
+/*
+ * CPU usage of this process
+ */
+typedef struct
+{
+	double		cpu_seconds;
+	double		cycles;			/* negative if there is no cycle counter */
+} cpu_usage;
+
+static int	cycles_fd = -1;
+
+static void
+cycles_open(void)
+{
+#if defined(__linux__) && defined(__NR_perf_event_open)
+	struct perf_event_attr pe;
+
+	memset(&pe, 0, sizeof(pe));
+	pe.type = PERF_TYPE_HARDWARE;
+	pe.size = sizeof(pe);
+	pe.config = PERF_COUNT_HW_CPU_CYCLES;
+	pe.exclude_hv = 1;
+	cycles_fd = (int) syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+	if (cycles_fd < 0)
+	{
+		/* Unprivileged users may only count the cycles in user space */
+		pe.exclude_kernel = 1;
+		cycles_fd = (int) syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+	}
+#endif
+}
+
+static void
+cpu_usage_now(cpu_usage *cu)
+{
+#ifndef WIN32
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	cu->cpu_seconds = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1000000.0 +
+		ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1000000.0;
+#else
+	FILETIME	creation, exit, kernel, user;
+
+	GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+	cu->cpu_seconds = (((ULONGLONG) kernel.dwHighDateTime << 32 | kernel.dwLowDateTime) +
+		((ULONGLONG) user.dwHighDateTime << 32 | user.dwLowDateTime)) / 10000000.0;
+#endif
+	cu->cycles = -1;
+#ifdef __linux__
+	if (cycles_fd >= 0)
+	{
+		unsigned long long count;
+
+		if (read(cycles_fd, &count, sizeof(count)) == sizeof(count))
+			cu->cycles = (double) count;
+	}
+#endif
+}
+
+/*
+ * Generated responses
+ */
+static void
+build_response(const replay_case *rc, long nrows, fake_buf *buf)
+{
+	fake_column cols[MAX_COLS];
+	char		colnames[MAX_COLS][8];
+	char		values[MAX_COLS][2100];
+	const char *valptrs[MAX_COLS];
+	char		tag[32];
+	long		r;
+	int			i, j;
+
+	if (rc->kind == VAL_ERROR)
+	{
+		fake_msg_error(buf, "42P01", "relation \"fakebench\" does not exist");
+		return;
+	}
+	for (i = 0; i < rc->ncols; i++)
+	{
+		snprintf(colnames[i], sizeof(colnames[i]), "c%d", i + 1);
+		cols[i].name = colnames[i];
+		cols[i].typoid = rc->typoid;
+		cols[i].typlen = rc->typlen;
+		cols[i].typmod = rc->typmod;
+	}
+	fake_msg_rowdesc(buf, rc->ncols, cols);
+	for (r = 1; r <= nrows; r++)
+	{
+		for (i = 0; i < rc->ncols; i++)
+		{
+			char	   *v = values[i];
+
+			valptrs[i] = v;
+			switch (rc->kind)
+			{
+				case VAL_INT:
+					snprintf(v, sizeof(values[i]), "%ld", r * (i + 1));
+					break;
+				case VAL_FLOAT:
+					snprintf(v, sizeof(values[i]), "%.6g", r * 1.5);
+					break;
+				case VAL_NUMERIC:
+					snprintf(v, sizeof(values[i]), "%ld.%02ld", r, r % 100);
+					break;
+				case VAL_TIMESTAMP:
+					snprintf(v, sizeof(values[i]), "2000-01-%02ld %02ld:%02ld:%02ld",
+							 1 + (r / 86400) % 28, (r / 3600) % 24, (r / 60) % 60, r % 60);
+					break;
+				case VAL_TEXT:
+					memset(v, 'a' + (int) (r % 26), rc->width);
+					v[rc->width] = '\0';
+					break;
+				case VAL_BYTEA:
+					strcpy(v, "\\x");
+					for (j = 0; j < rc->width; j++)
+						snprintf(v + 2 + 2 * j, 3, "%02x", (int) ((r + j) & 0xff));
+					break;
+				default:
+					valptrs[i] = NULL;
+					break;
+			}
+		}
+		fake_msg_datarow(buf, rc->ncols, valptrs, NULL);
+	}
+	snprintf(tag, sizeof(tag), "SELECT %ld", nrows);
+	fake_msg_command_complete(buf, tag);
+}
+
+/* The number of bytes of DataRow messages in a response */
+static double
+datarow_bytes(const fake_buf *buf)
+{
+	const unsigned char *p;
+	size_t		off, len;
+	double		total = 0;
+
+	for (off = 0; off + 5 <= buf->len; off += 1 + len)
+	{
+		p = (const unsigned char *) buf->data + off + 1;
+		len = ((size_t) p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+		if (buf->data[off] == 'D')
+			total += 1 + len;
+	}
+	return total;
+}
+
+/*
+ * Run the query against a backend which answers it with the response,
+ * and fetch all the rows. Returns the number of rows fetched, or -1 if the
+ * query failed.
+ */
+static long
+run_query(HSTMT hstmt, const replay_case *rc, char *bufs, SQLLEN *inds)
+{
+	SQLRETURN ret;
+	SQLSMALLINT ncols;
+	SQLULEN		rowsfetched;
+	long		rows = 0;
+	int			i;
+
+	ret = SQLExecDirect(hstmt, (SQLCHAR *) FAKE_QUERY, SQL_NTS);
+	if (!SQL_SUCCEEDED(ret))
+	{
+		SQLFreeStmt(hstmt, SQL_CLOSE);
+		return -1;
+	}
+	ret = SQLNumResultCols(hstmt, &ncols);
+	CHECK_STMT_RESULT(ret, "SQLNumResultCols failed", hstmt);
+	if (ncols > MAX_COLS)
+		ncols = MAX_COLS;
+	ret = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(ret, "SQLSetStmtAttr failed", hstmt);
+	for (i = 0; i < ncols; i++)
+	{
+		ret = SQLBindCol(hstmt, (SQLUSMALLINT) (i + 1), rc->ctype,
+						 bufs + i * rc->buflen * ROWSET_SIZE, rc->buflen,
+						 inds + i * ROWSET_SIZE);
+		CHECK_STMT_RESULT(ret, "SQLBindCol failed", hstmt);
+	}
+	while ((ret = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0)) != SQL_NO_DATA)
+	{
+		if (!SQL_SUCCEEDED(ret))
+			break;
+		rows += (long) rowsfetched;
+	}
+	SQLFreeStmt(hstmt, SQL_UNBIND);
+	SQLFreeStmt(hstmt, SQL_CLOSE);
+	return rows;
+}
+
+static void
+run_case(const char *name, const replay_case *rc, const fake_buf *response)
+{
+	fake_backend fb;
+	char		connstr[512];
+	HSTMT		hstmt;
+	SQLRETURN	ret;
+	char	   *bufs;
+	SQLLEN	   *inds;
+	cpu_usage	before, after;
+	double		bytes, cycles;
+	long		rows, total_rows = 0;
+	int			i, iterations, statements = 0;
+
+	if (fakebackend_start(&fb, FAKE_QUERY, response) < 0)
+	{
+		printf("could not start the fake backend\n");
+		exit(1);
+	}
+	fakebackend_connstr(&fb, connstr, sizeof(connstr) - 32);
+	strcat(connstr, ";UseServerSidePrepare=0");
+	test_connect_ext(connstr);
+	hstmt = bench_alloc_stmt();
+	ret = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) ROWSET_SIZE, 0);
+	CHECK_STMT_RESULT(ret, "SQLSetStmtAttr failed", hstmt);
+	bufs = malloc(rc->buflen * ROWSET_SIZE * MAX_COLS + 1);
+	inds = malloc(sizeof(SQLLEN) * ROWSET_SIZE * MAX_COLS);
+
+	/* Failing queries are cheap, run them more often */
+	iterations = (rc->kind == VAL_ERROR) ? 10000 * bench_scale() : ITERATIONS;
+
+	/* Once to warm up, and then for real */
+	run_query(hstmt, rc, bufs, inds);
+	cpu_usage_now(&before);
+	for (i = 0; i < iterations; i++)
+	{
+		rows = run_query(hstmt, rc, bufs, inds);
+		statements++;
+		if (rows > 0)
+			total_rows += rows;
+	}
+	cpu_usage_now(&after);
+
+	bytes = datarow_bytes(response) * iterations;
+	cycles = (before.cycles >= 0 && after.cycles >= 0) ? after.cycles - before.cycles : -1;
+	printf("BENCH name=replay/%s statements=%d rows=%ld wire_mb=%.2f cpu_seconds=%.3f",
+		   name, statements, total_rows, bytes / (1024.0 * 1024.0),
+		   after.cpu_seconds - before.cpu_seconds);
+	if (total_rows > 0)
+		printf(" cpu_ns_per_row=%.1f cpu_ns_per_byte=%.2f",
+			   (after.cpu_seconds - before.cpu_seconds) * 1e9 / total_rows,
+			   (after.cpu_seconds - before.cpu_seconds) * 1e9 / bytes);
+	else
+		printf(" cpu_us_per_statement=%.2f",
+			   (after.cpu_seconds - before.cpu_seconds) * 1e6 / statements);
+	if (cycles >= 0 && total_rows > 0)
+		printf(" cycles_per_row=%.0f cycles_per_byte=%.2f",
+			   cycles / total_rows, cycles / bytes);
+	else if (cycles >= 0)
+		printf(" cycles_per_statement=%.0f", cycles / statements);
+	printf("\n");
+	fflush(stdout);
+
+	free(bufs);
+	free(inds);
+	ret = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(ret, "SQLFreeHandle failed", hstmt);
+	test_disconnect();
+	fakebackend_stop(&fb);
+}
+
+int main(int argc, char **argv)
+{
+	const char *savedir = NULL;
+	const replay_case *rc;
+	fake_buf	response;
+	char		path[1024];
+	long		nrows = 100000L * bench_scale();
+	int			argi = 1;
+
+	if (argi + 1 < argc && strcmp(argv[argi], "-s") == 0)
+	{
+		savedir = argv[argi + 1];
+		argi += 2;
+	}
+	cycles_open();
+
+	if (argi < argc)
+	{
+		/* Replay the recorded responses */
+		for (; argi < argc; argi++)
+		{
+			const char *name = strrchr(argv[argi], '/');
+
+			fake_buf_init(&response);
+			if (fake_buf_load(&response, argv[argi]) < 0)
+			{
+				printf("could not read \"%s\"\n", argv[argi]);
+				exit(1);
+			}
+			run_case(name ? name + 1 : argv[argi], &recorded_case, &response);
+			fake_buf_free(&response);
+		}
+		return 0;
+	}
+
+	for (rc = cases; rc->name; rc++)
+	{
+		fake_buf_init(&response);
+		build_response(rc, nrows, &response);
+		if (savedir)
+		{
+			snprintf(path, sizeof(path), "%s/%s.msgs", savedir, rc->name);
+			if (fake_buf_save(&response, path) < 0)
+				printf("could not write \"%s\"\n", path);
+		}
+		run_case(rc->name, rc, &response);
+		fake_buf_free(&response);
+	}
+
+	return 0;
+}
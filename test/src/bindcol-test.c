@@ -20,6 +20,13 @@ int main(int argc, char **argv)
 	SQLLEN		indLongvalue;
 	char	charvalue[100];
 	SQLLEN	indCharvalue;
+	SQLINTEGER	ids[4];
+	char	names[4][8];
+	SQLLEN	indNames[4];
+	double	dbls[4];
+	SQLULEN	rowsfetched;
+	SQLUSMALLINT	rowStatus[4];
+	int		i;
 
 	test_connect();
 
@@ -59,6 +66,81 @@ int main(int argc, char **argv)
 	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
 	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
 
+	/*
+	 * Fetch rowsets with column-wise binding. These columns are converted
+	 * a whole rowset column at a time.
+	 */
+	rc = SQLFreeStmt(hstmt, SQL_UNBIND);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 4, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLBindCol(hstmt, 2, SQL_C_CHAR, names, sizeof(names[0]), indNames);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLBindCol(hstmt, 3, SQL_C_DOUBLE, dbls, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, CASE WHEN g % 3 = 0 THEN NULL ELSE repeat('x', g) END, g / 4.0::float8 FROM generate_series(1, 10) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	while ((rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0)) != SQL_NO_DATA)
+	{
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+		printf("rowset of %d rows%s\n", (int) rowsfetched,
+			   rc == SQL_SUCCESS_WITH_INFO ? " (truncated)" : "");
+		for (i = 0; i < (int) rowsfetched; i++)
+		{
+			if (indNames[i] == SQL_NULL_DATA)
+				printf("%d NULL %g\n", (int) ids[i], dbls[i]);
+			else
+				printf("%d %s(%ld) %g\n", (int) ids[i], names[i],
+					   (long) indNames[i], dbls[i]);
+		}
+	}
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/*
+	 * A NULL in a column bound without an indicator is an error for that
+	 * row only, the other rows of the rowset are still fetched.
+	 */
+	rc = SQLFreeStmt(hstmt, SQL_UNBIND);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, rowStatus, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLBindCol(hstmt, 2, SQL_C_DOUBLE, dbls, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, CASE WHEN g = 3 THEN NULL ELSE g / 4.0::float8 END FROM generate_series(1, 4) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	if (rc != SQL_SUCCESS_WITH_INFO)
+	{
+		printf("SQLFetchScroll returned %d, expected SQL_SUCCESS_WITH_INFO\n", (int) rc);
+		print_diag("", SQL_HANDLE_STMT, hstmt);
+	}
+	printf("rowset of %d rows\n", (int) rowsfetched);
+	for (i = 0; i < (int) rowsfetched; i++)
+	{
+		if (rowStatus[i] == SQL_ROW_ERROR)
+			printf("%d error\n", (int) ids[i]);
+		else
+			printf("%d %g\n", (int) ids[i], dbls[i]);
+	}
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
 	/* Clean up */
 	test_disconnect();
 
@@ -0,0 +1,129 @@
+/*
+ * Test the catalog result cache (CatalogCacheTTL). The results of catalog
+ * functions are reused until they expire, a statement which may change
+ * the catalog is executed through the driver or the cache is flushed
+ * explicitly.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+/* driver specific connection attribute, see pgapifunc.h */
+#define SQL_ATTR_PGOPT_FLUSH_CATALOG_CACHE	65542
+
+static void
+print_columns(HSTMT hstmt, const char *label)
+{
+	SQLRETURN rc;
+	char buf[64];
+	SQLLEN ind;
+
+	rc = SQLColumns(hstmt, NULL, 0, NULL, 0,
+					(SQLCHAR *) "catcache_test", SQL_NTS,
+					(SQLCHAR *) "%", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLColumns failed", hstmt);
+
+	printf("%s:", label);
+	while (SQL_SUCCEEDED(rc = SQLFetch(hstmt)))
+	{
+		rc = SQLGetData(hstmt, 4, SQL_C_CHAR, buf, sizeof(buf), &ind);
+		CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+		printf(" %s", buf);
+	}
+	if (rc != SQL_NO_DATA)
+		CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+	printf("\n");
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
+static void
+exec_command(HSTMT hstmt, const char *sql)
+{
+	SQLRETURN rc;
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	test_connect_ext("CatalogCacheTTL=600");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	exec_command(hstmt, "DROP TABLE IF EXISTS catcache_test");
+	exec_command(hstmt, "CREATE TABLE catcache_test (id int4, t text)");
+	print_columns(hstmt, "columns");
+
+	/* Anything but plain DML flushes the cache, e.g. DO */
+	exec_command(hstmt, "DO $$ BEGIN EXECUTE 'ALTER TABLE catcache_test ADD COLUMN hidden int4'; END $$");
+	print_columns(hstmt, "columns after DO");
+
+	/* The driver doesn't see the DDL in a SELECT, so the cached result is used */
+	exec_command(hstmt, "CREATE FUNCTION catcache_func() RETURNS void LANGUAGE plpgsql AS $$ BEGIN EXECUTE 'ALTER TABLE catcache_test ADD COLUMN unseen int4'; END $$");
+	print_columns(hstmt, "columns");
+	exec_command(hstmt, "SELECT catcache_func()");
+	print_columns(hstmt, "columns after SELECT");
+
+	/* Flush the cache explicitly */
+	rc = SQLSetConnectAttr(conn, SQL_ATTR_PGOPT_FLUSH_CATALOG_CACHE, (SQLPOINTER) 1, 0);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLSetConnectAttr failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	print_columns(hstmt, "columns after flush");
+
+	/* A DDL statement flushes the cache */
+	exec_command(hstmt, "ALTER TABLE catcache_test ADD COLUMN visible int4");
+	print_columns(hstmt, "columns after ALTER");
+
+	/* and so does a multi-statement string beginning with a SELECT */
+	exec_command(hstmt, "SELECT 1; ALTER TABLE catcache_test ADD COLUMN multi int4");
+	print_columns(hstmt, "columns after multi-statement");
+
+	/* And so does one in a transaction, when it's rolled back */
+	rc = SQLSetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLSetConnectAttr failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	exec_command(hstmt, "ALTER TABLE catcache_test ADD COLUMN rolledback int4");
+	print_columns(hstmt, "columns in transaction");
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_ROLLBACK);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLEndTran failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	print_columns(hstmt, "columns after rollback");
+	rc = SQLSetConnectAttr(conn, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_IS_UINTEGER);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLSetConnectAttr failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	exec_command(hstmt, "DROP TABLE catcache_test");
+	exec_command(hstmt, "DROP FUNCTION catcache_func()");
+
+	/* Clean up */
+	test_disconnect();
+
+	return 0;
+}
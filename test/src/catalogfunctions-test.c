@@ -120,6 +120,18 @@ main(int argc, char **argv)
 	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
 	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
 
+	/* and for a table without indexes */
+	printf("Check for SQLStatistics without indexes\n");
+	rc = SQLStatistics(hstmt,
+					   NULL, 0,
+					   (SQLCHAR *) "public", SQL_NTS,
+					   (SQLCHAR *) "booltab", SQL_NTS,
+					   0, 0);
+	CHECK_STMT_RESULT(rc, "SQLStatistics failed", hstmt);
+	print_result(hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
 	/* Check for SQLPrimaryKeys */
 	printf("Check for SQLPrimaryKeys\n");
 	rc = SQLPrimaryKeys(hstmt,
@@ -4,6 +4,63 @@
 
 #include "common.h"
 
+#define LARGE_PARAM_SIZE	1000000
+#define LARGE_PARAM_CHUNK	65536
+
+/*
+ * Send a large bytea value in chunks, with or without declaring its
+ * total length in advance.
+ */
+static void
+put_large_param(HSTMT hstmt, SQLLEN cbParam)
+{
+	SQLRETURN rc;
+	PTR paramid;
+	char *data;
+	SQLLEN pos, len;
+
+	data = malloc(LARGE_PARAM_SIZE);
+	if (!data)
+	{
+		printf("out of memory\n");
+		exit(1);
+	}
+	for (pos = 0; pos < LARGE_PARAM_SIZE; pos++)
+		data[pos] = (char) ((pos * 7 + 3) % 251);
+
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT,
+						  SQL_C_BINARY,	/* value type */
+						  SQL_LONGVARBINARY, /* param type */
+						  LARGE_PARAM_SIZE,	/* column size */
+						  0,			/* dec digits */
+						  (void *) 1,	/* param value ptr */
+						  0,			/* buffer len */
+						  &cbParam		/* StrLen_or_IndPtr */);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+
+	rc = SQLExecute(hstmt);
+	if (rc != SQL_NEED_DATA)
+		CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+	while ((rc = SQLParamData(hstmt, &paramid)) == SQL_NEED_DATA)
+	{
+		for (pos = 0; pos < LARGE_PARAM_SIZE; pos += len)
+		{
+			len = LARGE_PARAM_SIZE - pos;
+			if (len > LARGE_PARAM_CHUNK)
+				len = LARGE_PARAM_CHUNK;
+			rc = SQLPutData(hstmt, data + pos, len);
+			CHECK_STMT_RESULT(rc, "SQLPutData failed", hstmt);
+		}
+	}
+	CHECK_STMT_RESULT(rc, "SQLParamData failed", hstmt);
+	free(data);
+
+	print_result(hstmt);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
 int main(int argc, char **argv)
 {
 	SQLRETURN rc;
@@ -189,6 +246,23 @@ int main(int argc, char **argv)
 	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
 	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
 
+	/****
+	 * A large data-at-execution param sent in many chunks.
+	 */
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, NULL, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) 1, 0);
+	rc = SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "SELECT length(b), md5(b) FROM (SELECT ?::bytea AS b) s", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+
+	/* with the total length declared */
+	put_large_param(hstmt, SQL_LEN_DATA_AT_EXEC(LARGE_PARAM_SIZE));
+	/* and without it */
+	put_large_param(hstmt, SQL_DATA_AT_EXEC);
+
 	/* Clean up */
 	test_disconnect();
 
@@ -0,0 +1,193 @@
+/*
+ * Test SQLEndTran on an environment handle, which ends the transactions
+ * of all the connections of the environment at once.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+#define NUM_CONNS	3
+
+static SQLHDBC conns[NUM_CONNS];
+
+static void
+exec_on(int i, const char *sql, int expect_success)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conns[i], &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conns[i]);
+		exit(1);
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	if (expect_success)
+	{
+		CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	}
+	else if (SQL_SUCCEEDED(rc))
+	{
+		printf("SQLExecDirect should have failed but it succeeded\n");
+		exit(1);
+	}
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+/* Run a query returning one integer on a connection */
+static SQLINTEGER
+get_int_on(int i, const char *sql)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLINTEGER val = 0;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conns[i], &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conns[i]);
+		exit(1);
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetch(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+	rc = SQLGetData(hstmt, 1, SQL_C_SLONG, &val, sizeof(val), NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	return val;
+}
+
+static void
+end_tran(SQLSMALLINT completion, int expect_success)
+{
+	SQLRETURN rc;
+
+	printf("%s all connections\n", SQL_COMMIT == completion ? "Committing" : "Rolling back");
+	rc = SQLEndTran(SQL_HANDLE_ENV, env, completion);
+	if (expect_success && !SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLEndTran failed", SQL_HANDLE_ENV, env);
+		exit(1);
+	}
+	if (!expect_success)
+	{
+		if (SQL_SUCCEEDED(rc))
+		{
+			printf("SQLEndTran should have failed but it succeeded\n");
+			exit(1);
+		}
+		printf("SQLEndTran failed as expected\n");
+	}
+}
+
+int
+main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	SQLCHAR str[1024];
+	SQLSMALLINT strl;
+	HSTMT hstmt;
+	SQLINTEGER pid;
+	char sql[100];
+	int i;
+
+	test_connect();
+	conns[0] = conn;
+	for (i = 1; i < NUM_CONNS; i++)
+	{
+		SQLAllocHandle(SQL_HANDLE_DBC, env, &conns[i]);
+		rc = SQLDriverConnect(conns[i], NULL, (SQLCHAR *) "DSN=psqlodbc_test_dsn;", SQL_NTS,
+							  str, sizeof(str), &strl,
+							  SQL_DRIVER_COMPLETE);
+		if (!SQL_SUCCEEDED(rc))
+		{
+			print_diag("SQLDriverConnect failed.", SQL_HANDLE_DBC, conns[i]);
+			exit(1);
+		}
+	}
+
+	for (i = 0; i < NUM_CONNS; i++)
+	{
+		rc = SQLSetConnectAttr(conns[i],
+							   SQL_ATTR_AUTOCOMMIT,
+							   (SQLPOINTER)SQL_AUTOCOMMIT_OFF,
+							   SQL_IS_UINTEGER);
+		if (!SQL_SUCCEEDED(rc))
+		{
+			print_diag("SQLSetConnectAttr failed", SQL_HANDLE_DBC, conns[i]);
+			exit(1);
+		}
+		exec_on(i, "CREATE TEMPORARY TABLE endtrantab (i int4)", 1);
+	}
+	end_tran(SQL_COMMIT, 1);
+
+	for (i = 0; i < NUM_CONNS; i++)
+		exec_on(i, "INSERT INTO endtrantab VALUES (1)", 1);
+	end_tran(SQL_COMMIT, 1);
+
+	for (i = 0; i < NUM_CONNS; i++)
+		exec_on(i, "INSERT INTO endtrantab VALUES (2)", 1);
+	end_tran(SQL_ROLLBACK, 1);
+
+	/*
+	 * One transaction is aborted, so COMMIT just rolls it back, and
+	 * the other has no transaction at all.
+	 */
+	exec_on(0, "INSERT INTO endtrantab VALUES (3)", 1);
+	exec_on(1, "INSERT INTO endtrantab VALUES (3)", 1);
+	exec_on(1, "SELECT 1/0", 0);
+	end_tran(SQL_COMMIT, 1);
+
+	/*
+	 * Kill the backend of a connection in a transaction. Ending the
+	 * transactions fails on that connection, but not on the others.
+	 */
+	exec_on(0, "INSERT INTO endtrantab VALUES (4)", 1);
+	exec_on(1, "INSERT INTO endtrantab VALUES (4)", 1);
+	exec_on(2, "INSERT INTO endtrantab VALUES (4)", 1);
+	pid = get_int_on(2, "SELECT pg_backend_pid()");
+	snprintf(sql, sizeof(sql), "SELECT pg_terminate_backend(%d)::int", (int) pid);
+	get_int_on(1, sql);
+	snprintf(sql, sizeof(sql), "SELECT count(*)::int FROM pg_stat_activity WHERE pid = %d", (int) pid);
+	for (i = 0; i < 100; i++)
+	{
+		exec_on(1, "SELECT pg_stat_clear_snapshot()", 1);
+		if (0 == get_int_on(1, sql))
+			break;
+		exec_on(1, "SELECT pg_sleep(0.1)", 1);
+	}
+	end_tran(SQL_COMMIT, 0);
+
+	for (i = 0; i < NUM_CONNS - 1; i++)
+	{
+		printf("connection %d:\n", i);
+		rc = SQLAllocHandle(SQL_HANDLE_STMT, conns[i], &hstmt);
+		if (!SQL_SUCCEEDED(rc))
+		{
+			print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conns[i]);
+			exit(1);
+		}
+		rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT i FROM endtrantab ORDER BY i", SQL_NTS);
+		CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+		print_result(hstmt);
+		rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+		CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	}
+
+	/* Clean up */
+	for (i = 1; i < NUM_CONNS; i++)
+	{
+		SQLDisconnect(conns[i]);
+		SQLFreeHandle(SQL_HANDLE_DBC, conns[i]);
+	}
+	test_disconnect();
+
+	return 0;
+}
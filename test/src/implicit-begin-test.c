@@ -0,0 +1,104 @@
+/*
+ * Test the implicit BEGIN of a server-side prepared statement in
+ * manual-commit mode. The BEGIN, and the savepoint for statement-level
+ * rollback, are sent in the same batch as the statement itself, so an
+ * error in the first statement of a transaction must be reported for
+ * that statement and leave the transaction usable.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static HSTMT hstmt = SQL_NULL_HSTMT;
+static char param[20];
+
+static void
+exec_insert(const char *value)
+{
+	SQLRETURN rc;
+
+	strcpy(param, value);
+	printf("Inserting '%s'\n", value);
+	rc = SQLExecute(hstmt);
+	if (!SQL_SUCCEEDED(rc))
+		print_diag("Failed to execute statement", SQL_HANDLE_STMT, hstmt);
+}
+
+static void
+end_tran(SQLSMALLINT completion)
+{
+	SQLRETURN rc;
+
+	printf("%s\n", SQL_COMMIT == completion ? "Committing" : "Rolling back");
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn, completion);
+	CHECK_STMT_RESULT(rc, "SQLEndTran failed", hstmt);
+}
+
+int
+main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	SQLLEN cbParam = SQL_NTS;
+
+	test_connect_ext("UseServerSidePrepare=1;Protocol=7.4-2");
+	rc = SQLAllocStmt(conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	/* Disable autocommit */
+	rc = SQLSetConnectAttr(conn,
+						   SQL_ATTR_AUTOCOMMIT,
+						   (SQLPOINTER)SQL_AUTOCOMMIT_OFF,
+						   SQL_IS_UINTEGER);
+	CHECK_STMT_RESULT(rc, "SQLSetConnectAttr failed", hstmt);
+
+	rc = SQLExecDirect(hstmt,
+			   (SQLCHAR *) "CREATE TEMPORARY TABLE begintab (i int4)",
+			   SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn, SQL_COMMIT);
+	CHECK_STMT_RESULT(rc, "SQLEndTran failed", hstmt);
+
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "INSERT INTO begintab VALUES (?)", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT,
+						  SQL_C_CHAR,	/* value type */
+						  SQL_INTEGER,	/* param type */
+						  0,			/* column size */
+						  0,			/* dec digits */
+						  param,		/* param value ptr */
+						  0,			/* buffer len */
+						  &cbParam		/* StrLen_or_IndPtr */);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+
+	/* The first statement of each transaction begins it */
+	exec_insert("1");
+	end_tran(SQL_ROLLBACK);
+	exec_insert("2");
+	end_tran(SQL_COMMIT);
+
+	/* Fail the first statement of a transaction, and carry on */
+	exec_insert("foo");
+	exec_insert("3");
+	end_tran(SQL_COMMIT);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLExecDirect(hstmt,
+			   (SQLCHAR *) "SELECT i FROM begintab ORDER BY i",
+			   SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	print_result(hstmt);
+
+	/* Clean up */
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	test_disconnect();
+
+	return 0;
+}
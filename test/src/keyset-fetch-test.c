@@ -0,0 +1,185 @@
+/*
+ * Test a keyset-driven cursor with UseDeclareFetch. The keys come from
+ * the server's cursor along with the rows, a block of Fetch rows at a
+ * time, and the rows are re-read by their keys when scrolling to them,
+ * also when a rowset crosses the boundary of the blocks.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static SQLINTEGER id;
+static char buf[40];
+static SQLLEN ind;
+
+static void
+fetch_and_print(HSTMT hstmt, SQLSMALLINT orientation, SQLLEN offset, const char *label)
+{
+	SQLRETURN rc;
+
+	rc = SQLFetchScroll(hstmt, orientation, offset);
+	if (rc == SQL_NO_DATA)
+	{
+		printf("%s: no data\n", label);
+		return;
+	}
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("%s: %d %s\n", label, (int) id, ind == SQL_NULL_DATA ? "NULL" : buf);
+}
+
+static void
+exec_direct(const char *sql)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLULEN cursor_type;
+	SQLUINTEGER attrs;
+	SQLINTEGER ids[4];
+	char bufs[4][40];
+	SQLLEN inds[4];
+	SQLULEN rowsfetched;
+	int count, i;
+
+	test_connect_ext("UseDeclareFetch=1;Fetch=10;UpdatableCursors=1");
+
+	exec_direct("CREATE TEMPORARY TABLE keysettab (i int4, t varchar(20))");
+	exec_direct("INSERT INTO keysettab SELECT g, 'foo' || g FROM generate_series(1, 35) g");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CONCURRENCY,
+						(SQLPOINTER) SQL_CONCUR_ROWVER, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE,
+						(SQLPOINTER) SQL_CURSOR_KEYSET_DRIVEN, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE, &cursor_type, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetStmtAttr failed", hstmt);
+	printf("keyset-driven: %s\n", SQL_CURSOR_KEYSET_DRIVEN == cursor_type ? "yes" : "no");
+
+	/* The rows added by SQLBulkOperations would be lost at the next block */
+	rc = SQLGetInfo(conn, SQL_KEYSET_CURSOR_ATTRIBUTES1, &attrs, sizeof(attrs), NULL);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLGetInfo failed", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	printf("bulk add: %s\n", 0 != (attrs & SQL_CA1_BULK_ADD) ? "yes" : "no");
+	rc = SQLBulkOperations(hstmt, SQL_ADD);
+	if (SQL_SUCCEEDED(rc))
+	{
+		printf("SQLBulkOperations should have failed but it succeeded\n");
+		exit(1);
+	}
+
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, &id, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLBindCol(hstmt, 2, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT i, t FROM keysettab ORDER BY i", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	/* Read through several blocks of keys */
+	for (count = 0; count < 25; count++)
+	{
+		rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+		if (id != count + 1)
+			printf("unexpected row %d at %d\n", (int) id, count + 1);
+	}
+	printf("fetched %d rows, the last one: %d %s\n", count, (int) id, buf);
+
+	/* Rows changed after the cursor was opened are seen when scrolled to */
+	exec_direct("UPDATE keysettab SET t = 'updated' WHERE i = 5");
+	exec_direct("UPDATE keysettab SET t = 'updated too' WHERE i = 33");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 5, "absolute 5");
+	fetch_and_print(hstmt, SQL_FETCH_NEXT, 0, "next");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 33, "absolute 33");
+	fetch_and_print(hstmt, SQL_FETCH_PRIOR, 0, "prior");
+
+	/* Update a row through the cursor, and come back to it */
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 17, "absolute 17");
+	strcpy(buf, "set by SQLSetPos");
+	ind = SQL_NTS;
+	rc = SQLSetPos(hstmt, 1, SQL_UPDATE, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	fetch_and_print(hstmt, SQL_FETCH_FIRST, 0, "first");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 17, "absolute 17");
+	fetch_and_print(hstmt, SQL_FETCH_LAST, 0, "last");
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_UNBIND);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/*
+	 * Fetch a rowset of 4 rows, 2 of which are in the cache of the first
+	 * 10 rows and 2 of which are read from the cursor after that.
+	 */
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 4, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLBindCol(hstmt, 2, SQL_C_CHAR, bufs, sizeof(bufs[0]), inds);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT i, t FROM keysettab ORDER BY i", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_FIRST, 0);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+
+	exec_direct("UPDATE keysettab SET t = 'cached' WHERE i = 9");
+	exec_direct("UPDATE keysettab SET t = 'not cached' WHERE i = 11");
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 9);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("rowset at 9:\n");
+	for (i = 0; i < (int) rowsfetched; i++)
+		printf("%d %s\n", (int) ids[i], inds[i] == SQL_NULL_DATA ? "NULL" : bufs[i]);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_UNBIND);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 1, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, NULL, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT i, t FROM keysettab WHERE t NOT LIKE 'foo%' ORDER BY i", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	print_result(hstmt);
+
+	/* Clean up */
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	test_disconnect();
+
+	return 0;
+}
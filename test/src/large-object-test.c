@@ -4,6 +4,9 @@
 
 #include "common.h"
 
+#define BIG_LO_SIZE		600000
+#define BIG_LO_PIECE	4000
+
 static void
 printhex(unsigned char *b, int len)
 {
@@ -22,6 +25,9 @@ int main(int argc, char **argv)
 	SQLLEN cbParam1;
 	char buf[100];
 	SQLLEN ind;
+	char *bigbuf;
+	PTR paramid;
+	int pos, len, mismatches;
 
 	test_connect();
 
@@ -68,7 +74,73 @@ int main(int argc, char **argv)
 
 	printhex(buf, ind);
 	printf("\n");
-	
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/**** Insert a bigger one in small pieces, with data-at-execution */
+	printf("inserting %d bytes in %d byte pieces...\n", BIG_LO_SIZE, BIG_LO_PIECE);
+	bigbuf = malloc(BIG_LO_SIZE);
+	for (pos = 0; pos < BIG_LO_SIZE; pos++)
+		bigbuf[pos] = (char) (pos % 253);
+
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "INSERT INTO lo_test_tab VALUES (2, ?)", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+	cbParam1 = SQL_DATA_AT_EXEC;
+	rc = SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT,
+						  SQL_C_BINARY,	/* value type */
+						  SQL_LONGVARBINARY,	/* param type */
+						  BIG_LO_SIZE,	/* column size */
+						  0,			/* dec digits */
+						  (void *) 1,	/* param value ptr */
+						  0,			/* buffer len */
+						  &cbParam1		/* StrLen_or_IndPtr */);
+	CHECK_STMT_RESULT(rc, "SQLBindParameter failed", hstmt);
+
+	rc = SQLExecute(hstmt);
+	if (rc != SQL_NEED_DATA)
+		CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+	while ((rc = SQLParamData(hstmt, &paramid)) == SQL_NEED_DATA)
+	{
+		for (pos = 0; pos < BIG_LO_SIZE; pos += len)
+		{
+			len = BIG_LO_SIZE - pos;
+			if (len > BIG_LO_PIECE)
+				len = BIG_LO_PIECE;
+			rc = SQLPutData(hstmt, bigbuf + pos, len);
+			CHECK_STMT_RESULT(rc, "SQLPutData failed", hstmt);
+		}
+	}
+	CHECK_STMT_RESULT(rc, "SQLParamData failed", hstmt);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/**** And read it back in small pieces */
+	printf("reading it back in %d byte pieces...\n", (int) sizeof(buf));
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT id, large_data FROM lo_test_tab WHERE id = 2", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	rc = SQLFetch(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+
+	pos = mismatches = 0;
+	while ((rc = SQLGetData(hstmt, 2, SQL_C_BINARY, buf, sizeof(buf), &ind)) != SQL_NO_DATA)
+	{
+		CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+		if (pos == 0)
+			printf("total length: %d\n", (int) ind);
+		len = (ind == SQL_NO_TOTAL || ind > sizeof(buf)) ? sizeof(buf) : (int) ind;
+		if (pos + len > BIG_LO_SIZE || memcmp(buf, bigbuf + pos, len) != 0)
+			mismatches++;
+		pos += len;
+	}
+	printf("read %d bytes, %d mismatching pieces\n", pos, mismatches);
+	free(bigbuf);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
 	/* Clean up */
 	test_disconnect();
 
@@ -0,0 +1,94 @@
+/*
+ * Test connecting with a list of hosts in Servername, and choosing one
+ * by TargetSessionAttrs.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+/*
+ * Connect with the given extra parameters, and check that it succeeds
+ * or fails as expected. On success, check that the server is usable.
+ */
+static void
+try_connect(const char *params, int expect_success)
+{
+	SQLRETURN rc;
+	SQLHDBC hdbc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLCHAR str[1024];
+	SQLSMALLINT strl;
+	char dsn[1024];
+
+	printf("connecting with %s\n", params);
+	snprintf(dsn, sizeof(dsn), "DSN=psqlodbc_test_dsn;%s", params);
+	SQLAllocHandle(SQL_HANDLE_DBC, env, &hdbc);
+	rc = SQLDriverConnect(hdbc, NULL, (SQLCHAR *) dsn, SQL_NTS,
+						  str, sizeof(str), &strl,
+						  SQL_DRIVER_NOPROMPT);
+	if (!expect_success)
+	{
+		if (SQL_SUCCEEDED(rc))
+		{
+			printf("SQLDriverConnect should have failed but it succeeded\n");
+			exit(1);
+		}
+		printf("SQLDriverConnect failed as expected\n");
+		SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+		return;
+	}
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLDriverConnect failed.", SQL_HANDLE_DBC, hdbc);
+		exit(1);
+	}
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, hdbc);
+		exit(1);
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT CASE WHEN pg_is_in_recovery() THEN 'standby' ELSE 'primary' END", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	print_result(hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	rc = SQLDisconnect(hdbc);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("SQLDisconnect failed", SQL_HANDLE_DBC, hdbc);
+		exit(1);
+	}
+	SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+}
+
+int
+main(int argc, char **argv)
+{
+	test_connect();
+
+	/* Nothing listens on port 1, so the second host is used */
+	try_connect("Servername=localhost:1,localhost", 1);
+	/* and again, now that the first host is known to have failed */
+	try_connect("Servername=localhost:1,localhost", 1);
+
+	/* The test server is a primary */
+	try_connect("Servername=localhost:1,localhost;TargetSessionAttrs=read-write", 1);
+	try_connect("TargetSessionAttrs=primary", 1);
+	try_connect("TargetSessionAttrs=standby", 0);
+	try_connect("TargetSessionAttrs=prefer-standby", 1);
+
+	/* An invalid value is rejected */
+	try_connect("TargetSessionAttrs=bogus", 0);
+
+	/* No host can be reached */
+	try_connect("Servername=localhost:1", 0);
+
+	test_disconnect();
+
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Test the conversion of integer and float text to C numbers at the
+ * boundaries of the driver's own parsers: values which overflow, negative
+ * zero, exponents just inside and outside +-22, and floats of 15 or more
+ * significant digits, which fall back to the C library. The results must
+ * be the same either way.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static HSTMT hstmt = SQL_NULL_HSTMT;
+
+/* Fetch the text value as the given C type into buf */
+static void
+get_as(const char *str, SQLSMALLINT ctype, void *buf, SQLLEN buflen)
+{
+	SQLRETURN rc;
+	char sql[200];
+
+	snprintf(sql, sizeof(sql), "SELECT '%s'::text", str);
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetch(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+	rc = SQLGetData(hstmt, 1, ctype, buf, buflen, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
+static const char *int_values[] = {
+	"0", "-0", "007", "2147483647", "-2147483647", "-2147483648",
+	"+42", " 42", "12abc", NULL
+};
+
+static const char *bigint_values[] = {
+	"9223372036854775807", "-9223372036854775807",
+	"-9223372036854775808", "9223372036854775808",
+	"99999999999999999999", "-0", NULL
+};
+
+static const char *ubigint_values[] = {
+	"9999999999999999999", "18446744073709551615",
+	"18446744073709551616", NULL
+};
+
+static const char *double_values[] = {
+	"0", "-0", "-0.0", "0.1", "-1.5", "1e22", "1e23", "1e-22", "1e-23",
+	"123e20", "1.5e-22", "0.000001e-16", "123456789012345",
+	"1234567890123456", "0.30000000000000004", "12345678901234567890",
+	"1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324",
+	"1e", "1.", ".5", "+1.5", " 2.5", NULL
+};
+
+static const char *float_values[] = {
+	"0.1", "-0", "3.4028235e38", "1.17549435e-38", "16777217", NULL
+};
+
+int
+main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	SQLINTEGER ival;
+	SQLBIGINT bval;
+	SQLUBIGINT ubval;
+	SQLDOUBLE dval;
+	SQLREAL fval;
+	int i;
+
+	test_connect();
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	printf("SQL_C_SLONG:\n");
+	for (i = 0; int_values[i]; i++)
+	{
+		get_as(int_values[i], SQL_C_SLONG, &ival, sizeof(ival));
+		printf("'%s' -> %ld\n", int_values[i], (long) ival);
+	}
+
+	printf("SQL_C_SBIGINT:\n");
+	for (i = 0; bigint_values[i]; i++)
+	{
+		get_as(bigint_values[i], SQL_C_SBIGINT, &bval, sizeof(bval));
+		printf("'%s' -> %lld\n", bigint_values[i], (long long) bval);
+	}
+
+	printf("SQL_C_UBIGINT:\n");
+	for (i = 0; ubigint_values[i]; i++)
+	{
+		get_as(ubigint_values[i], SQL_C_UBIGINT, &ubval, sizeof(ubval));
+		printf("'%s' -> %llu\n", ubigint_values[i], (unsigned long long) ubval);
+	}
+
+	printf("SQL_C_DOUBLE:\n");
+	for (i = 0; double_values[i]; i++)
+	{
+		get_as(double_values[i], SQL_C_DOUBLE, &dval, sizeof(dval));
+		printf("'%s' -> %.17g\n", double_values[i], dval);
+	}
+
+	printf("SQL_C_FLOAT:\n");
+	for (i = 0; float_values[i]; i++)
+	{
+		get_as(float_values[i], SQL_C_FLOAT, &fval, sizeof(fval));
+		printf("'%s' -> %.9g\n", float_values[i], (double) fval);
+	}
+
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	test_disconnect();
+
+	return 0;
+}
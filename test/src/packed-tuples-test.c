@@ -0,0 +1,232 @@
+/*
+ * Test read-only results, whose values are packed into shared chunks of
+ * memory, when the cache is reloaded: by SQLSetPos(SQL_REFRESH) on rows
+ * that were spilled to the temporary file, and by the fetches of a cursor
+ * with UseDeclareFetch. Some of the values are larger than a chunk, and
+ * are read back in pieces with SQLGetData.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+#define BIG_LEN		70000
+
+static const char *query =
+	"SELECT g,"
+	" CASE WHEN g % 10 = 0 THEN NULL WHEN g % 10 = 5 THEN '' ELSE 'row' || g END,"
+	" repeat(chr(65 + g % 26), CASE WHEN g % 100 = 7 THEN 70000 ELSE 1 END)"
+	" FROM generate_series(1, 300) g";
+
+/*
+ * Read the columns of the current row with SQLGetData, and check them
+ * against the values the query generates. The third column is read in
+ * pieces. The row is printed if label is given. Returns the id of the row.
+ */
+static int
+check_row(HSTMT hstmt, const char *label)
+{
+	SQLRETURN rc;
+	SQLINTEGER id;
+	char buf[1001];
+	char expected[40];
+	SQLLEN ind;
+	int len, i;
+	char c;
+	const char *where = label ? label : "fetch";
+
+	rc = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+
+	rc = SQLGetData(hstmt, 2, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	if (id % 10 == 0)
+		strcpy(expected, "NULL");
+	else if (id % 10 == 5)
+		expected[0] = '\0';
+	else
+		snprintf(expected, sizeof(expected), "row%d", (int) id);
+	if (strcmp(ind == SQL_NULL_DATA ? "NULL" : buf, expected) != 0)
+		printf("%s: row %d has '%s' in column 2\n", where, (int) id, ind == SQL_NULL_DATA ? "NULL" : buf);
+
+	c = 'A' + id % 26;
+	len = 0;
+	while ((rc = SQLGetData(hstmt, 3, SQL_C_CHAR, buf, sizeof(buf), &ind)) != SQL_NO_DATA)
+	{
+		CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+		for (i = 0; buf[i]; i++)
+		{
+			if (buf[i] != c)
+			{
+				printf("%s: row %d has '%c' at %d in column 3\n", where, (int) id, buf[i], len + i);
+				break;
+			}
+		}
+		len += i;
+	}
+	if (len != (id % 100 == 7 ? BIG_LEN : 1))
+		printf("%s: row %d has %d characters in column 3\n", where, (int) id, len);
+
+	if (label)
+		printf("%s: %d %s %c*%d\n", label, (int) id, expected, c, len);
+	return (int) id;
+}
+
+static void
+fetch_and_check(HSTMT hstmt, SQLSMALLINT orientation, SQLLEN offset, const char *label)
+{
+	SQLRETURN rc;
+
+	rc = SQLFetchScroll(hstmt, orientation, offset);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	check_row(hstmt, label);
+}
+
+static void
+print_rowset(const char *label, SQLINTEGER *ids, SQLUSMALLINT *status, SQLULEN nrows)
+{
+	SQLULEN i;
+
+	printf("%s:", label);
+	for (i = 0; i < nrows; i++)
+		printf(" %d%s", (int) ids[i], status[i] == SQL_ROW_SUCCESS ? "" : "!");
+	printf("\n");
+}
+
+/* Scroll a static cursor over rows which are spilled, and refresh them */
+static void
+test_spilled(void)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLINTEGER ids[5];
+	SQLUSMALLINT status[5];
+	SQLULEN rowsfetched;
+	int i;
+
+	test_connect_ext("SpillRows=50");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE,
+						(SQLPOINTER) SQL_CURSOR_STATIC, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) query, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	fetch_and_check(hstmt, SQL_FETCH_ABSOLUTE, 7, "absolute 7");
+	fetch_and_check(hstmt, SQL_FETCH_ABSOLUTE, 207, "absolute 207");
+	fetch_and_check(hstmt, SQL_FETCH_ABSOLUTE, 107, "absolute 107");
+	fetch_and_check(hstmt, SQL_FETCH_LAST, 0, "last");
+	fetch_and_check(hstmt, SQL_FETCH_FIRST, 0, "first");
+
+	/* A rowset which crosses the boundary of the spilled blocks */
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 5, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, status, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 148);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	print_rowset("rowset at 148", ids, status, rowsfetched);
+
+	/* Refresh the whole rowset, which reads both blocks back */
+	for (i = 0; i < 5; i++)
+		ids[i] = 0;
+	rc = SQLSetPos(hstmt, 0, SQL_REFRESH, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	print_rowset("refreshed", ids, status, rowsfetched);
+
+	/* and read rows of the first block and the second one again */
+	rc = SQLSetPos(hstmt, 1, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	check_row(hstmt, "position 1");
+	rc = SQLSetPos(hstmt, 4, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	check_row(hstmt, "position 4");
+
+	/* A rowset with a large value, refreshed after moving away from it */
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 205);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	print_rowset("rowset at 205", ids, status, rowsfetched);
+	rc = SQLSetPos(hstmt, 3, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	check_row(hstmt, "position 3");
+	rc = SQLSetPos(hstmt, 3, SQL_REFRESH, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	check_row(hstmt, "refreshed 3");
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	test_disconnect();
+}
+
+/* Read through a cursor, whose rows are fetched a few at a time */
+static void
+test_declare_fetch(void)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	int count;
+
+	test_connect_ext("UseDeclareFetch=1;Fetch=10");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) query, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	for (count = 0; (rc = SQLFetch(hstmt)) != SQL_NO_DATA; count++)
+	{
+		CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+		if (check_row(hstmt, NULL) != count + 1)
+			printf("unexpected row at %d\n", count + 1);
+	}
+	printf("fetched %d rows with declare/fetch\n", count);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* A static cursor scrolls back and forth through the fetches */
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE,
+						(SQLPOINTER) SQL_CURSOR_STATIC, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) query, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	fetch_and_check(hstmt, SQL_FETCH_ABSOLUTE, 207, "absolute 207");
+	fetch_and_check(hstmt, SQL_FETCH_ABSOLUTE, 7, "absolute 7");
+	fetch_and_check(hstmt, SQL_FETCH_RELATIVE, 100, "relative 100");
+	fetch_and_check(hstmt, SQL_FETCH_PRIOR, 0, "prior");
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	test_disconnect();
+}
+
+int main(int argc, char **argv)
+{
+	test_spilled();
+	test_declare_fetch();
+
+	return 0;
+}
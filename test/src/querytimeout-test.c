@@ -0,0 +1,88 @@
+/*
+ * Test SQL_ATTR_QUERY_TIMEOUT, enforced by the driver and by the server's
+ * statement_timeout (ServerSideTimeout=1).
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static void
+run_with_timeout(const char *extraparams)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLULEN timeout;
+	char sqlstate[32];
+	SQLINTEGER nativeerror;
+	SQLCHAR message[256];
+	SQLSMALLINT textlen;
+	char buf[40];
+	SQLLEN ind;
+
+	test_connect_ext((char *) extraparams);
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER) 1, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_QUERY_TIMEOUT, &timeout, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetStmtAttr failed", hstmt);
+	printf("query timeout: %u\n", (unsigned int) timeout);
+
+	/* This finishes in time */
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT 'quick'", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetch(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+	rc = SQLGetData(hstmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	printf("result: %s\n", buf);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* And this doesn't */
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT pg_sleep(10)", SQL_NTS);
+	if (SQL_SUCCEEDED(rc))
+	{
+		printf("SQLExecDirect unexpectedly succeeded\n");
+		exit(1);
+	}
+	rc = SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, (SQLCHAR *) sqlstate,
+					   &nativeerror, message, sizeof(message), &textlen);
+	CHECK_STMT_RESULT(rc, "SQLGetDiagRec failed", hstmt);
+	printf("timed out: %s\n", sqlstate);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* The connection is still usable without the timeout */
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER) 0, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT pg_sleep(2), 'slow'", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetch(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+	rc = SQLGetData(hstmt, 2, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	printf("result: %s\n", buf);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	test_disconnect();
+}
+
+int main(int argc, char **argv)
+{
+	printf("-- timeout enforced by the driver\n");
+	run_with_timeout(NULL);
+	printf("-- timeout enforced by the server\n");
+	run_with_timeout("ServerSideTimeout=1");
+
+	return 0;
+}
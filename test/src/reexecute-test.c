@@ -0,0 +1,88 @@
+/*
+ * Test re-executing a statement which isn't prepared on the server.
+ * The result of a re-execution shares the column information of the
+ * previous one when the server describes the columns alike, and must
+ * not share it when the table has been altered in between.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static void
+execute_and_print(HSTMT hstmt, int print_meta)
+{
+	SQLRETURN rc;
+
+	rc = SQLExecute(hstmt);
+	CHECK_STMT_RESULT(rc, "SQLExecute failed", hstmt);
+	if (print_meta)
+		print_result_meta(hstmt);
+	print_result(hstmt);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+}
+
+static void
+exec_direct(const char *sql)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	int i;
+
+	test_connect_ext("UseServerSidePrepare=0;Parse=1");
+
+	exec_direct("CREATE TEMPORARY TABLE reexectab (id int4, t varchar(40))");
+	exec_direct("INSERT INTO reexectab VALUES (1, 'foo'), (2, 'bar')");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	rc = SQLPrepare(hstmt, (SQLCHAR *) "SELECT * FROM reexectab ORDER BY id", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLPrepare failed", hstmt);
+
+	/* The same columns every time */
+	for (i = 0; i < 3; i++)
+		execute_and_print(hstmt, i != 1);
+
+	/* A column of another type */
+	exec_direct("ALTER TABLE reexectab ALTER COLUMN t TYPE varchar(80)");
+	execute_and_print(hstmt, 1);
+
+	/* One more column */
+	exec_direct("ALTER TABLE reexectab ADD COLUMN n int4");
+	execute_and_print(hstmt, 1);
+	execute_and_print(hstmt, 1);
+
+	/* One column less */
+	exec_direct("ALTER TABLE reexectab DROP COLUMN t");
+	execute_and_print(hstmt, 1);
+
+	/* Clean up */
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	test_disconnect();
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Test scrolling through a static result set which is larger than
+ * SpillRows, so that most of the rows are spilled to a temporary file.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static void
+fetch_and_print(HSTMT hstmt, SQLSMALLINT orientation, SQLLEN offset, const char *label)
+{
+	SQLRETURN rc;
+	SQLINTEGER id;
+	char buf[40];
+	SQLLEN ind;
+
+	rc = SQLFetchScroll(hstmt, orientation, offset);
+	if (rc == SQL_NO_DATA)
+	{
+		printf("%s: no data\n", label);
+		return;
+	}
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+
+	rc = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	rc = SQLGetData(hstmt, 2, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	printf("%s: %d %s\n", label, (int) id, ind == SQL_NULL_DATA ? "NULL" : buf);
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	SQLULEN bookmark = 0;
+	SQLLEN ind;
+	SQLINTEGER ids[10];
+	SQLULEN rowsfetched;
+	int i, count;
+
+	test_connect_ext("SpillRows=100");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE,
+						(SQLPOINTER) SQL_CURSOR_STATIC, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_USE_BOOKMARKS,
+						(SQLPOINTER) SQL_UB_VARIABLE, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, CASE WHEN g % 7 = 0 THEN NULL WHEN g % 11 = 0 THEN '' ELSE 'foo' || g END FROM generate_series(1, 1000) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	fetch_and_print(hstmt, SQL_FETCH_NEXT, 0, "next");
+	fetch_and_print(hstmt, SQL_FETCH_NEXT, 0, "next");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 500, "absolute 500");
+	fetch_and_print(hstmt, SQL_FETCH_RELATIVE, -250, "relative -250");
+	fetch_and_print(hstmt, SQL_FETCH_PRIOR, 0, "prior");
+	fetch_and_print(hstmt, SQL_FETCH_LAST, 0, "last");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 700, "absolute 700");
+	fetch_and_print(hstmt, SQL_FETCH_ABSOLUTE, 143, "absolute 143");
+
+	/* Remember this row, and come back to it later with the bookmark */
+	rc = SQLGetData(hstmt, 0, SQL_C_VARBOOKMARK, &bookmark, sizeof(bookmark), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+
+	fetch_and_print(hstmt, SQL_FETCH_FIRST, 0, "first");
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_FETCH_BOOKMARK_PTR, (SQLPOINTER) &bookmark, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	fetch_and_print(hstmt, SQL_FETCH_BOOKMARK, 0, "bookmark");
+
+	/* Fetch a rowset which crosses the boundary of the spilled blocks */
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 10, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 395);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("rowset at 395:");
+	for (i = 0; i < (int) rowsfetched; i++)
+		printf(" %d", (int) ids[i]);
+	printf("\n");
+
+	/* And scroll through the whole result set */
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_FIRST, 0);
+	for (count = 0; SQL_SUCCEEDED(rc); )
+	{
+		for (i = 0; i < (int) rowsfetched; i++)
+		{
+			if (ids[i] != count + i + 1)
+				printf("unexpected row %d at %d\n", (int) ids[i], count + i + 1);
+		}
+		count += (int) rowsfetched;
+		rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	}
+	if (rc != SQL_NO_DATA)
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("fetched %d rows altogether\n", count);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* Clean up */
+	test_disconnect();
+
+	return 0;
+}
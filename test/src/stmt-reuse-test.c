@@ -0,0 +1,111 @@
+/*
+ * Test that a statement handle allocated after another one was freed
+ * starts out with default attributes and no bound columns, even though
+ * the driver may hand out the same block again.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+static HSTMT
+alloc_stmt(void)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	return hstmt;
+}
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt;
+	SQLHDESC ard;
+	SQLULEN cursor_type, array_size;
+	SQLSMALLINT count;
+	SQLINTEGER ids[5];
+	SQLINTEGER id;
+	char buf[40];
+	SQLLEN ind;
+	int i, sum;
+
+	test_connect();
+
+	/* Use the first handle with non-default attributes and bindings */
+	hstmt = alloc_stmt();
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE,
+						(SQLPOINTER) SQL_CURSOR_STATIC, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 5, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, 'foo' || g FROM generate_series(1, 5) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	rc = SQLSetPos(hstmt, 1, SQL_POSITION, SQL_LOCK_NO_CHANGE);
+	CHECK_STMT_RESULT(rc, "SQLSetPos failed", hstmt);
+	rc = SQLGetData(hstmt, 2, SQL_C_CHAR, buf, sizeof(buf), &ind);
+	CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+	printf("first: %d %s\n", (int) ids[0], buf);
+
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	/* The next handle must not inherit anything from the first one */
+	hstmt = alloc_stmt();
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE, &cursor_type, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetStmtAttr failed", hstmt);
+	printf("cursor type: %d\n", (int) cursor_type);
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &array_size, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetStmtAttr failed", hstmt);
+	printf("row array size: %d\n", (int) array_size);
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_APP_ROW_DESC, &ard, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetStmtAttr failed", hstmt);
+	rc = SQLGetDescField(ard, 0, SQL_DESC_COUNT, &count, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLGetDescField failed", hstmt);
+	printf("ARD count: %d\n", (int) count);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT 'second'", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	print_result(hstmt);
+	rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+
+	/* Allocate, use and drop statements in a loop */
+	sum = 0;
+	for (i = 1; i <= 100; i++)
+	{
+		char sql[100];
+
+		hstmt = alloc_stmt();
+		snprintf(sql, sizeof(sql), "SELECT %d", i);
+		rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, SQL_NTS);
+		CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+		rc = SQLFetch(hstmt);
+		CHECK_STMT_RESULT(rc, "SQLFetch failed", hstmt);
+		rc = SQLGetData(hstmt, 1, SQL_C_LONG, &id, sizeof(id), &ind);
+		CHECK_STMT_RESULT(rc, "SQLGetData failed", hstmt);
+		if (id != i)
+			printf("unexpected value %d in iteration %d\n", (int) id, i);
+		sum += id;
+		rc = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+		CHECK_STMT_RESULT(rc, "SQLFreeHandle failed", hstmt);
+	}
+	printf("sum of 100 statements: %d\n", sum);
+
+	/* Clean up */
+	test_disconnect();
+
+	return 0;
+}
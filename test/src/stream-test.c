@@ -0,0 +1,98 @@
+/*
+ * Test a forward-only result set with StreamResults, where the rows are
+ * read off the connection as they are fetched. Another statement on the
+ * same connection must still work in the middle of the stream.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+
+int main(int argc, char **argv)
+{
+	SQLRETURN rc;
+	HSTMT hstmt = SQL_NULL_HSTMT;
+	HSTMT hstmt2 = SQL_NULL_HSTMT;
+	SQLINTEGER ids[10];
+	SQLULEN rowsfetched;
+	SQLLEN rowcount;
+	int i, count;
+
+	test_connect_ext("StreamResults=1;Fetch=100");
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn, &hstmt2);
+	if (!SQL_SUCCEEDED(rc))
+	{
+		print_diag("failed to allocate stmt handle", SQL_HANDLE_DBC, conn);
+		exit(1);
+	}
+
+	rc = SQLBindCol(hstmt, 1, SQL_C_LONG, ids, 0, NULL);
+	CHECK_STMT_RESULT(rc, "SQLBindCol failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER) 10, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsfetched, 0);
+	CHECK_STMT_RESULT(rc, "SQLSetStmtAttr failed", hstmt);
+
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, 'foo' || g FROM generate_series(1, 1000) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+
+	/* Fetch the whole result set, with another query half way through */
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	for (count = 0; SQL_SUCCEEDED(rc); )
+	{
+		for (i = 0; i < (int) rowsfetched; i++)
+		{
+			if (ids[i] != count + i + 1)
+				printf("unexpected row %d at %d\n", (int) ids[i], count + i + 1);
+		}
+		count += (int) rowsfetched;
+		if (count == 500)
+		{
+			printf("querying another statement at row %d\n", count);
+			rc = SQLExecDirect(hstmt2, (SQLCHAR *) "SELECT 'other'", SQL_NTS);
+			CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt2);
+			print_result(hstmt2);
+			rc = SQLFreeStmt(hstmt2, SQL_CLOSE);
+			CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt2);
+		}
+		rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	}
+	if (rc != SQL_NO_DATA)
+		CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("fetched %d rows altogether\n", count);
+
+	rc = SQLRowCount(hstmt, &rowcount);
+	CHECK_STMT_RESULT(rc, "SQLRowCount failed", hstmt);
+	printf("row count: %d\n", (int) rowcount);
+
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	/* Close a stream before all of its rows are fetched */
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) "SELECT g, 'foo' || g FROM generate_series(1, 1000) g", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt);
+	rc = SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0);
+	CHECK_STMT_RESULT(rc, "SQLFetchScroll failed", hstmt);
+	printf("first rowset starts at %d\n", (int) ids[0]);
+	rc = SQLFreeStmt(hstmt, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt);
+
+	rc = SQLExecDirect(hstmt2, (SQLCHAR *) "SELECT 'after close'", SQL_NTS);
+	CHECK_STMT_RESULT(rc, "SQLExecDirect failed", hstmt2);
+	print_result(hstmt2);
+
+	/* Clean up */
+	rc = SQLFreeStmt(hstmt2, SQL_CLOSE);
+	CHECK_STMT_RESULT(rc, "SQLFreeStmt failed", hstmt2);
+	test_disconnect();
+
+	return 0;
+}
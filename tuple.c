@@ -69,3 +69,23 @@ set_tuplefield_int4(TupleField *tuple_field, Int4 value)
 	/* +1 ... is this correct (better be on the save side-...) */
 	tuple_field->value = strdup(buffer);
 }
+
+
+/*
+ *	Move the value of a field of a backend result into a manual result
+ *	set without copying it. The source mustn't hold packed tuples. It is
+ *	left NULL so that the value isn't freed twice.
+ */
+void
+move_tuplefield(TupleField *tuple_field, TupleField *src)
+{
+	if (src->value)
+	{
+		tuple_field->len = src->len;
+		tuple_field->value = src->value;
+		src->value = NULL;
+		src->len = -1;
+	}
+	else
+		set_tuplefield_null(tuple_field);
+}
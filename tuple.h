@@ -61,6 +61,7 @@ void		set_tuplefield_null(TupleField *tuple_field);
 void		set_tuplefield_string(TupleField *tuple_field, const char *string);
 void		set_tuplefield_int2(TupleField *tuple_field, Int2 value);
 void		set_tuplefield_int4(TupleField *tuple_field, Int4 value);
+void		move_tuplefield(TupleField *tuple_field, TupleField *src);
 SQLLEN	ClearCachedRows(TupleField *tuple, int num_fields, SQLLEN num_rows);
 SQLLEN	ReplaceCachedRows(TupleField *otuple, const TupleField *ituple, int num_fields, SQLLEN num_rows);
 